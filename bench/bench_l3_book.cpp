@@ -0,0 +1,77 @@
+// L3 replay benchmark: drives add/execute/cancel/replace messages through an
+// L3Book and reports messages per second.
+
+#include "market/l3_book.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace mme;
+
+int main(int argc, char* argv[]) {
+    size_t num_messages = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 5'000'000;
+    constexpr size_t kLiveOrders = 20'000;
+
+    // Pre-generate a message stream that keeps roughly kLiveOrders resting.
+    std::mt19937_64 rng(11);
+    std::uniform_int_distribution<int> offset(1, 50);
+    std::uniform_int_distribution<int> action(0, 9);
+    std::vector<OrderMessage> msgs;
+    msgs.reserve(num_messages);
+    std::vector<uint64_t> live;
+    live.reserve(kLiveOrders * 2);
+    uint64_t next_id = 1;
+
+    for (size_t i = 0; i < num_messages; ++i) {
+        int a = action(rng);
+        if (live.size() < kLiveOrders || a < 4) {
+            bool bid = (rng() & 1) != 0;
+            double px = bid ? 100.0 - offset(rng) * 0.01 : 100.0 + offset(rng) * 0.01;
+            msgs.push_back(OrderMessage{.type = OrderMessageType::Add,
+                                        .side = bid ? LevelSide::Bid : LevelSide::Ask,
+                                        .order_id = next_id, .price = px, .quantity = 10.0});
+            live.push_back(next_id++);
+            continue;
+        }
+        size_t pick = rng() % live.size();
+        uint64_t id = live[pick];
+        if (a < 6) {
+            msgs.push_back(OrderMessage{.type = OrderMessageType::Execute, .order_id = id,
+                                        .quantity = 10.0});
+            live[pick] = live.back();
+            live.pop_back();
+        } else if (a < 9) {
+            msgs.push_back(OrderMessage{.type = OrderMessageType::Cancel, .order_id = id});
+            live[pick] = live.back();
+            live.pop_back();
+        } else {
+            bool bid = (rng() & 1) != 0;
+            double px = bid ? 100.0 - offset(rng) * 0.01 : 100.0 + offset(rng) * 0.01;
+            msgs.push_back(OrderMessage{.type = OrderMessageType::Replace, .order_id = id,
+                                        .new_order_id = next_id, .price = px, .quantity = 10.0});
+            live[pick] = next_id++;
+        }
+    }
+
+    L3Book book(1, 1, 0.01, kLiveOrders * 2);
+    VenueBookSnapshot snap;
+    double checksum = 0.0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& m : msgs) {
+        book.apply(m);
+    }
+    book.to_snapshot(snap);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    checksum += snap.best_bid() + snap.best_ask();
+
+    double secs = std::chrono::duration<double>(elapsed).count();
+    std::printf("messages:      %zu\n", msgs.size());
+    std::printf("msgs/sec:      %.0f\n", secs > 0 ? msgs.size() / secs : 0.0);
+    std::printf("ns/msg:        %.1f\n", msgs.empty() ? 0.0 : secs * 1e9 / msgs.size());
+    std::printf("resting:       %zu (checksum %.2f)\n", book.order_count(), checksum);
+    return 0;
+}
@@ -0,0 +1,80 @@
+// Portfolio VaR benchmark: per-operation cost of PortfolioVarEngine for
+// 500-4000 instruments. A sample folds in returns for a fraction of the
+// universe; an exposure change is one row axpy; resync is the full O(n^2)
+// matrix-vector product.
+
+#include "risk/portfolio_var.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using namespace mme;
+
+namespace {
+
+double ns_since(std::chrono::steady_clock::time_point start, size_t ops) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(ns) / static_cast<double>(ops);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t moved = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 100;
+
+    std::printf("%-11s %14s %16s %12s %12s\n", "instruments", "sample (us)",
+                "exposure (ns)", "resync (us)", "VaR");
+    for (size_t n : {size_t{500}, size_t{1'000}, size_t{2'000}, size_t{4'000}}) {
+        InstrumentRegistry reg;
+        for (size_t i = 0; i < n; ++i) reg.add_instrument(static_cast<InstrumentId>(i + 1));
+        SimulatedClock clock(1);
+        PortfolioVarEngine engine(reg, VarConfig{.sample_interval = 1000}, &clock);
+
+        std::mt19937_64 rng(9);
+        std::normal_distribution<double> ret(0.0, 0.001);
+        std::uniform_int_distribution<size_t> pick(0, n - 1);
+        std::vector<double> mid(n, 100.0);
+        for (InstrumentIndex i = 0; i < n; ++i) engine.on_mid_at(i, mid[i]);
+
+        // Warm up the covariance so every row has entries
+        for (int s = 0; s < 50; ++s) {
+            for (InstrumentIndex i = 0; i < n; ++i) {
+                mid[i] *= std::exp(ret(rng));
+                engine.on_mid_at(i, mid[i]);
+            }
+            engine.sample();
+        }
+
+        constexpr size_t kSamples = 200;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t s = 0; s < kSamples; ++s) {
+            for (size_t m = 0; m < moved && m < n; ++m) {
+                size_t i = pick(rng);
+                mid[i] *= std::exp(ret(rng));
+                engine.on_mid_at(static_cast<InstrumentIndex>(i), mid[i]);
+            }
+            engine.sample();
+        }
+        double sample_us = ns_since(start, kSamples) / 1000.0;
+
+        constexpr size_t kUpdates = 20'000;
+        start = std::chrono::steady_clock::now();
+        for (size_t u = 0; u < kUpdates; ++u) {
+            engine.set_exposure_at(static_cast<InstrumentIndex>(pick(rng)),
+                                   static_cast<double>(u % 1000) * 100.0);
+        }
+        double exposure_ns = ns_since(start, kUpdates);
+
+        constexpr size_t kResyncs = 20;
+        start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < kResyncs; ++r) engine.resync();
+        double resync_us = ns_since(start, kResyncs) / 1000.0;
+
+        std::printf("%-11zu %14.2f %16.1f %12.1f %12.1f\n", n, sample_us, exposure_ns,
+                    resync_us, engine.var());
+    }
+    return 0;
+}
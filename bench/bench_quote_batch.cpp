@@ -0,0 +1,75 @@
+// Batched quote benchmark: computes quotes for 1k-100k instruments with each
+// available kernel and reports quotes per second.
+
+#include "strategy/quote_kernels.hpp"
+#include "util/cpu_features.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using namespace mme;
+
+namespace {
+
+const char* kernel_name(QuoteKernel k) {
+    switch (k) {
+        case QuoteKernel::Scalar: return "scalar";
+        case QuoteKernel::Avx2:   return "avx2";
+        case QuoteKernel::Avx512: return "avx512";
+    }
+    return "?";
+}
+
+bool supported(QuoteKernel k) {
+    switch (k) {
+        case QuoteKernel::Scalar: return true;
+        case QuoteKernel::Avx2:   return cpu_has_avx2();
+        case QuoteKernel::Avx512: return cpu_has_avx512f();
+    }
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t total_quotes = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 50'000'000;
+
+    std::printf("%-10s %-8s %14s %10s\n", "instruments", "kernel", "quotes/sec", "ns/quote");
+    for (size_t n : {size_t{1'000}, size_t{10'000}, size_t{100'000}}) {
+        std::mt19937_64 rng(5);
+        std::uniform_real_distribution<double> u(0.0, 1.0);
+        QuoteBatch batch;
+        batch.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            MarketMakingParams p;
+            p.base_spread_bp  = 2.0 + 10.0 * u(rng);
+            p.max_position    = 100.0;
+            p.inventory_coeff = 0.5;
+            batch.add(50.0 + 500.0 * u(rng), 0.002 * u(rng), 200.0 * u(rng) - 100.0, p);
+        }
+        const QuoteBatchInput in = batch.input();
+        const QuoteBatchOutput out = batch.output();
+        const size_t rounds = total_quotes / n > 0 ? total_quotes / n : 1;
+
+        for (QuoteKernel k : {QuoteKernel::Scalar, QuoteKernel::Avx2, QuoteKernel::Avx512}) {
+            if (!supported(k)) continue;
+            compute_quotes(in, out, k);   // warm up
+            int64_t checksum = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (size_t r = 0; r < rounds; ++r) {
+                compute_quotes(in, out, k);
+                checksum += out.bid_ticks[r % n];
+            }
+            auto elapsed = std::chrono::steady_clock::now() - start;
+
+            double secs = std::chrono::duration<double>(elapsed).count();
+            double quotes = static_cast<double>(rounds * n);
+            std::printf("%-10zu %-8s %14.0f %10.2f   (checksum %lld)\n", n, kernel_name(k),
+                        secs > 0 ? quotes / secs : 0.0, secs * 1e9 / quotes,
+                        static_cast<long long>(checksum));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+// Sharding benchmark: dispatches synthetic snapshots across 1..N shards and
+// reports end-to-end ticks per second for each shard count.
+
+#include "runtime/sharded_engine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace mme;
+
+namespace {
+
+std::vector<VenueBookSnapshot> make_snapshots(size_t ticks, size_t instruments, size_t venues) {
+    std::vector<VenueBookSnapshot> out;
+    out.reserve(ticks * instruments * venues);
+    std::mt19937 rng(7);
+    std::normal_distribution<double> move(0.0, 0.0005);
+    std::vector<double> px(instruments, 100.0);
+
+    for (size_t t = 0; t < ticks; ++t) {
+        for (size_t i = 0; i < instruments; ++i) {
+            px[i] *= (1.0 + move(rng));
+            for (size_t v = 0; v < venues; ++v) {
+                VenueBookSnapshot snap;
+                snap.instrument = static_cast<InstrumentId>(i + 1);
+                snap.venue = static_cast<VenueId>(v + 1);
+                for (int lvl = 0; lvl < 3; ++lvl) {
+                    double off = px[i] * 0.0005 * (1.0 + lvl);
+                    snap.bids.push_back(BookLevel{px[i] - off, 10.0 + lvl});
+                    snap.asks.push_back(BookLevel{px[i] + off, 10.0 + lvl});
+                }
+                out.push_back(snap);
+            }
+        }
+    }
+    return out;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    size_t ticks       = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 200;
+    size_t instruments = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 1000;
+    size_t max_shards  = (argc > 3) ? std::strtoull(argv[3], nullptr, 10)
+                                    : std::max(1u, std::thread::hardware_concurrency());
+    constexpr size_t kVenues = 2;
+
+    std::unordered_map<InstrumentId, MarketMakingParams> params;
+    for (InstrumentId id = 1; id <= instruments; ++id) params[id] = MarketMakingParams{};
+    std::vector<VenueConfig> venues = {
+        {.id = 1, .name = "V1", .maker_fee_bp = 0.5, .taker_fee_bp = 1.5,
+         .latency_ms = 0.5, .cancel_penalty_bp = 0.05},
+        {.id = 2, .name = "V2", .maker_fee_bp = 0.8, .taker_fee_bp = 2.0,
+         .latency_ms = 0.3, .cancel_penalty_bp = 0.1},
+    };
+
+    auto snapshots = make_snapshots(ticks, instruments, kVenues);
+    std::printf("%zu snapshots, %zu instruments, %u hardware threads\n",
+                snapshots.size(), instruments, std::thread::hardware_concurrency());
+    std::printf("%8s %14s %10s\n", "shards", "ticks/sec", "speedup");
+
+    double base = 0.0;
+    for (size_t n = 1; n <= max_shards; n *= 2) {
+        ShardedEngineConfig config;
+        config.num_shards = n;
+        config.wait = WaitStrategy::Yield;
+        ShardedEngine engine(config, params, venues,
+                             [](size_t, FillCallback) {
+                                 return std::make_unique<NullExecutionGateway>();
+                             });
+
+        auto start = std::chrono::steady_clock::now();
+        engine.start();
+        Timestamp ts = 0;
+        for (const auto& snap : snapshots) engine.dispatch(snap, ts += kNanosPerMilli);
+        engine.stop();
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        double rate = static_cast<double>(engine.totals().ticks) / secs;
+        if (n == 1) base = rate;
+        std::printf("%8zu %14.0f %9.2fx\n", n, rate, base > 0.0 ? rate / base : 0.0);
+    }
+    return 0;
+}
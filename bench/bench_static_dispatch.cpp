@@ -0,0 +1,134 @@
+// Static vs virtual dispatch: runs the same snapshots through the virtual
+// MarketMakerController + SimExecutionGateway and through the fully
+// templated controller + BasicSimExecutionGateway, and reports ns per tick.
+
+#include "market/market_data_aggregator.hpp"
+#include "risk/risk_manager.hpp"
+#include "strategy/quote_engine.hpp"
+#include "strategy/market_maker_controller.hpp"
+#include "execution/sim_execution_gateway.hpp"
+#include "execution/venue_router.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace mme;
+
+namespace {
+
+struct StaticFillSink;
+using StaticGateway    = BasicSimExecutionGateway<StaticFillSink>;
+using StaticController = BasicMarketMakerController<StaticGateway, VenueRouter, QuoteEngine>;
+
+struct StaticFillSink {
+    StaticController* controller = nullptr;
+    uint64_t          fills      = 0;
+
+    void operator()(const Fill& fill) {
+        controller->on_fill(fill);
+        ++fills;
+    }
+};
+
+std::vector<VenueBookSnapshot> make_snapshots(size_t ticks, size_t instruments, size_t venues) {
+    std::vector<VenueBookSnapshot> out;
+    out.reserve(ticks * instruments * venues);
+    std::mt19937 rng(7);
+    std::normal_distribution<double> move(0.0, 0.0005);
+    std::vector<double> px(instruments, 100.0);
+
+    for (size_t t = 0; t < ticks; ++t) {
+        for (size_t i = 0; i < instruments; ++i) {
+            px[i] *= (1.0 + move(rng));
+            for (size_t v = 0; v < venues; ++v) {
+                VenueBookSnapshot snap;
+                snap.instrument = static_cast<InstrumentId>(i + 1);
+                snap.venue = static_cast<VenueId>(v + 1);
+                for (int lvl = 0; lvl < 3; ++lvl) {
+                    double off = px[i] * 0.0005 * (1.0 + lvl);
+                    snap.bids.push_back(BookLevel{px[i] - off, 10.0 + lvl});
+                    snap.asks.push_back(BookLevel{px[i] + off, 10.0 + lvl});
+                }
+                out.push_back(snap);
+            }
+        }
+    }
+    return out;
+}
+
+template <typename Controller, typename Gateway>
+double run(Controller& controller, Gateway& gw, const std::vector<VenueBookSnapshot>& snaps) {
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& snap : snaps) {
+        controller.on_market_data(snap);
+        gw.check_fills(snap);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / snaps.size();
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    size_t ticks = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 50000;
+    constexpr size_t kInstruments = 5;
+    constexpr size_t kVenues = 2;
+
+    std::unordered_map<InstrumentId, MarketMakingParams> params;
+    std::vector<InstrumentId> ids;
+    for (InstrumentId id = 1; id <= kInstruments; ++id) {
+        params[id] = MarketMakingParams{};
+        ids.push_back(id);
+    }
+    std::vector<VenueConfig> venues = {
+        {.id = 1, .name = "V1", .maker_fee_bp = 0.5, .taker_fee_bp = 1.5,
+         .latency_ms = 0.5, .cancel_penalty_bp = 0.05},
+        {.id = 2, .name = "V2", .maker_fee_bp = 0.8, .taker_fee_bp = 2.0,
+         .latency_ms = 0.3, .cancel_penalty_bp = 0.1},
+    };
+    auto snaps = make_snapshots(ticks, kInstruments, kVenues);
+
+    double virtual_ns = 0.0;
+    uint64_t virtual_fills = 0;
+    {
+        MarketDataAggregator md;
+        RiskManager risk(params);
+        QuoteEngine qe(params);
+        VenueRouter router(venues);
+        MarketMakerController* ctl = nullptr;
+        SimExecutionGateway gw([&](const Fill& fill) {
+            ctl->on_fill(fill);
+            ++virtual_fills;
+        });
+        gw.set_tick_sizes(params);
+        MarketMakerController controller(md, risk, qe, router, gw, ids);
+        ctl = &controller;
+        virtual_ns = run(controller, gw, snaps);
+    }
+
+    double static_ns = 0.0;
+    uint64_t static_fills = 0;
+    {
+        MarketDataAggregator md;
+        RiskManager risk(params);
+        QuoteEngine qe(params);
+        VenueRouter router(venues);
+        StaticGateway gw(StaticFillSink{});
+        gw.set_tick_sizes(params);
+        StaticController controller(md, risk, qe, router, gw, ids);
+        gw.fill_sink().controller = &controller;
+        static_ns = run(controller, gw, snaps);
+        static_fills = gw.fill_sink().fills;
+    }
+
+    std::printf("ticks:              %zu\n", snaps.size());
+    std::printf("virtual ns/tick:    %.1f  (%llu fills)\n", virtual_ns,
+                static_cast<unsigned long long>(virtual_fills));
+    std::printf("static ns/tick:     %.1f  (%llu fills)\n", static_ns,
+                static_cast<unsigned long long>(static_fills));
+    std::printf("speedup:            %.2fx\n", static_ns > 0.0 ? virtual_ns / static_ns : 0.0);
+    return 0;
+}
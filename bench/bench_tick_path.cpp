@@ -0,0 +1,116 @@
+// Tick-path benchmark: feeds synthetic snapshots through the controller and
+// reports latency and heap allocations per tick on the steady-state path.
+
+#include "market/market_data_aggregator.hpp"
+#include "risk/risk_manager.hpp"
+#include "strategy/quote_engine.hpp"
+#include "strategy/market_maker_controller.hpp"
+#include "execution/sim_execution_gateway.hpp"
+#include "execution/venue_router.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::atomic<uint64_t> g_allocations{0};
+
+} // anonymous namespace
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+using namespace mme;
+
+std::vector<VenueBookSnapshot> make_snapshots(size_t ticks, size_t instruments, size_t venues) {
+    std::vector<VenueBookSnapshot> out;
+    out.reserve(ticks * instruments * venues);
+    std::mt19937 rng(7);
+    std::normal_distribution<double> move(0.0, 0.0005);
+    std::vector<double> px(instruments, 100.0);
+
+    for (size_t t = 0; t < ticks; ++t) {
+        for (size_t i = 0; i < instruments; ++i) {
+            px[i] *= (1.0 + move(rng));
+            for (size_t v = 0; v < venues; ++v) {
+                VenueBookSnapshot snap;
+                snap.instrument = static_cast<InstrumentId>(i + 1);
+                snap.venue = static_cast<VenueId>(v + 1);
+                for (int lvl = 0; lvl < 3; ++lvl) {
+                    double off = px[i] * 0.0005 * (1.0 + lvl);
+                    snap.bids.push_back(BookLevel{px[i] - off, 10.0 + lvl});
+                    snap.asks.push_back(BookLevel{px[i] + off, 10.0 + lvl});
+                }
+                out.push_back(std::move(snap));
+            }
+        }
+    }
+    return out;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    size_t ticks = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    constexpr size_t kInstruments = 5;
+    constexpr size_t kVenues = 2;
+
+    std::unordered_map<InstrumentId, MarketMakingParams> params;
+    std::vector<InstrumentId> ids;
+    for (InstrumentId id = 1; id <= kInstruments; ++id) {
+        params[id] = MarketMakingParams{};
+        ids.push_back(id);
+    }
+    std::vector<VenueConfig> venues = {
+        {.id = 1, .name = "V1", .maker_fee_bp = 0.5, .taker_fee_bp = 1.5,
+         .latency_ms = 0.5, .cancel_penalty_bp = 0.05},
+        {.id = 2, .name = "V2", .maker_fee_bp = 0.8, .taker_fee_bp = 2.0,
+         .latency_ms = 0.3, .cancel_penalty_bp = 0.1},
+    };
+
+    auto snapshots = make_snapshots(ticks, kInstruments, kVenues);
+
+    MarketDataAggregator md;
+    RiskManager risk(params);
+    QuoteEngine qe(params);
+    VenueRouter router(venues);
+    NullExecutionGateway gw;
+    MarketMakerController controller(md, risk, qe, router, gw, ids);
+
+    // Warm up: first sighting of each (instrument, venue) sizes the buffers.
+    size_t warmup = std::min(snapshots.size(), kInstruments * kVenues * 64);
+    for (size_t i = 0; i < warmup; ++i) {
+        controller.on_market_data(snapshots[i]);
+    }
+
+    uint64_t allocs_before = g_allocations.load(std::memory_order_relaxed);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = warmup; i < snapshots.size(); ++i) {
+        controller.on_market_data(snapshots[i]);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    uint64_t allocs = g_allocations.load(std::memory_order_relaxed) - allocs_before;
+
+    size_t measured = snapshots.size() - warmup;
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+    std::printf("ticks:             %zu\n", measured);
+    std::printf("ns/tick:           %.1f\n", measured ? ns / measured : 0.0);
+    std::printf("allocations/tick:  %.4f\n",
+                measured ? static_cast<double>(allocs) / measured : 0.0);
+    std::printf("orders sent:       %llu\n",
+                static_cast<unsigned long long>(gw.orders_sent()));
+    return 0;
+}
@@ -3,10 +3,12 @@
 #include "strategy/market_maker_controller.hpp"
 #include "execution/sim_execution_gateway.hpp"
 #include "backtest/metrics.hpp"
+#include "runtime/pipeline.hpp"
 
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
-#include <functional>
 
 namespace mme {
 
@@ -16,6 +18,10 @@ struct BacktestConfig {
     std::unordered_map<InstrumentId, MarketMakingParams> params;
     std::string data_file;      // path to CSV data file
     double fill_probability = 0.3; // probability of fill when at best level
+    bool pipelined = false;        // run feed / strategy / gateway on separate threads
+    PortfolioLimits risk_limits;   // portfolio-wide pre-trade limits
+    VarConfig var;                 // VaR model, tracked when risk_limits.max_var > 0
+    PipelineConfig pipeline;
 };
 
 class BacktestRunner {
@@ -29,6 +35,16 @@ public:
     void run_synthetic(size_t num_ticks, size_t num_instruments = 5, size_t num_venues = 2);
 
     const MetricsCollector& metrics() const { return metrics_; }
+    // Populated after a pipelined run
+    const PipelineStats& pipeline_stats() const { return pipeline_stats_; }
+    // Quote cache counters from the last run
+    const QuoteCacheStats& quote_cache_stats() const { return quote_cache_stats_; }
+    // Portfolio VaR at the end of the last run; 0 unless tracked
+    double final_var() const { return final_var_; }
+
+    // Parameters the quote engine and risk manager read on every tick.
+    // Publishing here (e.g. from a ConfigWatcher) takes effect mid-run.
+    ParamStore& param_store() { return *params_; }
 
     // Generate report and CSV
     void write_report(const std::string& report_path) const;
@@ -43,9 +59,26 @@ private:
         size_t num_ticks, size_t num_instruments, size_t num_venues) const;
 
     void process_snapshots(const std::vector<VenueBookSnapshot>& snapshots);
+    void process_snapshots_pipelined(const std::vector<VenueBookSnapshot>& snapshots);
+
+    std::vector<VenueConfig>  venues_or_default() const;
+    // Configured instruments in declaration order, then any others that
+    // only have params
+    InstrumentRegistry        make_registry() const;
+    std::vector<InstrumentId> instrument_ids() const;
+    // Tracks factor exposure in `risk` and skews `qe` on it when any
+    // instrument has factor_loadings
+    void enable_factor_skew(RiskManager& risk, QuoteEngine& qe) const;
+
+    void record_tick(const MarketDataAggregator& md, RiskManager& risk,
+                     const VenueBookSnapshot& snapshot, Timestamp ts);
 
     BacktestConfig config_;
+    std::shared_ptr<ParamStore> params_;
     MetricsCollector metrics_;
+    PipelineStats pipeline_stats_;
+    QuoteCacheStats quote_cache_stats_;
+    double final_var_ = 0.0;
 };
 
 } // namespace mme
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "config/instrument_config.hpp"
+#include "config/instrument_registry.hpp"
 #include "strategy/quote_engine.hpp"
 
 #include <vector>
@@ -63,11 +64,19 @@ public:
     std::string generate_report() const;
 
 private:
-    std::unordered_map<InstrumentId, std::vector<TickMetric>> ticks_;
-    std::unordered_map<InstrumentId, uint64_t> quote_counts_;
-    std::unordered_map<InstrumentId, uint64_t> fill_counts_;
-    std::unordered_map<InstrumentId, uint64_t> cancel_counts_;
-    std::unordered_map<InstrumentId, std::vector<double>> spread_captures_;
+    struct InstrumentSeries {
+        std::vector<TickMetric> ticks;
+        std::vector<double>     spread_captures;
+        uint64_t                quotes  = 0;
+        uint64_t                fills   = 0;
+        uint64_t                cancels = 0;
+    };
+
+    InstrumentSeries& series_for(InstrumentId id);
+
+    // Instruments in order of first appearance
+    InstrumentRegistry            registry_;
+    std::vector<InstrumentSeries> series_;   // by InstrumentIndex
     double max_exposure_ = 0.0;
 };
 
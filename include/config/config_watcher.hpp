@@ -0,0 +1,43 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace mme {
+
+// Calls `on_change` on a background thread whenever the file at `path` is
+// rewritten. On Linux it uses inotify on the parent directory, so editors
+// that save by renaming a temp file over the original are caught too;
+// elsewhere it polls the modification time every poll_ms. The callback
+// typically re-parses the file and publishes to a ParamStore; it never runs
+// on the hot path.
+class ConfigWatcher {
+public:
+    ConfigWatcher(std::string path, std::function<void()> on_change, int poll_ms = 200);
+    ~ConfigWatcher();
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    // False if the watch could not be set up (e.g. the directory is missing).
+    bool start();
+    void stop();
+
+    bool running() const { return thread_.joinable(); }
+
+private:
+    void run_inotify();
+    void run_polling();
+
+    std::string           path_;
+    std::function<void()> on_change_;
+    int                   poll_ms_;
+    std::atomic<bool>     stop_{false};
+    std::thread           thread_;
+    int                   inotify_fd_ = -1;
+    int                   wake_fd_    = -1;
+};
+
+} // namespace mme
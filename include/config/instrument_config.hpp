@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace mme {
 
@@ -14,6 +15,7 @@ struct InstrumentConfig {
     double       lot_size;
     double       base_spread_bp;      // baseline spread in basis points
     double       inventory_limit;     // max absolute position
+    std::vector<double> factor_loadings = {};   // betas to the portfolio risk factors
 };
 
 } // namespace mme
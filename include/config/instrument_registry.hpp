@@ -0,0 +1,78 @@
+#pragma once
+
+#include "config/instrument_config.hpp"
+#include "config/venue_config.hpp"
+#include "util/flat_index_map.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mme {
+
+// Dense 0..n-1 index of an instrument / venue, used to address
+// per-instrument state stored in plain arrays.
+using InstrumentIndex = uint32_t;
+using VenueIndex      = uint32_t;
+
+inline constexpr InstrumentIndex kNoInstrument = UINT32_MAX;
+inline constexpr VenueIndex      kNoVenue      = UINT32_MAX;
+
+// Maps external instrument ids, symbols and venue ids to dense indices.
+// Built once at startup; indices are assigned in insertion order and never
+// change. Components built from the same registry (or the same set of
+// instrument ids, see from_keys) agree on every index, so the hot path
+// resolves an id once and passes the index along.
+class InstrumentRegistry {
+public:
+    InstrumentRegistry() : by_id_(16) { venue_index_.fill(kNoVenue); }
+    InstrumentRegistry(const std::vector<InstrumentConfig>& instruments,
+                       const std::vector<VenueConfig>& venues);
+
+    // Instruments of a map keyed by InstrumentId, in ascending id order.
+    template <typename Map>
+    static InstrumentRegistry from_keys(const Map& map) {
+        std::vector<InstrumentId> ids;
+        ids.reserve(map.size());
+        for (const auto& [id, _] : map) ids.push_back(id);
+        std::sort(ids.begin(), ids.end());
+        InstrumentRegistry reg;
+        for (InstrumentId id : ids) reg.add_instrument(id);
+        return reg;
+    }
+
+    // Idempotent: returns the existing index for a known id.
+    InstrumentIndex add_instrument(InstrumentId id, std::string symbol = {});
+    VenueIndex      add_venue(VenueId id);
+
+    // kNoInstrument / kNoVenue when unknown.
+    InstrumentIndex index(InstrumentId id) const {
+        uint32_t i = by_id_.find(id);
+        return i == FlatIndexMap::kNotFound ? kNoInstrument : i;
+    }
+    InstrumentIndex index(std::string_view symbol) const;
+    VenueIndex      venue_index(VenueId id) const { return venue_index_[id]; }
+
+    InstrumentId       id(InstrumentIndex i) const { return ids_[i]; }
+    const std::string& symbol(InstrumentIndex i) const { return symbols_[i]; }
+    VenueId            venue_id(VenueIndex i) const { return venue_ids_[i]; }
+
+    size_t size()       const { return ids_.size(); }
+    size_t num_venues() const { return venue_ids_.size(); }
+
+    const std::vector<InstrumentId>& ids() const { return ids_; }
+
+private:
+    std::vector<InstrumentId>                      ids_;
+    std::vector<std::string>                       symbols_;
+    FlatIndexMap                                   by_id_;
+    std::unordered_map<std::string, InstrumentIndex> by_symbol_;   // startup only
+    std::vector<VenueId>                           venue_ids_;
+    std::array<VenueIndex, 256>                    venue_index_;    // VenueId is 8 bits
+};
+
+} // namespace mme
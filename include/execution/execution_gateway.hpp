@@ -2,27 +2,102 @@
 
 #include "config/instrument_config.hpp"
 #include "config/venue_config.hpp"
+#include "util/fixed_point.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <span>
 
 namespace mme {
 
 enum class OrderSide { Buy, Sell };
 
+// `price_ticks` / `size_lots` are the exact values on the instrument grid;
+// `price` / `size` are the same scaled to doubles for the wire. Grid values
+// left at 0 are derived from the doubles by gateways that price in ticks.
 struct LiveOrder {
-    uint64_t     id         = 0;
+    uint64_t     id          = 0;
+    InstrumentId instrument  = 0;
+    VenueId      venue       = 0;
+    OrderSide    side        = OrderSide::Buy;
+    double       price       = 0.0;
+    double       size        = 0.0;
+    PriceTicks   price_ticks = 0;
+    QtyLots      size_lots   = 0;
+};
+
+// One execution against a resting order, as reported by the gateway. `qty`
+// is signed (> 0 bought); `leaves` is what still rests on the order
+// afterwards, 0 once it is done.
+struct Fill {
+    uint64_t     order_id   = 0;
     InstrumentId instrument = 0;
     VenueId      venue      = 0;
-    OrderSide    side       = OrderSide::Buy;
     double       price      = 0.0;
-    double       size       = 0.0;
+    double       qty        = 0.0;
+    double       leaves     = 0.0;
+};
+
+enum class OrderActionType : uint8_t { New, Cancel, Amend };
+
+// One entry of a batched submission.
+//   New:    `order` is sent; on return order.id holds the assigned id (0 = rejected)
+//   Cancel: order.id is cancelled
+//   Amend:  order.id is changed to (order.price, order.size)
+// `ok` reports whether the action was accepted.
+struct OrderAction {
+    OrderActionType type  = OrderActionType::New;
+    LiveOrder       order;
+    bool            ok    = false;
 };
 
+// Runs each action through the gateway's single-order calls, in order.
+template <typename Gateway>
+void apply_actions(Gateway& gw, std::span<OrderAction> actions) {
+    for (auto& a : actions) {
+        switch (a.type) {
+            case OrderActionType::New:
+                a.order.id = gw.send_limit_order(a.order);
+                a.ok = a.order.id != 0;
+                break;
+            case OrderActionType::Cancel:
+                gw.cancel_order(a.order.id);
+                a.ok = true;
+                break;
+            case OrderActionType::Amend:
+                a.ok = gw.amend_limit_order(a.order);
+                break;
+        }
+    }
+}
+
 class IExecutionGateway {
 public:
     virtual ~IExecutionGateway() = default;
     virtual uint64_t send_limit_order(const LiveOrder& order) = 0;
     virtual void     cancel_order(uint64_t order_id) = 0;
+    // Atomically change price and/or size of a live order, keeping its id.
+    // Returns false if the order is no longer live.
+    virtual bool     amend_order(uint64_t order_id, double new_price, double new_size) = 0;
+    // Amend to the grid values of `order` (order.id must be live). Gateways
+    // that price in ticks override this; the default sends the doubles.
+    virtual bool     amend_limit_order(const LiveOrder& order) {
+        return amend_order(order.id, order.price, order.size);
+    }
+
+    // Batched entry points so network gateways can pack several actions into
+    // one write. The defaults forward to the single-order calls in order.
+    virtual void send_batch(std::span<OrderAction> actions) { apply_actions(*this, actions); }
+
+    virtual void cancel_batch(std::span<const uint64_t> order_ids) {
+        for (uint64_t id : order_ids) cancel_order(id);
+    }
+
+    // Mass cancel (kill switch). Each returns the number of orders cancelled
+    // where the gateway can tell, 0 otherwise.
+    virtual size_t cancel_all() = 0;
+    virtual size_t cancel_instrument(InstrumentId instrument) = 0;
+    virtual size_t cancel_venue(VenueId venue) = 0;
 };
 
 } // namespace mme
@@ -2,48 +2,270 @@
 
 #include "execution/execution_gateway.hpp"
 #include "market/market_view.hpp"
+#include "strategy/market_making_params.hpp"
 
 #include <unordered_map>
+#include <unordered_set>
 #include <functional>
+#include <algorithm>
 #include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 namespace mme {
 
-// Callback invoked when a simulated fill occurs.
-// Parameters: instrument_id, venue_id, price, signed_qty (+ for buy, - for sell)
-using FillCallback = std::function<void(InstrumentId, VenueId, double, double)>;
+// Callback invoked for each simulated fill.
+using FillCallback = std::function<void(const Fill&)>;
 
-class SimExecutionGateway : public IExecutionGateway {
+// Fill simulation against book snapshots, templated on the fill callback
+// so a concrete functor is called (and inlined) directly. Not virtual: use
+// SimExecutionGateway where an IExecutionGateway is needed. Orders rest at
+// the price_ticks / size_lots they were sent with; an order that only sets
+// price / size is put on the grid of its instrument. Book prices are
+// converted to ticks of the instrument's tick size, which must be set
+// before its orders are sent without grid values or checked for fills
+// (std::invalid_argument otherwise).
+// A crossing order fills completely unless partial fills are enabled.
+template <typename OnFill>
+class BasicSimExecutionGateway {
 public:
-    explicit SimExecutionGateway(FillCallback on_fill);
+    explicit BasicSimExecutionGateway(OnFill on_fill) : on_fill_(std::move(on_fill)) {}
 
-    uint64_t send_limit_order(const LiveOrder& order) override;
-    void     cancel_order(uint64_t order_id) override;
+    void set_tick_size(InstrumentId id, double tick_size) { scales_[id].tick_size = tick_size; }
+    // Tick and lot size of every instrument in `params`
+    void set_tick_sizes(const std::unordered_map<InstrumentId, MarketMakingParams>& params) {
+        for (const auto& [id, p] : params) scales_[id] = p.scale();
+    }
+
+    // Caps each fill at the size shown at the opposite touch; the rest of
+    // the order keeps resting. Sizes are matched in whole lots.
+    void set_partial_fills(bool enabled) { partial_fills_ = enabled; }
+
+    uint64_t send_limit_order(const LiveOrder& order) {
+        uint64_t id = next_order_id_++;
+        LiveOrder stored = order;
+        stored.id = id;
+        fill_grid(stored);
+        orders_[id] = stored;
+        by_instrument_[order.instrument].insert(id);
+        by_venue_[order.venue].insert(id);
+        return id;
+    }
+
+    void cancel_order(uint64_t order_id) { erase_order(order_id); }
+
+    // Double-only interface: the new price and size are rounded onto the grid
+    bool amend_order(uint64_t order_id, double new_price, double new_size) {
+        auto it = orders_.find(order_id);
+        if (it == orders_.end()) return false;
+        it->second.price = new_price;
+        it->second.size = new_size;
+        const PriceScale s = scale(it->second.instrument);
+        it->second.price_ticks = s.to_ticks(new_price);
+        it->second.size_lots   = s.to_lots(new_size);
+        return true;
+    }
+
+    bool amend_limit_order(const LiveOrder& order) {
+        auto it = orders_.find(order.id);
+        if (it == orders_.end()) return false;
+        it->second.price       = order.price;
+        it->second.size        = order.size;
+        it->second.price_ticks = order.price_ticks;
+        it->second.size_lots   = order.size_lots;
+        fill_grid(it->second);
+        return true;
+    }
+
+    void send_batch(std::span<OrderAction> actions) { apply_actions(*this, actions); }
+
+    size_t cancel_all() {
+        size_t n = orders_.size();
+        orders_.clear();
+        for (auto& [inst, ids] : by_instrument_) ids.clear();
+        for (auto& [venue, ids] : by_venue_) ids.clear();
+        return n;
+    }
+
+    size_t cancel_instrument(InstrumentId instrument) {
+        auto it = by_instrument_.find(instrument);
+        if (it == by_instrument_.end()) return 0;
+        size_t n = it->second.size();
+        for (uint64_t id : it->second) {
+            auto o = orders_.find(id);
+            by_venue_[o->second.venue].erase(id);
+            orders_.erase(o);
+        }
+        it->second.clear();
+        return n;
+    }
+
+    size_t cancel_venue(VenueId venue) {
+        auto it = by_venue_.find(venue);
+        if (it == by_venue_.end()) return 0;
+        size_t n = it->second.size();
+        for (uint64_t id : it->second) {
+            auto o = orders_.find(id);
+            by_instrument_[o->second.instrument].erase(id);
+            orders_.erase(o);
+        }
+        it->second.clear();
+        return n;
+    }
 
     // Drive the simulation: check resting orders against current book snapshot.
     // Fills occur if the order price crosses the opposite side of the book.
-    void check_fills(const VenueBookSnapshot& snapshot);
+    void check_fills(const VenueBookSnapshot& snapshot) {
+        auto idx = by_instrument_.find(snapshot.instrument);
+        if (idx == by_instrument_.end() || idx->second.empty()) return;
+
+        const PriceScale s = scale(snapshot.instrument);
+        const bool has_ask = !snapshot.asks.empty();
+        const bool has_bid = !snapshot.bids.empty();
+        const PriceTicks best_ask = has_ask ? s.to_ticks(snapshot.asks.front().price) : 0;
+        const PriceTicks best_bid = has_bid ? s.to_ticks(snapshot.bids.front().price) : 0;
+
+        filled_ids_.clear();
+        for (uint64_t id : idx->second) {
+            const LiveOrder& order = orders_.find(id)->second;
+            if (order.venue != snapshot.venue) continue;
+
+            bool fill = false;
+            if (order.side == OrderSide::Buy) {
+                // Buy order fills (at its limit) if best ask <= order price
+                fill = has_ask && best_ask <= order.price_ticks;
+            } else {
+                // Sell order fills if best bid >= order price
+                fill = has_bid && best_bid >= order.price_ticks;
+            }
+            if (fill) filled_ids_.push_back(id);
+        }
+
+        // Settle every fill before calling back so the callback sees a
+        // consistent book
+        fills_.clear();
+        for (uint64_t id : filled_ids_) {
+            LiveOrder& order = orders_.find(id)->second;
+            Fill fill{.order_id = id, .instrument = order.instrument, .venue = order.venue,
+                      .price = order.price, .qty = order.size, .leaves = 0.0};
+            if (partial_fills_) {
+                const BookLevel& touch = order.side == OrderSide::Buy ? snapshot.asks.front()
+                                                                      : snapshot.bids.front();
+                const QtyLots shown  = s.to_lots(touch.quantity);
+                const QtyLots filled = std::min(order.size_lots, shown);
+                if (filled <= 0) continue;
+                if (filled < order.size_lots) {
+                    order.size_lots -= filled;
+                    order.size = s.to_qty(order.size_lots);
+                    fill.qty = s.to_qty(filled);
+                    fill.leaves = order.size;
+                }
+            }
+            if (order.side == OrderSide::Sell) fill.qty = -fill.qty;
+            if (fill.leaves == 0.0) erase_order(id);
+            fills_.push_back(fill);
+        }
+        if constexpr (std::is_constructible_v<bool, const OnFill&>) {
+            if (!on_fill_) return;
+        }
+        for (const Fill& fill : fills_) on_fill_(fill);
+    }
 
     size_t active_order_count() const { return orders_.size(); }
 
+    OnFill& fill_sink() { return on_fill_; }
+
 private:
+    PriceScale scale(InstrumentId id) const {
+        auto it = scales_.find(id);
+        if (it == scales_.end()) {
+            throw std::invalid_argument("sim gateway: no tick size set for instrument " +
+                                        std::to_string(id));
+        }
+        return it->second;
+    }
+
+    // Grid values the sender left unset are derived from price / size
+    void fill_grid(LiveOrder& order) const {
+        if (order.price_ticks != 0 && order.size_lots != 0) return;
+        const PriceScale s = scale(order.instrument);
+        if (order.price_ticks == 0) order.price_ticks = s.to_ticks(order.price);
+        if (order.size_lots == 0)   order.size_lots   = s.to_lots(order.size);
+    }
+
+    void erase_order(uint64_t order_id) {
+        auto it = orders_.find(order_id);
+        if (it == orders_.end()) return;
+        by_instrument_[it->second.instrument].erase(order_id);
+        by_venue_[it->second.venue].erase(order_id);
+        orders_.erase(it);
+    }
+
     uint64_t next_order_id_ = 1;
     std::unordered_map<uint64_t, LiveOrder> orders_;
-    FillCallback on_fill_;
+    // Secondary indexes so mass cancels and fill checks touch only the
+    // relevant orders
+    std::unordered_map<InstrumentId, std::unordered_set<uint64_t>> by_instrument_;
+    std::unordered_map<VenueId, std::unordered_set<uint64_t>>      by_venue_;
+    std::unordered_map<InstrumentId, PriceScale>                   scales_;
+    std::vector<uint64_t> filled_ids_;
+    std::vector<Fill>     fills_;
+    bool                  partial_fills_ = false;
+    OnFill on_fill_;
+};
+
+// Virtual-dispatch wrapper used wherever an IExecutionGateway is expected.
+class SimExecutionGateway : public IExecutionGateway {
+public:
+    explicit SimExecutionGateway(FillCallback on_fill) : sim_(std::move(on_fill)) {}
+
+    uint64_t send_limit_order(const LiveOrder& order) override;
+    void     cancel_order(uint64_t order_id) override;
+    bool     amend_order(uint64_t order_id, double new_price, double new_size) override;
+    bool     amend_limit_order(const LiveOrder& order) override;
+
+    size_t cancel_all() override;
+    size_t cancel_instrument(InstrumentId instrument) override;
+    size_t cancel_venue(VenueId venue) override;
+
+    void   set_tick_size(InstrumentId id, double tick_size) { sim_.set_tick_size(id, tick_size); }
+    void   set_tick_sizes(const std::unordered_map<InstrumentId, MarketMakingParams>& params) {
+        sim_.set_tick_sizes(params);
+    }
+    void   set_partial_fills(bool enabled) { sim_.set_partial_fills(enabled); }
+    void   check_fills(const VenueBookSnapshot& snapshot) { sim_.check_fills(snapshot); }
+    size_t active_order_count() const { return sim_.active_order_count(); }
+
+private:
+    BasicSimExecutionGateway<FillCallback> sim_;
 };
 
 class NullExecutionGateway : public IExecutionGateway {
 public:
     uint64_t send_limit_order(const LiveOrder& order) override;
     void     cancel_order(uint64_t order_id) override;
+    bool     amend_order(uint64_t order_id, double new_price, double new_size) override;
+    void     send_batch(std::span<OrderAction> actions) override;
+
+    size_t cancel_all() override;
+    size_t cancel_instrument(InstrumentId instrument) override;
+    size_t cancel_venue(VenueId venue) override;
 
     uint64_t orders_sent()      const { return orders_sent_; }
     uint64_t cancels_sent()     const { return cancels_sent_; }
+    uint64_t amends_sent()      const { return amends_sent_; }
+    uint64_t batches_sent()     const { return batches_sent_; }
+    uint64_t mass_cancels()     const { return mass_cancels_; }
 
 private:
     uint64_t next_order_id_ = 1;
     uint64_t orders_sent_   = 0;
     uint64_t cancels_sent_  = 0;
+    uint64_t amends_sent_   = 0;
+    uint64_t batches_sent_  = 0;
+    uint64_t mass_cancels_  = 0;
 };
 
 } // namespace mme
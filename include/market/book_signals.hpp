@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+
+namespace mme {
+
+// Sums over a structure-of-arrays copy of consolidated depth. Empty levels
+// are encoded with zero quantity so they drop out of every sum.
+struct BookSignalSums {
+    double bid_qty       = 0.0;
+    double bid_notional  = 0.0;   // sum(price * qty)
+    double ask_qty       = 0.0;
+    double ask_notional  = 0.0;
+    double bid_touch_qty = 0.0;   // quantity at price == best_bid
+    double ask_touch_qty = 0.0;   // quantity at price == best_ask
+};
+
+// One pass over n levels per side. Uses AVX2 when the CPU supports it.
+BookSignalSums compute_book_sums(const double* bid_px, const double* bid_qty,
+                                 const double* ask_px, const double* ask_qty,
+                                 size_t n, double best_bid, double best_ask);
+
+// Scalar reference kernel (always available).
+BookSignalSums compute_book_sums_scalar(const double* bid_px, const double* bid_qty,
+                                        const double* ask_px, const double* ask_qty,
+                                        size_t n, double best_bid, double best_ask);
+
+} // namespace mme
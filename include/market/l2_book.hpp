@@ -0,0 +1,127 @@
+#pragma once
+
+#include "market/market_view.hpp"
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace mme {
+
+enum class LevelSide : uint8_t { Bid, Ask };
+enum class LevelAction : uint8_t { Add, Modify, Delete };
+
+// Incremental per-level change from a venue feed. Add and Modify set the
+// total quantity resting at `price`; Delete removes the level.
+struct LevelUpdate {
+    InstrumentId instrument = 0;
+    VenueId      venue      = 0;
+    LevelSide    side       = LevelSide::Bid;
+    LevelAction  action     = LevelAction::Add;
+    double       price      = 0.0;
+    double       quantity   = 0.0;
+};
+
+// One side of a book as a tick-indexed ladder: a ring of quantities covering
+// a window of `window` consecutive ticks. Setting a level is O(1); removing
+// the touch scans outward to the next populated tick. Levels deeper than the
+// window are parked in an ordered overflow map (O(log n)) and move back into
+// the ring when the window reaches them, so the touch can run away and come
+// back without losing depth.
+class PriceLadder {
+public:
+    static constexpr size_t kDefaultWindow = 4096;
+
+    PriceLadder(bool is_bid, size_t window = kDefaultWindow);
+
+    // qty <= 0 removes the level.
+    void set(int64_t tick, double qty);
+    void clear();
+
+    // The ring is only empty when the overflow is too
+    bool    empty()  const { return levels_ == 0; }
+    size_t  levels() const { return levels_ + overflow_.size(); }
+    size_t  overflow_levels() const { return overflow_.size(); }
+    int64_t best()   const { return best_; }
+    double  quantity_at(int64_t tick) const;
+
+    // Calls f(tick, qty) for up to `n` populated levels from the touch outward.
+    template <typename F>
+    size_t for_each_level(size_t n, F&& f) const {
+        size_t visited = 0;
+        if (empty()) return 0;
+        int64_t step = is_bid_ ? -1 : 1;
+        for (int64_t t = best_; visited < n && visited < levels_ && in_window(t); t += step) {
+            double q = qty_[slot(t)];
+            if (q > 0.0) {
+                f(t, q);
+                ++visited;
+            }
+        }
+        // Parked levels are all deeper than the window
+        if (is_bid_) {
+            for (auto it = overflow_.rbegin(); visited < n && it != overflow_.rend(); ++it, ++visited) {
+                f(it->first, it->second);
+            }
+        } else {
+            for (auto it = overflow_.begin(); visited < n && it != overflow_.end(); ++it, ++visited) {
+                f(it->first, it->second);
+            }
+        }
+        return visited;
+    }
+
+private:
+    size_t slot(int64_t tick) const {
+        int64_t w = static_cast<int64_t>(qty_.size());
+        int64_t m = tick % w;
+        return static_cast<size_t>(m < 0 ? m + w : m);
+    }
+    bool in_window(int64_t tick) const {
+        return tick >= lo_ && tick < lo_ + static_cast<int64_t>(qty_.size());
+    }
+    bool better(int64_t a, int64_t b) const { return is_bid_ ? a > b : a < b; }
+    void recenter(int64_t tick);
+    void rescan_best();
+
+    bool                is_bid_;
+    std::vector<double> qty_;
+    int64_t             lo_     = 0;
+    int64_t             best_   = 0;
+    size_t              levels_ = 0;   // populated ticks in the ring
+    std::map<int64_t, double> overflow_;   // populated ticks deeper than the window
+};
+
+// Per-venue L2 book maintained from incremental level updates.
+class L2Book {
+public:
+    explicit L2Book(double tick_size, size_t window_ticks = PriceLadder::kDefaultWindow);
+
+    void apply(const LevelUpdate& update);
+    void clear();
+
+    double tick_size() const { return tick_size_; }
+
+    // Same conventions as VenueBookSnapshot: 0 / max() when the side is empty.
+    double best_bid() const;
+    double best_ask() const;
+
+    size_t bid_levels() const { return bids_.levels(); }
+    size_t ask_levels() const { return asks_.levels(); }
+
+    // Total quantity over the top `levels` populated levels of one side.
+    double depth(LevelSide side, size_t levels) const;
+
+    // Write the top kMaxBookDepth levels of each side into `out`.
+    void to_snapshot(VenueBookSnapshot& out) const;
+
+private:
+    int64_t to_tick(double price) const;
+    double  to_price(int64_t tick) const { return static_cast<double>(tick) * tick_size_; }
+
+    double      tick_size_;
+    PriceLadder bids_;
+    PriceLadder asks_;
+};
+
+} // namespace mme
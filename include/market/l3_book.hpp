@@ -0,0 +1,117 @@
+#pragma once
+
+#include "market/l2_book.hpp"
+#include "market/market_view.hpp"
+#include "util/flat_index_map.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace mme {
+
+class MarketDataAggregator;
+
+enum class OrderMessageType : uint8_t { Add, Execute, Cancel, Replace };
+
+// Order-level feed message keyed by exchange order id.
+//   Add:     new order (side, price, quantity)
+//   Execute: `quantity` traded against a resting order
+//   Cancel:  `quantity` removed from a resting order (0 = whole order)
+//   Replace: order_id is removed and re-entered as new_order_id at
+//            (price, quantity), losing queue priority
+struct OrderMessage {
+    OrderMessageType type         = OrderMessageType::Add;
+    LevelSide        side         = LevelSide::Bid;
+    uint64_t         order_id     = 0;
+    uint64_t         new_order_id = 0;
+    double           price        = 0.0;
+    double           quantity     = 0.0;
+};
+
+// Order-by-order (L3) book for one instrument on one venue. Orders live in a
+// pooled store and are linked into per-price FIFO queues; an open-addressing
+// index maps exchange order ids to pool slots. Aggregated quantity per price
+// is kept on tick ladders so top-N depth is available without a scan of the
+// order store.
+class L3Book {
+public:
+    L3Book(InstrumentId instrument, VenueId venue, double tick_size,
+           size_t expected_orders = 1 << 16);
+
+    // Returns false if the message refers to an unknown order id (or, for
+    // Add, reuses a live id).
+    bool apply(const OrderMessage& msg);
+
+    bool add(uint64_t order_id, LevelSide side, double price, double quantity);
+    bool execute(uint64_t order_id, double quantity);
+    bool cancel(uint64_t order_id, double quantity = 0.0);
+    bool replace(uint64_t order_id, uint64_t new_order_id, double price, double quantity);
+
+    void clear();
+
+    double best_bid() const;
+    double best_ask() const;
+    size_t order_count() const { return index_.size(); }
+
+    // Quantity and order count resting at a price level.
+    double   level_quantity(LevelSide side, double price) const;
+    uint32_t level_order_count(LevelSide side, double price) const;
+
+    // Quantity queued ahead of the order at its price level (FIFO priority);
+    // negative if the order is unknown.
+    double queue_ahead(uint64_t order_id) const;
+
+    // Aggregated top-N levels of each side.
+    void to_snapshot(VenueBookSnapshot& out) const;
+
+    // Push the aggregated top-N into the aggregator as this venue's book.
+    void publish(MarketDataAggregator& md) const;
+
+private:
+    static constexpr uint32_t kNil = UINT32_MAX;
+
+    struct Order {
+        uint64_t  id       = 0;
+        int64_t   tick     = 0;
+        double    quantity = 0.0;
+        uint32_t  prev     = kNil;   // intrusive FIFO links within a level
+        uint32_t  next     = kNil;
+        uint32_t  level    = kNil;
+        LevelSide side     = LevelSide::Bid;
+    };
+
+    struct Level {
+        uint32_t head   = kNil;
+        uint32_t tail   = kNil;
+        uint32_t count  = 0;
+        double   quantity = 0.0;
+    };
+
+    int64_t  to_tick(double price) const;
+    double   to_price(int64_t tick) const { return static_cast<double>(tick) * tick_size_; }
+    static uint64_t level_key(LevelSide side, int64_t tick) {
+        return (static_cast<uint64_t>(tick) << 1) | (side == LevelSide::Ask ? 1u : 0u);
+    }
+
+    uint32_t alloc_order();
+    uint32_t acquire_level(LevelSide side, int64_t tick);
+    void     remove_order(uint32_t idx);
+    void     reduce_order(uint32_t idx, double quantity);
+    PriceLadder& ladder(LevelSide side) { return side == LevelSide::Bid ? bids_ : asks_; }
+    const PriceLadder& ladder(LevelSide side) const { return side == LevelSide::Bid ? bids_ : asks_; }
+
+    InstrumentId instrument_;
+    VenueId      venue_;
+    double       tick_size_;
+
+    std::vector<Order>    orders_;
+    std::vector<uint32_t> free_orders_;
+    std::vector<Level>    levels_;
+    std::vector<uint32_t> free_levels_;
+    FlatIndexMap          index_;        // order id -> orders_ slot
+    FlatIndexMap          level_index_;  // (side, tick) -> levels_ slot
+    PriceLadder           bids_;
+    PriceLadder           asks_;
+};
+
+} // namespace mme
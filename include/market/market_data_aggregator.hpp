@@ -1,38 +1,127 @@
 #pragma once
 
 #include "market/market_view.hpp"
+#include "market/l2_book.hpp"
+#include "market/volatility_estimators.hpp"
 #include "config/instrument_config.hpp"
+#include "config/instrument_registry.hpp"
 
-#include <unordered_map>
+#include <array>
 #include <deque>
+#include <unordered_map>
+#include <limits>
+#include <vector>
 
 namespace mme {
 
+// Result of applying a book update, ordered by severity.
+enum class BookChange : uint8_t {
+    Unchanged,      // identical to the stored venue book
+    BookChanged,    // depth changed, consolidated best bid/ask did not
+    TouchChanged,   // consolidated best bid or ask moved
+};
+
 class MarketDataAggregator {
 public:
     // EWMA decay factor for volatility (0 < alpha <= 1, higher = more responsive)
     static constexpr double kDefaultEwmaAlpha = 0.05;
-    static constexpr size_t kMaxMidHistory    = 200;
+    // Secondary horizons published in InstrumentMarketView::vol_estimates
+    static constexpr double kSlowEwmaAlpha    = 0.01;
+    static constexpr double kFastEwmaAlpha    = 0.2;
+    static constexpr double kBurstEwmaAlpha   = 0.5;
+    static constexpr double kDefaultTickSize  = 0.01;
 
     explicit MarketDataAggregator(double ewma_alpha = kDefaultEwmaAlpha);
+    explicit MarketDataAggregator(const std::array<double, kNumEwmaHorizons>& ewma_alphas);
+
+    // Registers the registry's instruments in order. Returns true if each
+    // one ends up at the registry's index, i.e. the *_at calls below accept
+    // that registry's indices; call it before any data arrives.
+    bool add_instruments(const InstrumentRegistry& registry);
+
+    // Dense index of the instrument; kNoInstrument if never seen. New
+    // instruments are appended as data for them arrives.
+    InstrumentIndex index(InstrumentId id) const { return registry_.index(id); }
+
+    // Only the updated venue's contribution is recomputed; the consolidated
+    // touch is derived from cached per-venue bests.
+    BookChange on_book_update(const VenueBookSnapshot& snapshot);
+    // Hot path: `index` must be snapshot.instrument's index.
+    BookChange on_book_update_at(InstrumentIndex index, const VenueBookSnapshot& snapshot);
+
+    // Apply an incremental level change to the venue's L2 book and refresh
+    // the instrument view from its top levels.
+    BookChange on_level_update(const LevelUpdate& update);
+
+    // Tick size used to index L2 books for this instrument. Must be set
+    // before the first level update to take effect.
+    void set_tick_size(InstrumentId id, double tick_size);
 
-    void on_book_update(const VenueBookSnapshot& snapshot);
+    // L2 book built from level updates; nullptr if none were received.
+    const L2Book* find_l2_book(InstrumentId id, VenueId venue) const;
+
+    // Returns a deep copy of the view (including all venue books).
+    // Prefer find_view() on the hot path.
     InstrumentMarketView get_view(InstrumentId id) const;
+
+    // Borrowed, read-only view; nullptr if the instrument has no data yet.
+    // The pointer stays valid for the lifetime of the aggregator. Compare
+    // `version` against a previously seen value to detect updates.
+    const InstrumentMarketView* find_view(InstrumentId id) const {
+        return find_view_at(registry_.index(id));
+    }
+    const InstrumentMarketView* find_view_at(InstrumentIndex index) const {
+        return index < states_.size() && states_[index].has_data ? &states_[index].view : nullptr;
+    }
+
     bool has_view(InstrumentId id) const;
 
+    // Consolidated touch across venues; 0 / max() while that side is empty.
+    // `index` must have data.
+    double best_bid_at(InstrumentIndex index) const { return states_[index].best_bid; }
+    double best_ask_at(InstrumentIndex index) const { return states_[index].best_ask; }
+
 private:
+    struct VenueL2 {
+        VenueId venue;
+        L2Book  book;
+    };
+
+    // Cached contribution of one venue to the consolidated book
+    struct VenueTop {
+        double best_bid = 0.0;
+        double best_ask = std::numeric_limits<double>::max();
+        double depth    = 0.0;   // top-3 levels, both sides
+    };
+
     struct InstrumentState {
+        explicit InstrumentState(const std::array<double, kNumEwmaHorizons>& alphas)
+            : vol(alphas) {}
+
         InstrumentMarketView view;
-        std::deque<double>   mid_history;     // rolling window of mid prices
-        double               ewma_variance = 0.0;
-        bool                 initialized   = false;
+        std::vector<VenueTop> tops;           // parallel to view.venues
+        // Structure-of-arrays copy of all venues' depth, kMaxBookDepth
+        // entries per venue slot (empty levels have zero quantity)
+        std::vector<double>  bid_px, bid_qty, ask_px, ask_qty;
+        double               best_bid      = 0.0;
+        double               best_ask      = std::numeric_limits<double>::max();
+        std::vector<VenueL2> l2_books;        // only for venues sending deltas
+        VolatilityTracker    vol;
+        bool                 has_data      = false;
     };
 
+    InstrumentIndex index_for(InstrumentId id);
     void update_volatility(InstrumentState& state, double new_mid);
-    void rebuild_aggregate(InstrumentState& state);
+    static VenueTop venue_top(const VenueBookSnapshot& vs);
+    void rescan_touch(InstrumentState& state);
+    static void write_depth(InstrumentState& state, size_t slot, const VenueBookSnapshot& vs);
+    static void update_signals(InstrumentState& state);
 
-    double ewma_alpha_;
-    std::unordered_map<InstrumentId, InstrumentState> states_;
+    std::array<double, kNumEwmaHorizons> ewma_alphas_;
+    InstrumentRegistry                 registry_;
+    std::deque<InstrumentState>        states_;   // by InstrumentIndex; deque keeps views in place
+    std::unordered_map<InstrumentId, double> tick_sizes_;
+    VenueBookSnapshot scratch_snapshot_;   // reused by on_level_update
 };
 
 } // namespace mme
@@ -3,21 +3,95 @@
 #include "config/instrument_config.hpp"
 #include "config/venue_config.hpp"
 
-#include <vector>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
 #include <limits>
+#include <type_traits>
+#include <vector>
+
+// Maximum number of price levels kept per book side (set via CMake).
+#ifndef MME_MAX_BOOK_DEPTH
+#define MME_MAX_BOOK_DEPTH 10
+#endif
 
 namespace mme {
 
+inline constexpr size_t kMaxBookDepth = MME_MAX_BOOK_DEPTH;
+
 struct BookLevel {
     double price    = 0.0;
     double quantity = 0.0;
+
+    bool operator==(const BookLevel&) const = default;
+};
+
+// Fixed-capacity price levels stored inline, best level first.
+// Levels pushed beyond capacity are dropped, so building or copying a side
+// never touches the allocator.
+template <size_t N>
+class BookLevels {
+public:
+    static constexpr size_t kCapacity = N;
+
+    BookLevels() = default;
+    BookLevels(std::initializer_list<BookLevel> levels) { assign(levels); }
+
+    BookLevels& operator=(std::initializer_list<BookLevel> levels) {
+        assign(levels);
+        return *this;
+    }
+
+    // Returns false (and drops the level) when the side is full.
+    bool push_back(const BookLevel& level) {
+        if (count_ >= N) return false;
+        levels_[count_++] = level;
+        return true;
+    }
+
+    void clear() { count_ = 0; }
+
+    bool operator==(const BookLevels& other) const {
+        if (count_ != other.count_) return false;
+        for (uint32_t i = 0; i < count_; ++i) {
+            if (!(levels_[i] == other.levels_[i])) return false;
+        }
+        return true;
+    }
+
+    size_t size() const { return count_; }
+    bool   empty() const { return count_ == 0; }
+    static constexpr size_t capacity() { return N; }
+
+    const BookLevel& front() const { return levels_[0]; }
+    const BookLevel& operator[](size_t i) const { return levels_[i]; }
+    BookLevel&       operator[](size_t i) { return levels_[i]; }
+
+    const BookLevel* begin() const { return levels_.data(); }
+    const BookLevel* end()   const { return levels_.data() + count_; }
+    BookLevel*       begin() { return levels_.data(); }
+    BookLevel*       end()   { return levels_.data() + count_; }
+
+private:
+    void assign(std::initializer_list<BookLevel> levels) {
+        count_ = 0;
+        for (const auto& lvl : levels) {
+            if (!push_back(lvl)) break;
+        }
+    }
+
+    alignas(64) std::array<BookLevel, N> levels_{};
+    uint32_t count_ = 0;
 };
 
+using BookSide = BookLevels<kMaxBookDepth>;
+
 struct VenueBookSnapshot {
     InstrumentId instrument = 0;
     VenueId      venue      = 0;
-    std::vector<BookLevel> bids;
-    std::vector<BookLevel> asks;
+    BookSide     bids;
+    BookSide     asks;
 
     double best_bid() const {
         return bids.empty() ? 0.0 : bids.front().price;
@@ -28,12 +102,48 @@ struct VenueBookSnapshot {
     }
 };
 
+static_assert(std::is_trivially_copyable_v<VenueBookSnapshot>,
+              "snapshots are copied through queues and files with memcpy");
+static_assert(std::is_standard_layout_v<VenueBookSnapshot>);
+
+// Number of EWMA volatility horizons tracked per instrument
+inline constexpr size_t kNumEwmaHorizons = 4;
+
+// Which volatility estimate a consumer (e.g. the spread model) should use.
+enum class VolatilityEstimator : uint8_t {
+    Ewma,           // primary EWMA horizon (InstrumentMarketView::volatility)
+    EwmaSlow,
+    EwmaFast,
+    EwmaBurst,
+    Realized,       // rolling mean of squared returns over the window
+    Range,          // Parkinson high-low estimator
+};
+
+// Which price the quote engine centers its quotes on.
+enum class FairPrice : uint8_t {
+    Mid,            // (best_bid + best_ask) / 2
+    Microprice,
+    WeightedMid,    // depth-weighted mid over all levels
+};
+
+// Per-tick sigma estimates in log-return units.
+struct VolatilityEstimates {
+    std::array<double, kNumEwmaHorizons> ewma{};   // indexed like VolatilityEstimator::Ewma..EwmaBurst
+    double realized = 0.0;
+    double range    = 0.0;
+};
+
 struct InstrumentMarketView {
     InstrumentId id             = 0;
     double       mid_price      = 0.0;   // derived fair price
     double       spread         = 0.0;   // best_ask - best_bid
-    double       volatility     = 0.0;   // rolling sigma estimate
+    double       volatility     = 0.0;   // rolling sigma estimate (primary EWMA)
+    VolatilityEstimates vol_estimates;    // all horizons / estimators
     double       weighted_depth = 0.0;   // aggregate depth near mid
+    double       microprice     = 0.0;   // touch-size-weighted fair price
+    double       imbalance      = 0.0;   // (bid - ask) / (bid + ask) depth, all levels
+    double       weighted_mid   = 0.0;   // mean of bid and ask depth-weighted prices
+    uint64_t     version        = 0;     // bumped on every update (staleness check)
     std::vector<VenueBookSnapshot> venues;
 };
 
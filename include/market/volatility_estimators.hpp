@@ -0,0 +1,48 @@
+#pragma once
+
+#include "market/market_view.hpp"
+#include "util/ring_buffer.hpp"
+
+#include <array>
+#include <cstddef>
+
+namespace mme {
+
+// Incrementally updated volatility estimators over a stream of mid prices.
+// Every update is O(1) regardless of the window length: the EWMA horizons
+// are advanced together in one fixed-width loop, realized variance keeps a
+// running sum over a ring of squared returns, and the range estimator only
+// tracks the high/low of the current bar.
+class VolatilityTracker {
+public:
+    static constexpr size_t kWindow       = 256;  // returns kept for realized variance
+    static constexpr size_t kRangeBarTicks = 16;   // mids per high-low bar
+
+    explicit VolatilityTracker(const std::array<double, kNumEwmaHorizons>& alphas);
+
+    void on_mid(double mid);
+
+    const VolatilityEstimates& estimates() const { return estimates_; }
+    size_t samples() const { return returns_sq_.size(); }
+
+private:
+    alignas(32) std::array<double, kNumEwmaHorizons> alpha_;
+    alignas(32) std::array<double, kNumEwmaHorizons> decay_;     // 1 - alpha
+    alignas(32) std::array<double, kNumEwmaHorizons> variance_{};
+
+    RingBuffer<double, kWindow> returns_sq_;
+    double sum_returns_sq_ = 0.0;
+
+    double bar_high_    = 0.0;
+    double bar_low_     = 0.0;
+    size_t bar_ticks_   = 0;
+    double range_var_   = 0.0;
+    bool   range_ready_ = false;
+
+    double last_mid_    = 0.0;
+    bool   initialized_ = false;
+
+    VolatilityEstimates estimates_;
+};
+
+} // namespace mme
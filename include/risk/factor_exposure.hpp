@@ -0,0 +1,65 @@
+#pragma once
+
+#include "config/instrument_registry.hpp"
+
+#include <vector>
+
+namespace mme {
+
+// Aggregate exposure of the portfolio to a small set of risk factors
+// (market, sector, ...), from per-instrument loadings beta_i:
+//   E = sum_i beta_i * w_i,   w_i = net exposure in currency.
+// Kept incrementally: an exposure change of one instrument is an O(K)
+// update, K = number of factors, never a rescan of the portfolio.
+//
+// hedged_exposure_at(i) projects E back onto instrument i,
+//   (beta_i . E) / (beta_i . beta_i),
+// the exposure in instrument i alone that carries the same factor risk
+// along beta_i. Long AAPL and short MSFT with equal market betas projects
+// to zero for both; long both projects to the combined size for each.
+// Instruments without loadings project to their own exposure.
+//
+// Indexed by the registry's dense index. Not thread-safe.
+class FactorExposure {
+public:
+    FactorExposure(const InstrumentRegistry& registry, size_t num_factors);
+
+    // Loadings of one instrument, num_factors() values; fewer are zero-padded.
+    // Re-apportions the instrument's current exposure to the new loadings,
+    // so betas estimated online can be swapped in at any time. O(K).
+    void set_loadings_at(InstrumentIndex index, const std::vector<double>& loadings);
+    void set_loadings(InstrumentId id, const std::vector<double>& loadings) {
+        set_loadings_at(registry_.index(id), loadings);
+    }
+
+    // Net exposure (position * mark, signed currency) of one instrument. O(K).
+    void set_exposure_at(InstrumentIndex index, double exposure);
+
+    // Factor-equivalent exposure of instrument i in currency. O(K).
+    double hedged_exposure_at(InstrumentIndex index) const;
+
+    double factor(size_t k) const { return factors_[k]; }
+    double loading(InstrumentIndex index, size_t k) const { return beta_[index * k_ + k]; }
+    bool   has_loadings_at(InstrumentIndex index) const {
+        return index < norm_.size() && norm_[index] > 0.0;
+    }
+    double exposure_at(InstrumentIndex index) const { return exposure_[index]; }
+
+    // Rebuilds E by summing every instrument's exposure afresh; the
+    // incremental updates accumulate floating-point error. O(n K).
+    void resync();
+
+    size_t num_factors() const { return k_; }
+    size_t size()        const { return exposure_.size(); }
+    const InstrumentRegistry& registry() const { return registry_; }
+
+private:
+    InstrumentRegistry  registry_;
+    size_t              k_;
+    std::vector<double> beta_;       // n x K, row-major
+    std::vector<double> norm_;       // beta_i . beta_i, 0 = no loadings
+    std::vector<double> exposure_;   // w
+    std::vector<double> factors_;    // E
+};
+
+} // namespace mme
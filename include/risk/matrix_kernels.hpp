@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mme {
+
+// Dense double-precision kernels behind PortfolioVarEngine. Rows are
+// contiguous with a caller-chosen stride; no alignment is required.
+enum class MatrixKernel : uint8_t { Scalar, Avx2, Avx512 };
+
+// AVX-512 if the CPU has it, else AVX2, else scalar. PortfolioVarEngine
+// calls this once at construction and keeps the result.
+MatrixKernel best_matrix_kernel();
+
+// The vector kernels keep 4 or 8 partial sums per row and add them up at
+// the end, so dot and gemv differ from the scalar loop in the last bits.
+// An explicit kernel the CPU cannot run is served by the scalar loop.
+
+// sum x[i] * y[i]
+double dot(const double* x, const double* y, size_t n, MatrixKernel kernel);
+
+// y[i] += a * x[i]
+void axpy(double a, const double* x, double* y, size_t n, MatrixKernel kernel);
+
+// y = A x for an n x n matrix with row stride `stride`. Rows are taken four
+// at a time so each load of x feeds four accumulators.
+void gemv(const double* a, size_t stride, size_t n, const double* x, double* y,
+          MatrixKernel kernel);
+
+} // namespace mme
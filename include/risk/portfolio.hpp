@@ -2,8 +2,7 @@
 
 #include "config/instrument_config.hpp"
 
-#include <unordered_map>
-#include <cmath>
+#include <vector>
 
 namespace mme {
 
@@ -13,34 +12,19 @@ struct InstrumentPosition {
     double       avg_price      = 0.0;   // volume-weighted
     double       realized_pnl   = 0.0;
     double       unrealized_pnl = 0.0;
+    double       mark_price     = 0.0;   // last mid seen by RiskManager::on_mark, 0 = none
+    double       net_exposure   = 0.0;   // quantity * (mark_price, or avg_price if unmarked)
+    double       gross_notional = 0.0;   // |quantity| * the same price
 };
 
+// Totals are maintained incrementally by RiskManager: each fill or mark
+// adjusts them by the one position's change.
 struct PortfolioState {
-    std::unordered_map<InstrumentId, InstrumentPosition> positions;
+    std::vector<InstrumentPosition> positions;   // by InstrumentIndex
     double total_realized_pnl   = 0.0;
     double total_unrealized_pnl = 0.0;
-
-    // sum(position * mid)
-    double net_exposure(const std::unordered_map<InstrumentId, double>& mid_prices) const {
-        double exposure = 0.0;
-        for (const auto& [id, pos] : positions) {
-            auto it = mid_prices.find(id);
-            double mid = (it != mid_prices.end()) ? it->second : pos.avg_price;
-            exposure += pos.quantity * mid;
-        }
-        return exposure;
-    }
-
-    // sum(|position| * mid)
-    double gross_notional(const std::unordered_map<InstrumentId, double>& mid_prices) const {
-        double notional = 0.0;
-        for (const auto& [id, pos] : positions) {
-            auto it = mid_prices.find(id);
-            double mid = (it != mid_prices.end()) ? it->second : pos.avg_price;
-            notional += std::abs(pos.quantity) * mid;
-        }
-        return notional;
-    }
+    double total_net_exposure   = 0.0;   // sum(position * mark)
+    double total_gross_notional = 0.0;   // sum(|position| * mark)
 };
 
 } // namespace mme
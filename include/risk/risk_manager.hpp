@@ -1,35 +1,164 @@
 #pragma once
 
+#include "config/instrument_registry.hpp"
+#include "risk/factor_exposure.hpp"
 #include "risk/portfolio.hpp"
+#include "risk/portfolio_var.hpp"
 #include "strategy/market_making_params.hpp"
+#include "strategy/param_store.hpp"
+#include "util/clock.hpp"
 
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace mme {
 
+// Portfolio-wide pre-trade limits, checked against the worst case where
+// every open order fills. 0 disables a limit.
+struct PortfolioLimits {
+    double max_gross_notional = 0.0;   // sum |position| * mark plus all open order notional
+    double max_net_exposure   = 0.0;   // |sum position * mark| with one side's open orders filled
+    double max_var            = 0.0;   // parametric portfolio VaR; needs enable_portfolio_var
+};
+
+// Outcome of a pre-trade check; the first failing limit is reported.
+enum class RiskCheck : uint8_t {
+    Ok,
+    NotConfigured,
+    PositionLimit,   // max_position, counting open orders on the same side
+    GrossNotional,
+    NetExposure,
+    PortfolioVar,    // the order would lift VaR above max_var
+    OrderRate,       // max_order_rate for the instrument
+};
+
+// Resting orders of one instrument as the controller last reported them.
+// Integer totals so adding and removing the same order always cancels.
+struct OpenOrders {
+    QtyLots   buy_lots       = 0;
+    QtyLots   sell_lots      = 0;
+    int64_t   buy_lot_ticks  = 0;   // sum lots * price ticks
+    int64_t   sell_lot_ticks = 0;
+    Timestamp rate_tat       = 0;   // order-rate limiter's theoretical arrival time
+};
+
+// Per-instrument state lives in arrays indexed by the registry's dense
+// index; the InstrumentId overloads resolve the index first. Without a
+// registry, instruments are indexed by InstrumentRegistry::from_keys(params).
+// Limits are read from a ParamStore: the map constructors own a private one,
+// a shared one lets hot reloads take effect on the next check.
 class RiskManager {
 public:
-    explicit RiskManager(std::unordered_map<InstrumentId, MarketMakingParams> params);
+    explicit RiskManager(const std::unordered_map<InstrumentId, MarketMakingParams>& params);
+    RiskManager(const InstrumentRegistry& registry,
+                const std::unordered_map<InstrumentId, MarketMakingParams>& params);
+    explicit RiskManager(std::shared_ptr<const ParamStore> store);
 
     // Update position on fill. qty is signed: positive = buy, negative = sell.
+    // Fills in instruments outside the registry are tracked (and can never
+    // be quoted).
     void on_fill(InstrumentId id, double price, double qty);
+    void on_fill_at(InstrumentIndex index, double price, double qty);
 
     // Check if quoting is allowed given current position and proposed sizes.
-    bool can_quote(InstrumentId id, double bid_size, double ask_size) const;
+    bool can_quote(InstrumentId id, double bid_size, double ask_size) const {
+        return can_quote_at(registry_.index(id), bid_size, ask_size);
+    }
+    bool can_quote_at(InstrumentIndex index, double bid_size, double ask_size) const;
+
+    // Check if adding delta_qty would stay within limits, assuming every
+    // open order on the same side fills too.
+    bool within_limits(InstrumentId id, double delta_qty) const {
+        return within_limits_at(registry_.index(id), delta_qty);
+    }
+    bool within_limits_at(InstrumentIndex index, double delta_qty) const;
+
+    // Pre-trade check for one order of `lots` (signed: > 0 buys) at `price`
+    // ticks, optionally replacing a resting order on the same side
+    // (amend or cancel + new). Covers the worst-case position and the
+    // portfolio limits with all open orders filled, then the instrument's
+    // order rate. An order that does not grow what a limit measures always
+    // passes it, so a breach never blocks unwinding. O(1) and
+    // allocation-free.
+    RiskCheck check_order_at(InstrumentIndex index, PriceTicks price, QtyLots lots,
+                             Timestamp now, PriceTicks replaced_price = 0,
+                             QtyLots replaced_lots = 0) const;
+
+    // Open-order bookkeeping: call on_order_open_at when a new or amended
+    // order is sent (this also spends order-rate budget) and
+    // on_order_closed_at when it is cancelled, rejected or filled. An amend
+    // is a close of the old order plus an open of the new one.
+    void on_order_open_at(InstrumentIndex index, PriceTicks price, QtyLots lots, Timestamp now);
+    void on_order_closed_at(InstrumentIndex index, PriceTicks price, QtyLots lots);
 
-    // Check if adding delta_qty would stay within limits.
-    bool within_limits(InstrumentId id, double delta_qty) const;
+    void set_portfolio_limits(const PortfolioLimits& limits) { limits_ = limits; }
+    const PortfolioLimits& portfolio_limits() const { return limits_; }
 
-    // Update unrealized P&L given current mid prices.
+    // Tracks parametric portfolio VaR from the marks and exposures this
+    // risk manager sees; check_order_at then enforces limits.max_var.
+    void enable_portfolio_var(const VarConfig& config, const Clock* clock = nullptr);
+    const PortfolioVarEngine* portfolio_var() const { return var_.get(); }
+
+    // Tracks the portfolio's aggregate exposure to `num_factors` risk
+    // factors; set each instrument's loadings on the returned object. Fills
+    // and marks keep it current in O(factors), and a QuoteEngine pointed at
+    // it skews on the factor exposure (see factor_skew_weight).
+    FactorExposure& enable_factor_exposure(size_t num_factors);
+    const FactorExposure* factor_exposure() const { return factors_.get(); }
+
+    const OpenOrders& open_orders_at(InstrumentIndex index) const {
+        return index < open_.size() ? open_[index] : kNoOpenOrders;
+    }
+    // Notional of all open orders on each side, across the portfolio
+    double open_buy_notional()  const { return open_buy_notional_; }
+    double open_sell_notional() const { return open_sell_notional_; }
+
+    // Marks one instrument at `mid` (ignored if <= 0) and refreshes its
+    // unrealized P&L, net exposure and gross notional together with the
+    // portfolio totals. O(1), so call it only for the instrument whose mid
+    // moved. Fills refresh the same figures at the last mark.
+    void on_mark(InstrumentId id, double mid);
+    void on_mark_at(InstrumentIndex index, double mid);
+
+    // on_mark for every entry of `mid_prices`.
     void update_unrealized(const std::unordered_map<InstrumentId, double>& mid_prices);
 
+    // Recomputes the totals from the positions and open orders, discarding rounding drift
+    // accumulated by incremental updates. O(n); not needed per tick (ShardedEngine
+    // runs it every resync_every ticks and on stop).
+    void resync_totals();
+
     const PortfolioState& portfolio() const { return portfolio_; }
     const InstrumentPosition& position(InstrumentId id) const;
+    const InstrumentPosition& position_at(InstrumentIndex index) const {
+        return index < portfolio_.positions.size() ? portfolio_.positions[index] : kEmptyPosition;
+    }
+
+    const InstrumentRegistry& registry() const { return registry_; }
 
 private:
-    PortfolioState portfolio_;
-    std::unordered_map<InstrumentId, MarketMakingParams> params_;
+    // Re-derives the position's mark-dependent fields and moves the
+    // portfolio totals by the difference
+    void refresh_position(InstrumentPosition& pos);
+    void add_open(InstrumentIndex index, PriceTicks price, QtyLots lots, int sign);
+
+    // Instruments added by on_fill are past the end of every ParamSet
+    const MarketMakingParams* params_at(InstrumentIndex index) const {
+        return store_->current().at(index);
+    }
+
+    std::shared_ptr<const ParamStore> store_;
+    InstrumentRegistry              registry_;
+    PortfolioState                  portfolio_;
+    std::vector<OpenOrders>         open_;          // by InstrumentIndex
+    double                          open_buy_notional_  = 0.0;
+    double                          open_sell_notional_ = 0.0;
+    PortfolioLimits                 limits_;
+    std::unique_ptr<PortfolioVarEngine> var_;
+    std::unique_ptr<FactorExposure>     factors_;
     static const InstrumentPosition kEmptyPosition;
+    static const OpenOrders         kNoOpenOrders;
 };
 
 } // namespace mme
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "config/instrument_registry.hpp"
+#include "risk/risk_manager.hpp"
+#include "runtime/spsc_queue.hpp"
+#include "strategy/market_making_params.hpp"
+#include "util/fixed_point.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+namespace mme {
+
+// Notional is kept in integer units of this many currency units, so a
+// reservation and its release always cancel exactly.
+inline constexpr double kLedgerNotionalUnit = 1e-6;
+
+// Capacity held for one resting order. Owned by whoever placed the order
+// and handed back to release() or commit(); partial commits shrink it.
+struct LedgerReservation {
+    InstrumentIndex index    = kNoInstrument;
+    QtyLots         lots     = 0;   // signed remaining size, > 0 buys
+    int64_t         notional = 0;   // remaining notional units
+
+    explicit operator bool() const { return lots != 0; }
+};
+
+// Rare events only, so counting them does not add shared writes to the
+// uncontended path.
+struct LedgerStats {
+    uint64_t cas_retries     = 0;   // compare-exchange attempts lost to another thread
+    uint64_t rollbacks       = 0;   // partial reservations undone after a later limit failed
+    uint64_t position_limit  = 0;   // rejects by reason
+    uint64_t gross_notional  = 0;
+    uint64_t net_exposure    = 0;
+};
+
+// Firm-wide risk state shared by every controller thread. Each instrument
+// has its own cache line of atomics (position, mark, open lots per side);
+// the portfolio totals sit on separate lines. Reservations are lock-free:
+// each limit is claimed with a compare-exchange loop that fails without
+// writing when the limit would be breached, and a later failing limit
+// undoes the earlier claims. A concurrent reader can therefore only see
+// usage that is too high, never too low, so the limits hold under any
+// interleaving.
+//
+// Positions are valued at the instrument's last mark (the fill price until
+// one arrives) and open orders at their limit price, as in RiskManager.
+// on_mark_at and commit for an instrument must come from one thread at a
+// time, normally the thread that owns its market data; reserve and release
+// may come from any thread.
+class SharedRiskLedger {
+public:
+    SharedRiskLedger(const InstrumentRegistry& registry,
+                     const std::unordered_map<InstrumentId, MarketMakingParams>& params,
+                     const PortfolioLimits& limits);
+
+    SharedRiskLedger(const SharedRiskLedger&) = delete;
+    SharedRiskLedger& operator=(const SharedRiskLedger&) = delete;
+
+    // Claims capacity for an order of `lots` (signed, > 0 buys) at `price`
+    // ticks: the worst-case position with every open order on that side
+    // filled must stay within max_position, and the portfolio gross and
+    // directional net limits must hold. On success `*out` holds the claim.
+    RiskCheck reserve(InstrumentIndex index, PriceTicks price, QtyLots lots,
+                      LedgerReservation* out);
+    // Returns the remaining capacity of a cancelled or rejected order.
+    void release(LedgerReservation& reservation);
+    // Moves `lots` (unsigned, capped at what remains) of the reservation
+    // into the position at `fill_price` ticks.
+    void commit(LedgerReservation& reservation, QtyLots lots, PriceTicks fill_price);
+
+    // Fill with no reservation behind it (signed lots).
+    void on_fill_at(InstrumentIndex index, PriceTicks price, QtyLots lots);
+    // Revalues the instrument's position at `mid` ticks (ignored if <= 0).
+    void on_mark_at(InstrumentIndex index, PriceTicks mid);
+    void on_mark(InstrumentId id, double mid);
+
+    QtyLots position_lots(InstrumentIndex index) const {
+        return slots_[index].position.load(std::memory_order_relaxed);
+    }
+    QtyLots open_buy_lots(InstrumentIndex index) const {
+        return slots_[index].open_buy.load(std::memory_order_relaxed);
+    }
+    QtyLots open_sell_lots(InstrumentIndex index) const {
+        return slots_[index].open_sell.load(std::memory_order_relaxed);
+    }
+
+    // Worst-case totals in currency: gross counts every open order, the
+    // long / short figures net exposure with all buys / sells filled.
+    double gross_notional() const { return to_currency(totals_.gross.load(std::memory_order_relaxed)); }
+    double long_exposure()  const { return to_currency(totals_.longs.load(std::memory_order_relaxed)); }
+    double short_exposure() const { return to_currency(totals_.shorts.load(std::memory_order_relaxed)); }
+
+    const PortfolioLimits&    limits()   const { return limits_; }
+    const InstrumentRegistry& registry() const { return registry_; }
+    LedgerStats               stats()    const;
+
+private:
+    struct alignas(kCacheLineSize) Slot {
+        std::atomic<QtyLots>    position{0};
+        std::atomic<QtyLots>    open_buy{0};
+        std::atomic<QtyLots>    open_sell{0};
+        std::atomic<PriceTicks> mark{0};
+        // Written only by the owning thread: what this position currently
+        // contributes to the totals
+        int64_t gross_units = 0;
+        int64_t net_units   = 0;
+        QtyLots max_lots    = 0;
+        double  tick_size   = 0.0;
+        double  unit_value  = 0.0;   // currency per lot-tick
+        bool    configured  = false;
+    };
+
+    // One line per total so threads claiming different limits do not
+    // share a line
+    struct Totals {
+        alignas(kCacheLineSize) std::atomic<int64_t> gross{0};
+        alignas(kCacheLineSize) std::atomic<int64_t> longs{0};    // net + open buys
+        alignas(kCacheLineSize) std::atomic<int64_t> shorts{0};   // net - open sells
+    };
+
+    struct alignas(kCacheLineSize) Counters {
+        std::atomic<uint64_t> cas_retries{0};
+        std::atomic<uint64_t> rollbacks{0};
+        std::atomic<uint64_t> position_limit{0};
+        std::atomic<uint64_t> gross_notional{0};
+        std::atomic<uint64_t> net_exposure{0};
+    };
+
+    // Adds `delta` to `value` unless that moves it past +max (delta > 0)
+    // or -max (delta < 0); max 0 = unbounded.
+    bool claim(std::atomic<int64_t>& value, int64_t delta, int64_t max);
+    void revalue(Slot& slot, PriceTicks price);
+
+    int64_t to_units(const Slot& slot, int64_t lot_ticks) const;
+    static double to_currency(int64_t units) {
+        return static_cast<double>(units) * kLedgerNotionalUnit;
+    }
+
+    InstrumentRegistry       registry_;
+    PortfolioLimits          limits_;
+    int64_t                  max_gross_units_ = 0;
+    int64_t                  max_net_units_   = 0;
+    std::unique_ptr<Slot[]>  slots_;
+    Totals                   totals_;
+    Counters                 counters_;
+};
+
+} // namespace mme
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace mme {
+
+struct LatencySummary {
+    uint64_t count   = 0;
+    uint64_t min_ns  = 0;
+    uint64_t p50_ns  = 0;
+    uint64_t p99_ns  = 0;
+    uint64_t max_ns  = 0;
+    double   mean_ns = 0.0;
+};
+
+// Single-writer latency sample store. Storage is reserved up front so
+// record() never allocates; samples past `max_samples` still count towards
+// min/max/mean but are left out of the percentiles.
+class LatencyRecorder {
+public:
+    explicit LatencyRecorder(size_t max_samples = 1 << 20) : max_samples_(max_samples) {
+        samples_.reserve(max_samples);
+    }
+
+    void record(uint64_t ns) {
+        ++count_;
+        sum_ += static_cast<double>(ns);
+        min_ = std::min(min_, ns);
+        max_ = std::max(max_, ns);
+        if (samples_.size() < max_samples_) samples_.push_back(ns);
+    }
+
+    void clear() {
+        samples_.clear();
+        count_ = 0;
+        sum_ = 0.0;
+        min_ = std::numeric_limits<uint64_t>::max();
+        max_ = 0;
+    }
+
+    LatencySummary summary() const {
+        LatencySummary s;
+        if (count_ == 0) return s;
+        s.count = count_;
+        s.min_ns = min_;
+        s.max_ns = max_;
+        s.mean_ns = sum_ / static_cast<double>(count_);
+        if (!samples_.empty()) {
+            std::vector<uint64_t> sorted = samples_;
+            std::sort(sorted.begin(), sorted.end());
+            s.p50_ns = sorted[(sorted.size() - 1) / 2];
+            s.p99_ns = sorted[(sorted.size() - 1) * 99 / 100];
+        }
+        return s;
+    }
+
+private:
+    size_t                max_samples_;
+    std::vector<uint64_t> samples_;
+    uint64_t              count_ = 0;
+    double                sum_   = 0.0;
+    uint64_t              min_   = std::numeric_limits<uint64_t>::max();
+    uint64_t              max_   = 0;
+};
+
+} // namespace mme
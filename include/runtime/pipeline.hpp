@@ -0,0 +1,182 @@
+#pragma once
+
+#include "execution/execution_gateway.hpp"
+#include "market/market_view.hpp"
+#include "runtime/latency_recorder.hpp"
+#include "runtime/spsc_queue.hpp"
+#include "runtime/wait_strategy.hpp"
+#include "strategy/market_maker_controller.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace mme {
+
+struct PipelineConfig {
+    WaitStrategy wait           = WaitStrategy::Yield;
+    int          feed_cpu       = -1;     // -1 = not pinned
+    int          strategy_cpu   = -1;
+    int          gateway_cpu    = -1;
+    size_t       queue_capacity = 4096;   // per queue, rounded up to a power of two
+    // Strategy stage drains everything queued and runs it through the
+    // controller's conflation path instead of requoting per snapshot
+    bool         conflate       = false;
+    size_t       max_latency_samples = 1 << 20;
+};
+
+struct PipelineStats {
+    uint64_t       ticks_in        = 0;   // snapshots produced by the feed
+    uint64_t       ticks_handled   = 0;   // snapshots seen by the strategy
+    uint64_t       commands        = 0;   // order actions executed by the gateway stage
+    uint64_t       fills           = 0;
+    uint64_t       feed_stalls     = 0;   // feed waited on a full market data queue
+    uint64_t       strategy_stalls = 0;   // strategy waited on a full command queue
+    LatencySummary tick_to_order;         // feed receive -> gateway call returned
+};
+
+// AmendOrder carries a double-only amend_order(id, price, size): its
+// action.order has price / size but no grid values.
+enum class GatewayCommandType : uint8_t {
+    Action, AmendOrder, CancelAll, CancelInstrument, CancelVenue
+};
+
+struct GatewayCommand {
+    GatewayCommandType type       = GatewayCommandType::Action;
+    OrderAction        action;
+    InstrumentId       instrument = 0;
+    VenueId            venue      = 0;
+    uint64_t           tick_ns    = 0;    // receive time of the triggering tick
+};
+
+class Pipeline;
+
+// Strategy-side stand-in for the real gateway. Order ids are assigned
+// locally so the controller never waits on the gateway thread; amends of
+// ids it has issued and mass cancels are reported as accepted and their
+// real outcome arrives as fills (or their absence).
+class QueuedExecutionGateway final : public IExecutionGateway {
+public:
+    explicit QueuedExecutionGateway(Pipeline& pipeline) : pipeline_(pipeline) {}
+
+    uint64_t send_limit_order(const LiveOrder& order) override;
+    void     cancel_order(uint64_t order_id) override;
+    bool     amend_order(uint64_t order_id, double new_price, double new_size) override;
+    bool     amend_limit_order(const LiveOrder& order) override;
+    void     send_batch(std::span<OrderAction> actions) override;
+
+    size_t cancel_all() override;
+    size_t cancel_instrument(InstrumentId instrument) override;
+    size_t cancel_venue(VenueId venue) override;
+
+    void set_tick_ns(uint64_t ns) { tick_ns_ = ns; }
+
+private:
+    void push(GatewayCommand cmd);
+
+    Pipeline& pipeline_;
+    uint64_t  next_order_id_ = 1;
+    uint64_t  tick_ns_       = 0;
+};
+
+// Three-stage runtime:
+//   feed thread      -> produces snapshots (parsing, normalisation)
+//   strategy thread  -> aggregator, risk, quoting via the controller
+//   gateway thread   -> order encoding / sending on the downstream gateway
+// Stages are joined by SPSC queues; fills raised on the gateway thread flow
+// back to the strategy thread through their own queue, so all controller
+// and risk state stays single-threaded.
+class Pipeline {
+public:
+    using FeedSource     = std::function<bool(VenueBookSnapshot&)>;   // false = exhausted
+    using MarketDataHook = std::function<void(const VenueBookSnapshot&)>;
+    using FillHook       = std::function<void(const Fill&)>;
+
+    // `clock` stamps ticks and measures tick-to-order latency; use the same
+    // clock for the controller. default_clock() if null.
+    Pipeline(const PipelineConfig& config, IExecutionGateway& downstream,
+             const Clock* clock = nullptr);
+
+    // Hand this to the controller in place of the downstream gateway.
+    IExecutionGateway& gateway() { return proxy_; }
+
+    // Gateway thread: called with each snapshot after the orders queued
+    // before it have been sent (e.g. SimExecutionGateway::check_fills).
+    void set_gateway_market_data_hook(MarketDataHook hook) { gateway_md_hook_ = std::move(hook); }
+
+    // Strategy thread: called after each snapshot / fill was handled.
+    void set_after_market_data(MarketDataHook hook) { after_md_ = std::move(hook); }
+    void set_after_fill(FillHook hook) { after_fill_ = std::move(hook); }
+
+    // Fill from the downstream gateway (gateway thread). Its order id is the
+    // downstream one; the controller sees the locally assigned id.
+    void post_fill(const Fill& fill);
+
+    // Runs all stages until `feed` is exhausted and every queue has drained.
+    // Blocks the calling thread; fills still queued when the stages stop are
+    // applied on the calling thread before returning.
+    void run(MarketMakerController& controller, FeedSource feed);
+
+    const PipelineStats&  stats()  const { return stats_; }
+    // Orders still tracked in the id map: the open downstream orders.
+    // Gateway thread, or once run() has returned.
+    size_t tracked_orders() const { return id_map_.size(); }
+    const PipelineConfig& config() const { return config_; }
+
+private:
+    friend class QueuedExecutionGateway;
+
+    struct TrackedOrder {
+        uint64_t     downstream_id = 0;
+        InstrumentId instrument    = 0;
+        VenueId      venue         = 0;
+    };
+
+    struct MarketDataEvent {
+        VenueBookSnapshot snapshot;
+        uint64_t          recv_ns = 0;
+    };
+
+    void feed_loop(FeedSource& feed);
+    void strategy_loop(MarketMakerController& controller);
+    void gateway_loop();
+
+    void execute(const GatewayCommand& cmd);
+    // Drops the id map entries of every order matching `pred`
+    template <typename Pred> void forget_orders(Pred pred);
+    void push_command(const GatewayCommand& cmd);
+    void handle_fill(MarketMakerController& controller, const Fill& fill);
+    void wake(WakeSignal& signal) { signal.notify(config_.wait); }
+
+    PipelineConfig     config_;
+    IExecutionGateway& downstream_;
+    const Clock*       clock_;
+    QueuedExecutionGateway proxy_;
+
+    SpscQueue<MarketDataEvent>   md_queue_;        // feed -> strategy
+    SpscQueue<GatewayCommand>    command_queue_;   // strategy -> gateway
+    SpscQueue<VenueBookSnapshot> gateway_md_queue_; // strategy -> gateway (hook only)
+    SpscQueue<Fill>              fill_queue_;      // gateway -> strategy
+    std::vector<Fill>            fill_overflow_;   // gateway thread only
+
+    WakeSignal strategy_wake_;
+    WakeSignal gateway_wake_;
+    alignas(kCacheLineSize) std::atomic<bool> feed_done_{false};
+    alignas(kCacheLineSize) std::atomic<bool> strategy_done_{false};
+
+    // Downstream order per locally assigned id, and back (gateway thread
+    // only). Entries go with the order: cancelled, rejected or fully filled.
+    std::unordered_map<uint64_t, TrackedOrder> id_map_;
+    std::unordered_map<uint64_t, uint64_t> local_ids_;
+
+    MarketDataHook gateway_md_hook_;
+    MarketDataHook after_md_;
+    FillHook       after_fill_;
+
+    LatencyRecorder tick_to_order_;
+    PipelineStats   stats_;
+};
+
+} // namespace mme
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "execution/execution_gateway.hpp"
+#include "execution/sim_execution_gateway.hpp"
+#include "execution/venue_router.hpp"
+#include "market/market_data_aggregator.hpp"
+#include "risk/risk_manager.hpp"
+#include "risk/shared_risk_ledger.hpp"
+#include "runtime/spsc_queue.hpp"
+#include "runtime/wait_strategy.hpp"
+#include "strategy/market_maker_controller.hpp"
+#include "strategy/quote_engine.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace mme {
+
+struct ShardedEngineConfig {
+    size_t           num_shards     = 1;
+    WaitStrategy     wait           = WaitStrategy::Yield;
+    std::vector<int> shard_cpus;            // cpu per shard; missing / -1 = unpinned
+    size_t           queue_capacity = 4096; // per shard
+    // Ticks between publishes of a shard's unrealized P&L and exposure. The
+    // risk manager keeps them current on every tick; this only bounds how
+    // stale totals() can be (realized P&L is republished on every fill)
+    size_t           publish_every  = 64;
+    // Ticks between RiskManager::resync_totals on each shard, which clears
+    // the rounding the incremental total updates pick up over a long
+    // session; a shard also resyncs once when it stops. 0 = only on stop
+    size_t           resync_every   = 65536;
+    // Firm-wide limits enforced across all shards through one
+    // SharedRiskLedger; when unset, each shard checks only its own book
+    bool             shared_ledger  = false;
+    PortfolioLimits  firm_limits;
+};
+
+// Portfolio-wide totals summed over the shards' published aggregates.
+struct PortfolioTotals {
+    double   realized_pnl   = 0.0;
+    double   unrealized_pnl = 0.0;
+    double   net_exposure   = 0.0;
+    double   gross_notional = 0.0;
+    uint64_t ticks          = 0;
+    uint64_t fills          = 0;
+};
+
+// Instruments are hash-partitioned across N worker threads. Each shard owns
+// its own aggregator, quote engine, risk manager, controller and gateway, so
+// the tick path never shares mutable state. A single dispatcher thread
+// routes snapshots to shards through SPSC queues. Each shard publishes its
+// risk totals to its own cache line; totals() sums them without locks.
+// With shared_ledger set, every shard's controller also reserves each order
+// in a SharedRiskLedger, so firm-wide limits hold across shards.
+class ShardedEngine {
+public:
+    // Creates the gateway for one shard. `on_fill` must be called on that
+    // shard's thread (e.g. from SimExecutionGateway::check_fills in a
+    // market data hook). A simulated gateway needs the instruments' tick
+    // sizes (set_tick_sizes) before it can match fills.
+    using GatewayFactory = std::function<std::unique_ptr<IExecutionGateway>(
+        size_t shard, FillCallback on_fill)>;
+    // Runs on the shard thread after each snapshot was handled.
+    using ShardHook = std::function<void(size_t shard, IExecutionGateway& gw,
+                                         const VenueBookSnapshot& snapshot)>;
+
+    ShardedEngine(const ShardedEngineConfig& config,
+                  const std::unordered_map<InstrumentId, MarketMakingParams>& params,
+                  const std::vector<VenueConfig>& venues,
+                  GatewayFactory make_gateway);
+    ~ShardedEngine();
+
+    ShardedEngine(const ShardedEngine&) = delete;
+    ShardedEngine& operator=(const ShardedEngine&) = delete;
+
+    size_t num_shards() const { return shards_.size(); }
+    size_t shard_of(InstrumentId id) const;
+
+    void set_after_market_data(ShardHook hook) { after_md_ = std::move(hook); }
+
+    void start();
+    // Dispatcher thread only. Blocks (per the wait strategy) while the
+    // target shard's queue is full. `ts` is the event time in nanoseconds;
+    // each shard runs its components on a clock set to it.
+    void dispatch(const VenueBookSnapshot& snapshot, Timestamp ts);
+    // Lets every shard drain its queue, then joins the workers.
+    void stop();
+
+    // Safe to call from any thread while running.
+    PortfolioTotals totals() const;
+
+    // Direct access to a shard's components; only safe when stopped.
+    const RiskManager&          risk(size_t shard) const { return shards_[shard]->risk; }
+    const MarketDataAggregator& market_data(size_t shard) const { return shards_[shard]->md; }
+    // Null unless config.shared_ledger; safe to read from any thread.
+    const SharedRiskLedger*     ledger() const { return ledger_.get(); }
+
+private:
+    struct ShardEvent {
+        VenueBookSnapshot snapshot;
+        Timestamp         ts = 0;
+    };
+
+    // Single writer (the shard thread); summed by totals()
+    struct alignas(kCacheLineSize) ShardAggregates {
+        std::atomic<double>   realized_pnl{0.0};
+        std::atomic<double>   unrealized_pnl{0.0};
+        std::atomic<double>   net_exposure{0.0};
+        std::atomic<double>   gross_notional{0.0};
+        std::atomic<uint64_t> ticks{0};
+        std::atomic<uint64_t> fills{0};
+    };
+
+    struct Shard {
+        Shard(size_t index, const ShardedEngineConfig& config,
+              std::unordered_map<InstrumentId, MarketMakingParams> params,
+              const std::vector<VenueConfig>& venues,
+              const GatewayFactory& make_gateway);
+
+        size_t                                   index;
+        std::vector<InstrumentId>                instruments;
+        SimulatedClock                           clock;   // event time of the current tick
+        MarketDataAggregator                     md;
+        RiskManager                              risk;
+        QuoteEngine                              qe;
+        VenueRouter                              router;
+        std::unique_ptr<IExecutionGateway>       gw;
+        std::unique_ptr<MarketMakerController>   controller;
+        SpscQueue<ShardEvent>                    queue;
+        WakeSignal                               wake;
+        ShardAggregates                          published;
+        uint64_t                                 ticks = 0;
+        uint64_t                                 fills = 0;
+        std::thread                              thread;
+    };
+
+    void run_shard(Shard& shard);
+    void publish(Shard& shard);
+
+    ShardedEngineConfig                 config_;
+    std::unique_ptr<SharedRiskLedger>   ledger_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    ShardHook                           after_md_;
+    std::atomic<bool>                   stopping_{false};
+    bool                                running_ = false;
+};
+
+} // namespace mme
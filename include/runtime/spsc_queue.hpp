@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace mme {
+
+inline constexpr size_t kCacheLineSize = 64;
+
+// Bounded single-producer / single-consumer ring. The producer owns `tail_`
+// and the consumer owns `head_`; each sits on its own cache line together
+// with a cached copy of the other side's index, so in steady state neither
+// side reads the other's line except when it looks full / empty.
+// Capacity is rounded up to a power of two.
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity)
+        : capacity_(round_up(capacity)),
+          mask_(capacity_ - 1),
+          slots_(std::make_unique<T[]>(capacity_)) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer side. Returns false if the queue is full.
+    bool try_push(const T& value) {
+        size_t tail = prod_.tail.load(std::memory_order_relaxed);
+        if (tail - prod_.head_cache == capacity_) {
+            prod_.head_cache = cons_.head.load(std::memory_order_acquire);
+            if (tail - prod_.head_cache == capacity_) return false;
+        }
+        slots_[tail & mask_] = value;
+        prod_.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false if the queue is empty.
+    bool try_pop(T& out) {
+        size_t head = cons_.head.load(std::memory_order_relaxed);
+        if (head == cons_.tail_cache) {
+            cons_.tail_cache = prod_.tail.load(std::memory_order_acquire);
+            if (head == cons_.tail_cache) return false;
+        }
+        out = slots_[head & mask_];
+        cons_.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate when called concurrently with either side.
+    size_t size() const {
+        return prod_.tail.load(std::memory_order_acquire) -
+               cons_.head.load(std::memory_order_acquire);
+    }
+    bool   empty()    const { return size() == 0; }
+    size_t capacity() const { return capacity_; }
+
+private:
+    static size_t round_up(size_t n) {
+        size_t cap = 2;
+        while (cap < n) cap *= 2;
+        return cap;
+    }
+
+    struct alignas(kCacheLineSize) ProducerIndex {
+        std::atomic<size_t> tail{0};
+        size_t              head_cache = 0;
+    };
+
+    struct alignas(kCacheLineSize) ConsumerIndex {
+        std::atomic<size_t> head{0};
+        size_t              tail_cache = 0;
+    };
+
+    const size_t         capacity_;
+    const size_t         mask_;
+    std::unique_ptr<T[]> slots_;
+    ProducerIndex        prod_;
+    ConsumerIndex        cons_;
+};
+
+} // namespace mme
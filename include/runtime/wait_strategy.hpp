@@ -0,0 +1,56 @@
+#pragma once
+
+#include "runtime/spsc_queue.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace mme {
+
+// How an idle stage waits for input.
+//   BusyPoll: spin with a pause hint (lowest latency, burns the core)
+//   Yield:    spin with sched_yield between polls
+//   Blocking: sleep on an atomic wait until a producer signals
+enum class WaitStrategy : uint8_t { BusyPoll, Yield, Blocking };
+
+inline void cpu_relax() {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_ia32_pause();
+#endif
+}
+
+// Consumer-side wake-up counter for WaitStrategy::Blocking. The consumer
+// reads `epoch` before polling its queues and waits on that value, so a push
+// that lands between the poll and the wait is never missed.
+struct alignas(kCacheLineSize) WakeSignal {
+    std::atomic<uint32_t> epoch{0};
+
+    uint32_t observe() const { return epoch.load(std::memory_order_acquire); }
+
+    void idle(WaitStrategy wait, uint32_t seen) {
+        switch (wait) {
+            case WaitStrategy::BusyPoll: cpu_relax(); break;
+            case WaitStrategy::Yield:    std::this_thread::yield(); break;
+            case WaitStrategy::Blocking: epoch.wait(seen, std::memory_order_acquire); break;
+        }
+    }
+
+    void notify(WaitStrategy wait) {
+        if (wait != WaitStrategy::Blocking) return;
+        epoch.fetch_add(1, std::memory_order_release);
+        epoch.notify_one();
+    }
+};
+
+// Producer backoff while a queue is full. Blocking producers yield rather
+// than sleep: consumers never signal on pop.
+inline void backoff(WaitStrategy wait) {
+    if (wait == WaitStrategy::BusyPoll) {
+        cpu_relax();
+    } else {
+        std::this_thread::yield();
+    }
+}
+
+} // namespace mme
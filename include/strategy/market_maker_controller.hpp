@@ -2,47 +2,194 @@
 
 #include "market/market_data_aggregator.hpp"
 #include "risk/risk_manager.hpp"
+#include "risk/shared_risk_ledger.hpp"
 #include "strategy/quote_engine.hpp"
+#include "strategy/update_conflator.hpp"
 #include "execution/venue_router.hpp"
 #include "execution/execution_gateway.hpp"
 
+#include <optional>
 #include <vector>
 #include <unordered_map>
 
 namespace mme {
 
-class MarketMakerController {
+struct ControllerStats {
+    uint64_t requotes        = 0;   // quote computations that reached the diff stage
+    uint64_t throttled       = 0;   // requotes skipped by quote_refresh_ms
+    uint64_t sides_unchanged = 0;   // live orders left in place by the diff
+    uint64_t orders_sent     = 0;
+    uint64_t cancels_sent    = 0;
+    uint64_t amends_sent     = 0;
+    uint64_t batches_sent    = 0;   // gateway send_batch calls
+    uint64_t risk_rejects    = 0;   // sides not quoted by a position / notional check
+                                    // (local or shared ledger)
+    uint64_t rate_limited    = 0;   // changes held back by max_order_rate
+};
+
+// Templated on its collaborators so a build with concrete types (e.g.
+// BasicSimExecutionGateway<Sink>) is statically dispatched end to end.
+//   Gateway:     send_batch(std::span<OrderAction>), cancel_all(),
+//                cancel_instrument(InstrumentId)
+//   Router:      choose_venue(view, position)
+//   QuotePolicy: registry(), params_at(index),
+//                compute_quote_at(index, view, position, venue),
+//                add_to_batch / compute_batch / batch_quote (drain path)
+// MarketMakerController is the virtual-gateway instantiation. Throttling
+// and conflation read time from `clock` (default_clock() if null).
+//
+// Instruments are addressed by the quote policy's registry: each event
+// resolves its InstrumentId once and the aggregator, risk manager and quote
+// policy are then called with the dense index. The risk manager must be
+// built from the same registry (or params) as the quote policy; the
+// aggregator is aligned to it on construction. The constructor throws
+// std::invalid_argument if either indexes an instrument differently.
+//
+// Every order the controller sends, amends, cancels or sees filled is
+// reported to the risk manager's open-order book, so each side is checked
+// against the worst case with all resting orders filled before it is sent.
+// With a SharedRiskLedger attached, each new or amended order must also win
+// a reservation in it, so controllers on other threads draw on the same
+// firm-wide limits.
+template <typename Gateway, typename Router, typename QuotePolicy>
+class BasicMarketMakerController {
 public:
-    MarketMakerController(MarketDataAggregator& md,
-                          RiskManager& risk,
-                          QuoteEngine& qe,
-                          VenueRouter& router,
-                          IExecutionGateway& gw,
-                          std::vector<InstrumentId> instruments);
+    BasicMarketMakerController(MarketDataAggregator& md,
+                               RiskManager& risk,
+                               QuotePolicy& qe,
+                               Router& router,
+                               Gateway& gw,
+                               std::vector<InstrumentId> instruments,
+                               const Clock* clock = nullptr);
 
+    // Requotes only when the consolidated touch moved (or, with a
+    // microprice / weighted-mid fair price, any depth changed), a fill
+    // changed inventory, or a throttled update is still pending.
     void on_market_data(const VenueBookSnapshot& snapshot);
-    void on_fill(InstrumentId id, VenueId venue, double price, double qty);
+    // Matched to a side by order id. A partial fill releases only the filled
+    // lots and the rest keeps resting; a fill for an order no longer tracked
+    // (e.g. one cancelled in flight) only moves the position.
+    void on_fill(const Fill& fill);
+
+    // Conflated path: buffer updates, then drain_market_data() applies the
+    // latest snapshot per (instrument, venue) and requotes each touched
+    // instrument at most once, computing all quotes in one batch. Returns
+    // the number of instruments requoted.
+    void   enqueue_market_data(const VenueBookSnapshot& snapshot);
+    size_t drain_market_data();
+
+    void set_conflation(const ConflationConfig& config) { conflator_ = UpdateConflator(config); }
+    const ConflationStats& conflation_stats() const { return conflator_.stats(); }
 
-    // Set current timestamp (for simulation use)
-    void set_current_time(Timestamp ts) { current_time_ = ts; }
+    // Kill switch: mass-cancel through the gateway and forget the local
+    // quotes. Returns the gateway's cancel count.
+    size_t cancel_all_quotes();
+    size_t cancel_instrument_quotes(InstrumentId id);
+
+    // Optional; must outlive the controller. Instruments are matched to the
+    // ledger's registry by id. This thread must be the only one reporting
+    // fills and marks for its instruments to the ledger.
+    void set_shared_ledger(SharedRiskLedger* ledger);
+
+    const ControllerStats& stats() const { return stats_; }
 
 private:
+    // What we believe is resting on one side of the book
+    struct LiveQuote {
+        uint64_t   order_id = 0;   // 0 = nothing resting
+        VenueId    venue    = 0;
+        PriceTicks price    = 0;
+        QtyLots    size     = 0;
+        LedgerReservation reservation;   // held in the shared ledger, if any
+    };
+
     struct InstrumentState {
         InstrumentId id           = 0;
-        uint64_t     last_bid_order_id = 0;
-        uint64_t     last_ask_order_id = 0;
+        bool         active       = false;   // in the controller's instrument list
+        LiveQuote    bid;
+        LiveQuote    ask;
         Timestamp    last_quote_ts     = 0;
+        bool         quoted            = false;
+        bool         needs_requote     = false;   // fills, throttled updates, held sides
+        bool         book_moved        = false;   // within a drain cycle
+        bool         in_drain          = false;
+        InstrumentIndex ledger_index   = kNoInstrument;
     };
 
-    void try_requote(InstrumentId id);
+    // Where the result of a batched action is written back
+    struct PendingRef {
+        InstrumentIndex  index = 0;
+        InstrumentState* state = nullptr;
+        LiveQuote*       live  = nullptr;   // null for cancels
+    };
+
+    // A drained instrument's slot in quote_batch_
+    struct BatchLane {
+        InstrumentIndex index = 0;
+        VenueId         venue = 0;
+        size_t          lane  = 0;
+    };
+
+    void try_requote(InstrumentIndex index);
+    // `change` moved an input of the instrument's quote: the touch, or any
+    // depth when the fair price is not the plain mid
+    bool moves_quote(InstrumentIndex index, BookChange change) const;
+    // Throttle, market data and risk gates; the venue to quote on if they pass.
+    std::optional<VenueId> requote_venue(InstrumentIndex index, Timestamp now);
+    void apply_quote(InstrumentIndex index, const Quote& quote, Timestamp now);
+    RiskCheck check_side(InstrumentIndex index, OrderSide side, const LiveQuote& live,
+                         PriceTicks price, QtyLots size, Timestamp now) const;
+    // `allowed`: the side may rest at (price, size). `rate_held`: only the
+    // order-rate limit failed, so a resting order is kept while it is still
+    // close to the quote and not crossed, and pulled otherwise (cancels
+    // spend no rate budget). Returns false if the side wanted an order it
+    // could not place or keep, so the instrument is requoted again.
+    bool update_side(InstrumentIndex index, OrderSide side, LiveQuote& live,
+                     const MarketMakingParams& p, VenueId venue,
+                     PriceTicks price, QtyLots size, bool allowed, bool rate_held,
+                     Timestamp now);
+    // `price` is at or through the opposite consolidated touch
+    bool crosses_touch(InstrumentIndex index, OrderSide side, PriceTicks price,
+                       const PriceScale& scale) const;
+    // Drops a resting order from the local book, the risk manager's and
+    // the shared ledger's
+    void release_side(InstrumentIndex index, OrderSide side, LiveQuote& live);
+    // Claims ledger capacity for (price, lots), giving up `held` first;
+    // always true without a ledger
+    bool reserve_shared(InstrumentIndex index, PriceTicks price, QtyLots lots,
+                        LedgerReservation& held);
+    // Moves a fill into the ledger's position, out of the side's reservation
+    void commit_shared(InstrumentIndex index, LiveQuote& live, double price, double qty);
+
+    // Order actions are collected while processing one market data event
+    // (or one drain) and sent to the gateway as a single batch.
+    void queue_action(OrderActionType type, const LiveOrder& order,
+                      InstrumentIndex index, LiveQuote* live);
+    void flush_actions();
 
     MarketDataAggregator& md_;
     RiskManager&          risk_;
-    QuoteEngine&          qe_;
-    VenueRouter&          router_;
-    IExecutionGateway&    gw_;
-    std::unordered_map<InstrumentId, InstrumentState> state_;
-    Timestamp current_time_ = 0;
+    QuotePolicy&          qe_;
+    Router&               router_;
+    Gateway&              gw_;
+    InstrumentRegistry           registry_;
+    std::vector<InstrumentState> state_;   // by InstrumentIndex
+    UpdateConflator              conflator_;
+    std::vector<InstrumentIndex> drain_touched_;
+    QuoteBatch                   quote_batch_;
+    std::vector<BatchLane>       batch_lanes_;
+    std::vector<OrderAction>  batch_;
+    std::vector<PendingRef>   batch_refs_;
+    const Clock*              clock_;
+    SharedRiskLedger*         ledger_ = nullptr;
+    ControllerStats stats_;
 };
 
+using MarketMakerController =
+    BasicMarketMakerController<IExecutionGateway, VenueRouter, QuoteEngine>;
+
+extern template class BasicMarketMakerController<IExecutionGateway, VenueRouter, QuoteEngine>;
+
 } // namespace mme
+
+#include "strategy/market_maker_controller_impl.hpp"
@@ -0,0 +1,468 @@
+#pragma once
+
+// Member definitions for BasicMarketMakerController; included by
+// market_maker_controller.hpp.
+
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+
+namespace mme {
+
+template <typename Gateway, typename Router, typename QuotePolicy>
+BasicMarketMakerController<Gateway, Router, QuotePolicy>::BasicMarketMakerController(
+    MarketDataAggregator& md,
+    RiskManager& risk,
+    QuotePolicy& qe,
+    Router& router,
+    Gateway& gw,
+    std::vector<InstrumentId> instruments,
+    const Clock* clock)
+    : md_(md), risk_(risk), qe_(qe), router_(router), gw_(gw),
+      registry_(qe.registry()),
+      clock_(clock ? clock : &default_clock()) {
+    state_.resize(registry_.size());
+    for (InstrumentIndex i = 0; i < registry_.size(); ++i) state_[i].id = registry_.id(i);
+    for (auto id : instruments) {
+        InstrumentIndex i = registry_.index(id);
+        if (i != kNoInstrument) state_[i].active = true;
+    }
+
+    // Every *_at call below passes the quote policy's index straight
+    // through, so a misaligned collaborator would read another instrument's
+    // state.
+    if (!md_.add_instruments(registry_)) {
+        throw std::invalid_argument(
+            "market data aggregator indexed differently from the quote policy");
+    }
+    for (InstrumentIndex i = 0; i < registry_.size(); ++i) {
+        if (risk_.registry().index(registry_.id(i)) != i) {
+            throw std::invalid_argument(
+                "risk manager indexed differently from the quote policy");
+        }
+    }
+
+    drain_touched_.reserve(instruments.size());
+    quote_batch_.reserve(instruments.size());
+    batch_lanes_.reserve(instruments.size());
+    // Worst case per instrument: cancel + new on both sides
+    batch_.reserve(instruments.size() * 4);
+    batch_refs_.reserve(instruments.size() * 4);
+}
+
+template <typename Gateway, typename Router, typename QuotePolicy>
+void BasicMarketMakerController<Gateway, Router, QuotePolicy>::set_shared_ledger(
+    SharedRiskLedger* ledger) {
+    ledger_ = ledger;
+    for (auto& st : state_) {
+        st.ledger_index = ledger ? ledger->registry().index(st.id) : kNoInstrument;
+    }
+}
+
+template <typename Gateway, typename Router, typename QuotePolicy>
+void BasicMarketMakerController<Gateway, Router, QuotePolicy>::on_market_data(
+    const VenueBookSnapshot& snapshot) {
+    InstrumentIndex index = registry_.index(snapshot.instrument);
+    if (index == kNoInstrument) {
+        md_.on_book_update(snapshot);
+        return;
+    }
+
+    BookChange change = md_.on_book_update_at(index, snapshot);
+    auto& st = state_[index];
+    if (!st.active) return;
+    if (moves_quote(index, change) || st.needs_requote) {
+        try_requote(index);
+        flush_actions();
+    }
+}
+
+template <typename Gateway, typename Router, typename QuotePolicy>
+bool BasicMarketMakerController<Gateway, Router, QuotePolicy>::moves_quote(
+    InstrumentIndex index, BookChange change) const {
+    if (change == BookChange::TouchChanged) return true;
+    if (change != BookChange::BookChanged) return false;
+    // Microprice and weighted mid follow touch sizes and depth
+    const MarketMakingParams* p = qe_.params_at(index);
+    return p != nullptr && p->fair_price != FairPrice::Mid;
+}
+
+template <typename Gateway, typename Router, typename QuotePolicy>
+void BasicMarketMakerController<Gateway, Router, QuotePolicy>::enqueue_market_data(
+    const VenueBookSnapshot& snapshot) {
+    conflator_.push(snapshot, clock_->now());
+}
+
+template <typename Gateway, typename Router, typename QuotePolicy>
+size_t BasicMarketMakerController<Gateway, Router, QuotePolicy>::drain_market_data() {
+    if (!conflator_.ready(clock_->now())) return 0;
+
+    conflator_.drain([this](const VenueBookSnapshot& snap) {
+        InstrumentIndex index = registry_.index(snap.instrument);
+        if (index == kNoInstrument) {
+            md_.on_book_update(snap);
+            return;
+        }
+        BookChange change = md_.on_book_update_at(index, snap);
+        auto& st = state_[index];
+        if (!st.active) return;
+        st.book_moved |= moves_quote(index, change);
+        if (!st.in_drain) {
+            st.in_drain = true;
+            drain_touched_.push_back(index);
+        }
+    });
+
+    // Quotes for every instrument that passes the gates are computed in one
+    // batch, then diffed in drain order
+    const Timestamp now = clock_->now();
+    size_t requoted = 0;
+    quote_batch_.clear();
+    batch_lanes_.clear();
+    for (InstrumentIndex index : drain_touched_) {
+        auto& st = state_[index];
+        if (st.book_moved || st.needs_requote) {
+            if (auto venue = requote_venue(index, now)) {
+                size_t lane = qe_.add_to_batch(quote_batch_, index, *md_.find_view_at(index),
+                                               risk_.position_at(index));
+                batch_lanes_.push_back(BatchLane{index, *venue, lane});
+                ++requoted;
+            }
+        }
+        st.book_moved = false;
+        st.in_drain = false;
+    }
+    drain_touched_.clear();
+
+    if (!batch_lanes_.empty()) {
+        qe_.compute_batch(quote_batch_);
+        for (const auto& b : batch_lanes_) {
+            apply_quote(b.index, qe_.batch_quote(quote_batch_, b.lane, b.index, b.venue), now);
+        }
+    }
+    flush_actions();
+    return requoted;
+}
+
+template <typename Gateway, typename Router, typename QuotePolicy>
+size_t BasicMarketMakerController<Gateway, Router, QuotePolicy>::cancel_all_quotes() {
+    flush_actions();
+    size_t n = gw_.cancel_all();
+    for (InstrumentIndex i = 0; i < state_.size(); ++i) {
+        auto& st = state_[i];
+        release_side(i, OrderSide::Buy, st.bid);
+        release_side(i, OrderSide::Sell, st.ask);
+        st.needs_requote = true;
+    }
+    return n;
+}
+
+template <typename Gateway, typename Router, typename QuotePolicy>
+size_t BasicMarketMakerController<Gateway, Router, QuotePolicy>::cancel_instrument_quotes(
+    InstrumentId id) {
+    flush_actions();
+    size_t n = gw_.cancel_instrument(id);
+    InstrumentIndex index = registry_.index(id);
+    if (index != kNoInstrument) {
+        auto& st = state_[index];
+        release_side(index, OrderSide::Buy, st.bid);
+        release_side(index, OrderSide::Sell, st.ask);
+        st.needs_requote = true;
+    }
+    return n;
+}
+
+template <typename Gateway, typename Router, typename QuotePolicy>
+void BasicMarketMakerController<Gateway, Router, QuotePolicy>::on_fill(const Fill& fill) {
+    InstrumentIndex index = registry_.index(fill.instrument);
+    if (index == kNoInstrument) {
+        risk_.on_fill(fill.instrument, fill.price, fill.qty);
+        return;
+    }
+    auto& st = state_[index];
+    const auto* params = qe_.params_at(index);
+    LiveQuote* live = nullptr;
+    OrderSide side = OrderSide::Buy;
+    if (fill.order_id != 0 && fill.order_id == st.bid.order_id) {
+        live = &st.bid;
+    } else if (fill.order_id != 0 && fill.order_id == st.ask.order_id) {
+        live = &st.ask;
+        side = OrderSide::Sell;
+    }
+    if (live != nullptr) {
+        commit_shared(index, *live, fill.price, fill.qty);
+        const QtyLots leaves = params ? params->scale().to_lots(fill.leaves) : 0;
+        if (leaves <= 0) {
+            release_side(index, side, *live);
+        } else if (leaves < live->size) {
+            // Only the filled lots leave the open-order book
+            const QtyLots filled = live->size - leaves;
+            risk_.on_order_closed_at(index, live->price,
+                                     side == OrderSide::Buy ? filled : -filled);
+            live->size = leaves;
+        }
+    }
+    risk_.on_fill_at(index, fill.price, fill.qty);
+    st.needs_requote = true;
+}
+
+template <typename Gateway, typename Router, typename QuotePolicy>
+void BasicMarketMakerController<Gateway, Router, QuotePolicy>::try_requote(
+    InstrumentIndex index) {
+    const Timestamp now = clock_->now();
+    auto venue = requote_venue(index, now);
+    if (!venue) return;
+
+    Quote quote = qe_.compute_quote_at(index, *md_.find_view_at(index),
+                                       risk_.position_at(index), *venue);
+    apply_quote(index, quote, now);
+}
+
+template <typename Gateway, typename Router, typename QuotePolicy>
+std::optional<VenueId> BasicMarketMakerController<Gateway, Router, QuotePolicy>::requote_venue(
+    InstrumentIndex index, Timestamp now) {
+    auto& inst_state = state_[index];
+
+    const auto* params = qe_.params_at(index);
+    if (params == nullptr) return std::nullopt;
+
+    const auto* view = md_.find_view_at(index);
+    if (view == nullptr || view->mid_price <= 0.0) return std::nullopt;
+
+    // Rate limit: while both sides rest, refresh at most every quote_refresh_ms.
+    // A missing side (e.g. after a fill) is replenished immediately. The
+    // skipped update stays pending, so the next event after the interval
+    // requotes even if the touch has not moved again.
+    bool both_live = inst_state.bid.order_id != 0 && inst_state.ask.order_id != 0;
+    if (inst_state.quoted && both_live &&
+        now - inst_state.last_quote_ts < ms_to_ns(params->quote_refresh_ms)) {
+        ++stats_.throttled;
+        inst_state.needs_requote = true;
+        return std::nullopt;
+    }
+
+    // Choose venue
+    VenueId venue = router_.choose_venue(*view, risk_.position_at(index));
+
+    // Check if we should re-quote
+    if (!risk_.can_quote_at(index, 0.1, 0.1)) return std::nullopt;
+    return venue;
+}
+
+template <typename Gateway, typename Router, typename QuotePolicy>
+void BasicMarketMakerController<Gateway, Router, QuotePolicy>::apply_quote(
+    InstrumentIndex index, const Quote& quote, Timestamp now) {
+    if (quote.bid_ticks <= 0 || quote.ask_ticks <= 0) return;
+    if (quote.bid_lots <= 0 && quote.ask_lots <= 0) return;
+
+    auto& inst_state = state_[index];
+    const auto& params = *qe_.params_at(index);
+    VenueId venue = quote.venue;
+
+    RiskCheck bid = quote.bid_lots > 0
+        ? check_side(index, OrderSide::Buy, inst_state.bid, quote.bid_ticks, quote.bid_lots, now)
+        : RiskCheck::Ok;
+    RiskCheck ask = quote.ask_lots > 0
+        ? check_side(index, OrderSide::Sell, inst_state.ask, quote.ask_ticks, quote.ask_lots, now)
+        : RiskCheck::Ok;
+    for (RiskCheck c : {bid, ask}) {
+        if (c != RiskCheck::Ok && c != RiskCheck::OrderRate) ++stats_.risk_rejects;
+    }
+
+    ++stats_.requotes;
+    bool bid_done = update_side(index, OrderSide::Buy, inst_state.bid, params, venue,
+                                quote.bid_ticks, quote.bid_lots,
+                                quote.bid_lots > 0 && bid == RiskCheck::Ok,
+                                bid == RiskCheck::OrderRate, now);
+    bool ask_done = update_side(index, OrderSide::Sell, inst_state.ask, params, venue,
+                                quote.ask_ticks, quote.ask_lots,
+                                quote.ask_lots > 0 && ask == RiskCheck::Ok,
+                                ask == RiskCheck::OrderRate, now);
+
+    inst_state.last_quote_ts = now;
+    inst_state.quoted = true;
+    // A held or rejected side is retried on the next update
+    inst_state.needs_requote = !bid_done || !ask_done;
+}
+
+template <typename Gateway, typename Router, typename QuotePolicy>
+RiskCheck BasicMarketMakerController<Gateway, Router, QuotePolicy>::check_side(
+    InstrumentIndex index, OrderSide side, const LiveQuote& live,
+    PriceTicks price, QtyLots size, Timestamp now) const {
+    const QtyLots sign = side == OrderSide::Buy ? 1 : -1;
+    if (live.order_id == 0) return risk_.check_order_at(index, price, sign * size, now);
+    return risk_.check_order_at(index, price, sign * size, now, live.price, sign * live.size);
+}
+
+template <typename Gateway, typename Router, typename QuotePolicy>
+bool BasicMarketMakerController<Gateway, Router, QuotePolicy>::crosses_touch(
+    InstrumentIndex index, OrderSide side, PriceTicks price, const PriceScale& scale) const {
+    if (side == OrderSide::Buy) {
+        const double ask = md_.best_ask_at(index);
+        return ask < std::numeric_limits<double>::max() && price >= scale.to_ticks(ask);
+    }
+    const double bid = md_.best_bid_at(index);
+    return bid > 0.0 && price <= scale.to_ticks(bid);
+}
+
+template <typename Gateway, typename Router, typename QuotePolicy>
+bool BasicMarketMakerController<Gateway, Router, QuotePolicy>::update_side(
+    InstrumentIndex index, OrderSide side, LiveQuote& live, const MarketMakingParams& p,
+    VenueId venue, PriceTicks price, QtyLots size, bool allowed, bool rate_held,
+    Timestamp now) {
+    const PriceScale scale = p.scale();
+    const QtyLots sign = side == OrderSide::Buy ? 1 : -1;
+    LiveOrder order{
+        .id          = 0,
+        .instrument  = state_[index].id,
+        .venue       = venue,
+        .side        = side,
+        .price       = scale.to_price(price),
+        .size        = scale.to_qty(size),
+        .price_ticks = price,
+        .size_lots   = size,
+    };
+
+    if (live.order_id != 0) {
+        // Leave the resting order alone unless the new quote is materially different
+        bool price_same = static_cast<double>(std::llabs(price - live.price)) < p.requote_min_ticks;
+        bool size_same  = static_cast<double>(std::llabs(size - live.size)) <=
+                          p.requote_size_tolerance * static_cast<double>(live.size);
+        if ((allowed || rate_held) && live.venue == venue && price_same && size_same) {
+            ++stats_.sides_unchanged;
+            return true;
+        }
+
+        // Out of order-rate budget: keep what rests while it is still a fair
+        // quote; a crossed or stale order is cancelled below
+        if (rate_held && price_same && !crosses_touch(index, side, live.price, scale)) {
+            ++stats_.rate_limited;
+            return false;
+        }
+
+        // Same venue: amend in place (one message, no gap in the quote)
+        if (allowed && live.venue == venue &&
+            reserve_shared(index, price, sign * size, live.reservation)) {
+            order.id = live.order_id;
+            risk_.on_order_closed_at(index, live.price, sign * live.size);
+            risk_.on_order_open_at(index, price, sign * size, now);
+            queue_action(OrderActionType::Amend, order, index, &live);
+            live.price = price;
+            live.size = size;
+            ++stats_.amends_sent;
+            return true;
+        }
+
+        LiveOrder cancel = order;
+        cancel.id = live.order_id;
+        queue_action(OrderActionType::Cancel, cancel, index, nullptr);
+        ++stats_.cancels_sent;
+        release_side(index, side, live);
+    }
+
+    if (rate_held) {
+        ++stats_.rate_limited;
+        return false;
+    }
+    if (!allowed) return size <= 0;
+
+    LedgerReservation reservation;
+    if (!reserve_shared(index, price, sign * size, reservation)) return false;
+
+    // The id is filled in when the batch is flushed; the order counts
+    // against the limits from now on
+    risk_.on_order_open_at(index, price, sign * size, now);
+    queue_action(OrderActionType::New, order, index, &live);
+    live = LiveQuote{
+        .order_id    = 0,
+        .venue       = venue,
+        .price       = price,
+        .size        = size,
+        .reservation = reservation,
+    };
+    ++stats_.orders_sent;
+    return true;
+}
+
+template <typename Gateway, typename Router, typename QuotePolicy>
+void BasicMarketMakerController<Gateway, Router, QuotePolicy>::release_side(
+    InstrumentIndex index, OrderSide side, LiveQuote& live) {
+    if (live.order_id != 0) {
+        risk_.on_order_closed_at(index, live.price,
+                                 side == OrderSide::Buy ? live.size : -live.size);
+    }
+    if (ledger_) ledger_->release(live.reservation);
+    live = LiveQuote{};
+}
+
+template <typename Gateway, typename Router, typename QuotePolicy>
+bool BasicMarketMakerController<Gateway, Router, QuotePolicy>::reserve_shared(
+    InstrumentIndex index, PriceTicks price, QtyLots lots, LedgerReservation& held) {
+    if (ledger_ == nullptr) return true;
+    ledger_->release(held);
+    if (ledger_->reserve(state_[index].ledger_index, price, lots, &held) == RiskCheck::Ok) {
+        return true;
+    }
+    ++stats_.risk_rejects;
+    return false;
+}
+
+template <typename Gateway, typename Router, typename QuotePolicy>
+void BasicMarketMakerController<Gateway, Router, QuotePolicy>::commit_shared(
+    InstrumentIndex index, LiveQuote& live, double price, double qty) {
+    const auto* params = qe_.params_at(index);
+    if (ledger_ == nullptr || params == nullptr) return;
+
+    const PriceScale scale = params->scale();
+    const PriceTicks ticks = scale.to_ticks(price);
+    const QtyLots    lots  = scale.to_lots(qty > 0.0 ? qty : -qty);
+    const QtyLots    held  = live.reservation.lots < 0 ? -live.reservation.lots
+                                                       : live.reservation.lots;
+    ledger_->commit(live.reservation, lots, ticks);
+    // Anything beyond the reserved size still moves the position
+    if (lots > held) {
+        ledger_->on_fill_at(state_[index].ledger_index, ticks,
+                            qty > 0.0 ? lots - held : held - lots);
+    }
+}
+
+template <typename Gateway, typename Router, typename QuotePolicy>
+void BasicMarketMakerController<Gateway, Router, QuotePolicy>::queue_action(
+    OrderActionType type, const LiveOrder& order, InstrumentIndex index, LiveQuote* live) {
+    batch_.push_back(OrderAction{.type = type, .order = order});
+    batch_refs_.push_back(PendingRef{.index = index, .state = &state_[index], .live = live});
+}
+
+template <typename Gateway, typename Router, typename QuotePolicy>
+void BasicMarketMakerController<Gateway, Router, QuotePolicy>::flush_actions() {
+    if (batch_.empty()) return;
+
+    gw_.send_batch(batch_);
+    ++stats_.batches_sent;
+
+    for (size_t i = 0; i < batch_.size(); ++i) {
+        const auto& a = batch_[i];
+        auto& ref = batch_refs_[i];
+        if (ref.live == nullptr) continue;
+        const QtyLots lots = a.order.side == OrderSide::Buy ? a.order.size_lots
+                                                            : -a.order.size_lots;
+        if (a.type == OrderActionType::New) {
+            ref.live->order_id = a.order.id;
+            if (!a.ok) {
+                risk_.on_order_closed_at(ref.index, a.order.price_ticks, lots);
+                if (ledger_) ledger_->release(ref.live->reservation);
+            }
+        } else if (a.type == OrderActionType::Amend && !a.ok) {
+            // Order vanished underneath us (e.g. filled); replace it on the
+            // next update
+            risk_.on_order_closed_at(ref.index, a.order.price_ticks, lots);
+            if (ledger_) ledger_->release(ref.live->reservation);
+            *ref.live = LiveQuote{};
+            ref.state->needs_requote = true;
+        }
+    }
+    batch_.clear();
+    batch_refs_.clear();
+}
+
+} // namespace mme
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "market/market_view.hpp"
+#include "util/fixed_point.hpp"
+
 namespace mme {
 
 struct MarketMakingParams {
@@ -8,10 +11,23 @@ struct MarketMakingParams {
     double max_spread_bp        = 50.0;   // cap
     double volatility_coeff     = 1.0;    // how much to widen spread with vol
     double inventory_coeff      = 0.5;    // how much to skew based on inventory
+    double factor_skew_weight   = 0.0;    // 0..1 share of the skew inventory taken from factor exposure
     double size_base            = 1.0;    // base quote size
     double size_inventory_scale = 0.5;    // scale size vs inventory (beta)
     double quote_refresh_ms     = 100.0;  // min time between re-quotes
-    double max_position         = 100.0;  // absolute position limit
+    double tick_size            = 0.01;   // price increment (from InstrumentConfig)
+    double lot_size             = 0.01;   // size increment (from InstrumentConfig)
+    double requote_min_ticks    = 1.0;    // price move needed to replace a live order
+    double requote_size_tolerance = 0.1;  // relative size change tolerated without replacing
+    double max_position         = 100.0;  // absolute position limit, open orders included
+    double max_order_rate       = 0.0;    // new / amended orders per second, 0 = unlimited
+    double quote_cache_vol_bucket = 0.0;  // sigma bucket width for the quote cache; 0 = no cache
+    VolatilityEstimator volatility_estimator = VolatilityEstimator::Ewma; // sigma fed to spread
+    FairPrice fair_price        = FairPrice::Mid;                      // quote center
+
+    PriceScale scale() const { return PriceScale{.tick_size = tick_size, .lot_size = lot_size}; }
+
+    bool operator==(const MarketMakingParams&) const = default;
 };
 
 } // namespace mme
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "config/instrument_registry.hpp"
+#include "strategy/market_making_params.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mme {
+
+// One immutable version of the strategy parameters, indexed by the store's
+// registry.
+struct ParamSet {
+    uint64_t                        version = 0;
+    std::vector<MarketMakingParams> params;       // by InstrumentIndex
+    std::vector<uint8_t>            configured;
+
+    // nullptr if the instrument is not configured.
+    const MarketMakingParams* at(InstrumentIndex index) const {
+        return index < configured.size() && configured[index] ? &params[index] : nullptr;
+    }
+};
+
+// Read-copy-update store for MarketMakingParams shared by QuoteEngine and
+// RiskManager. Readers take the current set with one acquire load and never
+// lock; publish() builds a new set off to the side and swaps the pointer.
+// Superseded sets are kept until the store is destroyed, so a pointer a
+// reader obtained never dangles (reloads are operator actions, so the
+// retained history stays small).
+class ParamStore {
+public:
+    // Version 1. Params for ids outside the registry are ignored.
+    ParamStore(const InstrumentRegistry& registry,
+               const std::unordered_map<InstrumentId, MarketMakingParams>& params);
+    explicit ParamStore(const std::unordered_map<InstrumentId, MarketMakingParams>& params)
+        : ParamStore(InstrumentRegistry::from_keys(params), params) {}
+
+    ParamStore(const ParamStore&) = delete;
+    ParamStore& operator=(const ParamStore&) = delete;
+
+    const ParamSet& current() const { return *current_.load(std::memory_order_acquire); }
+    uint64_t version() const { return current().version; }
+    const InstrumentRegistry& registry() const { return registry_; }
+
+    // Validates `params` and publishes them as a new version. Instruments
+    // missing from `params` keep their current values. Returns false and
+    // leaves the current version in place if any entry is rejected
+    // (unknown instrument, changed tick or lot size, inconsistent limits);
+    // `error` then names the first problem. Publishing values identical to
+    // the current ones succeeds without bumping the version. Thread-safe.
+    bool publish(const std::unordered_map<InstrumentId, MarketMakingParams>& params,
+                 std::string* error = nullptr);
+
+    // Checks one parameter block on its own.
+    static bool validate(const MarketMakingParams& p, std::string* error = nullptr);
+
+private:
+    InstrumentRegistry                     registry_;
+    std::atomic<const ParamSet*>           current_{nullptr};
+    std::mutex                             publish_mutex_;
+    std::vector<std::unique_ptr<ParamSet>> versions_;   // guarded by publish_mutex_
+};
+
+} // namespace mme
@@ -1,47 +1,156 @@
 #pragma once
 
 #include "config/instrument_config.hpp"
+#include "config/instrument_registry.hpp"
 #include "config/venue_config.hpp"
 #include "market/market_view.hpp"
+#include "risk/factor_exposure.hpp"
 #include "risk/portfolio.hpp"
 #include "strategy/market_making_params.hpp"
+#include "strategy/param_store.hpp"
+#include "strategy/quote_kernels.hpp"
+#include "util/clock.hpp"
 
-#include <chrono>
+#include <cstdint>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace mme {
 
-using Timestamp = uint64_t; // milliseconds since epoch
-
+// Prices are on the instrument's tick grid and sizes whole lots; the
+// double fields are the same values scaled for reporting. params_version is
+// the ParamStore version the quote was computed from.
 struct Quote {
     InstrumentId id        = 0;
     VenueId      venue     = 0;
+    PriceTicks   bid_ticks = 0;
+    PriceTicks   ask_ticks = 0;
+    QtyLots      bid_lots  = 0;
+    QtyLots      ask_lots  = 0;
     double       bid_price = 0.0;
     double       ask_price = 0.0;
     double       bid_size  = 0.0;
     double       ask_size  = 0.0;
     Timestamp    ts        = 0;
+    uint64_t     params_version = 0;
+};
+
+// Quote cache counters. Only instruments with quote_cache_vol_bucket > 0
+// are counted.
+struct QuoteCacheStats {
+    uint64_t hits   = 0;
+    uint64_t misses = 0;
+
+    double hit_rate() const {
+        uint64_t total = hits + misses;
+        return total ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+    }
 };
 
 class QuoteEngine {
 public:
-    explicit QuoteEngine(std::unordered_map<InstrumentId, MarketMakingParams> params);
+    // add_to_batch's return value when the quote came from the cache and
+    // nothing was staged; batch_quote accepts it like any other lane.
+    static constexpr size_t kCachedLane = SIZE_MAX;
 
+    // Quotes are stamped from `clock` (default_clock() if null). Without a
+    // registry, instruments are indexed by InstrumentRegistry::from_keys(params).
+    // The map constructors own a private ParamStore; pass a shared one to
+    // pick up hot reloads published to it.
+    explicit QuoteEngine(const std::unordered_map<InstrumentId, MarketMakingParams>& params,
+                         const Clock* clock = nullptr);
+    QuoteEngine(const InstrumentRegistry& registry,
+                const std::unordered_map<InstrumentId, MarketMakingParams>& params,
+                const Clock* clock = nullptr);
+    explicit QuoteEngine(std::shared_ptr<const ParamStore> store, const Clock* clock = nullptr);
+
+    // Portfolio-aware skew: instruments with factor_skew_weight > 0 and
+    // loadings in `factors` skew on
+    //   (1 - weight) * position + weight * hedged_exposure_at(i) / fair,
+    // an O(factors) read per quote. Size still follows the position alone.
+    // `factors` must be indexed like registry() (e.g. the one owned by the
+    // RiskManager sharing this engine's ParamStore); nullptr turns it off.
+    void set_factor_exposure(const FactorExposure* factors) { factors_ = factors; }
+
+    // With quote_cache_vol_bucket > 0, the last quote per instrument is
+    // reused while the fair price in ticks, the volatility bucket, the
+    // position, the skew inventory in lots and the params version are
+    // unchanged. A hit returns the quote computed for the first state seen
+    // in that bucket, restamped. The cache
+    // is per engine and not thread-safe, like the rest of the quoting path.
     Quote compute_quote(const InstrumentMarketView& view,
                         const InstrumentPosition& position,
                         VenueId venue) const;
+    // Hot path: `index` is view.id's index in registry().
+    Quote compute_quote_at(InstrumentIndex index,
+                           const InstrumentMarketView& view,
+                           const InstrumentPosition& position,
+                           VenueId venue) const;
+
+    // Batched path, same results as compute_quote_at: stage each configured
+    // instrument with add_to_batch, run compute_batch once, then read each
+    // lane back with batch_quote.
+    size_t add_to_batch(QuoteBatch& batch, InstrumentIndex index,
+                        const InstrumentMarketView& view,
+                        const InstrumentPosition& position) const;
+    void   compute_batch(QuoteBatch& batch) const { compute_quotes(batch.input(), batch.output()); }
+    Quote  batch_quote(const QuoteBatch& batch, size_t lane, InstrumentIndex index,
+                       VenueId venue) const;
+
+    // nullptr if the instrument is not configured. Reads the store's
+    // current version; the pointer stays valid after later reloads.
+    const MarketMakingParams* params(InstrumentId id) const;
+    const MarketMakingParams* params_at(InstrumentIndex index) const {
+        return store_->current().at(index);
+    }
+
+    const InstrumentRegistry& registry() const { return store_->registry(); }
+    const ParamStore&         param_store() const { return *store_; }
+
+    const QuoteCacheStats& cache_stats() const { return cache_stats_; }
+    void reset_cache_stats() { cache_stats_ = {}; }
 
 private:
-    std::unordered_map<InstrumentId, MarketMakingParams> params_;
-
-    double compute_spread(const MarketMakingParams& p, double volatility) const;
-    double compute_skew(const MarketMakingParams& p,
-                        double inventory,
-                        double max_position,
-                        double spread) const;
-    double compute_size(const MarketMakingParams& p,
-                        double inventory,
-                        double max_position) const;
+    struct CacheKey {
+        int64_t  fair_ticks     = 0;
+        int64_t  vol_bucket     = 0;
+        double   inventory      = 0.0;
+        QtyLots  skew_lots      = 0;
+        uint64_t params_version = 0;
+
+        bool operator==(const CacheKey&) const = default;
+    };
+    struct CacheEntry {
+        CacheKey  key;
+        QuoteLane lane;
+        bool      valid = false;   // false while a staged lane is pending
+    };
+
+    std::shared_ptr<const ParamStore> store_;
+    const Clock* clock_;
+    const FactorExposure* factors_ = nullptr;
+    mutable std::vector<CacheEntry> cache_;   // by InstrumentIndex
+    mutable QuoteCacheStats         cache_stats_;
+
+    static CacheKey cache_key(const MarketMakingParams& p, uint64_t version,
+                              double fair, double volatility, double inventory,
+                              double skew_inventory);
+    // The cached lane for `key`, or nullptr after recording a miss (and
+    // claiming the entry for `key`)
+    const QuoteLane* cache_lookup(InstrumentIndex index, const CacheKey& key) const;
+
+    // The inventory the skew is computed from; the position unless the
+    // factor model applies. A factor-blended value is truncated to whole
+    // lots so marks elsewhere in the book only miss the cache once they move
+    // it by a lot.
+    double skew_inventory(InstrumentIndex index, const MarketMakingParams& p,
+                          double inventory, double fair) const;
+    static double select_fair_price(const InstrumentMarketView& view, FairPrice fair_price);
+    static double select_volatility(const InstrumentMarketView& view,
+                                    VolatilityEstimator estimator);
+    Quote make_quote(InstrumentId id, VenueId venue, const QuoteLane& lane,
+                     const PriceScale& scale, uint64_t params_version) const;
 };
 
 } // namespace mme
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "strategy/market_making_params.hpp"
+#include "util/fixed_point.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace mme {
+
+// Spread / skew / size for one instrument, rounded onto its tick and lot
+// grid. All four values are zero when fair <= 0.
+struct QuoteLane {
+    PriceTicks bid_ticks = 0;
+    PriceTicks ask_ticks = 0;
+    QtyLots    bid_lots  = 0;
+    QtyLots    ask_lots  = 0;
+};
+
+// Reference quote math shared by QuoteEngine::compute_quote and the scalar
+// batch kernel. Size follows `inventory`; the skew follows `skew_inventory`,
+// which the first overload sets to `inventory`.
+QuoteLane quote_lane(double fair, double volatility, double inventory,
+                     const MarketMakingParams& p);
+QuoteLane quote_lane(double fair, double volatility, double inventory, double skew_inventory,
+                     const MarketMakingParams& p);
+
+// Structure-of-arrays inputs for n instruments. Parameters are per lane too,
+// so one batch can mix instruments.
+struct QuoteBatchInput {
+    size_t        n                    = 0;
+    const double* fair                 = nullptr;   // <= 0 -> no quote
+    const double* volatility           = nullptr;
+    const double* inventory            = nullptr;
+    const double* skew_inventory       = nullptr;   // nullptr -> inventory
+    const double* base_spread_bp       = nullptr;
+    const double* min_spread_bp        = nullptr;
+    const double* max_spread_bp        = nullptr;
+    const double* volatility_coeff     = nullptr;
+    const double* inventory_coeff      = nullptr;
+    const double* size_base            = nullptr;
+    const double* size_inventory_scale = nullptr;
+    const double* max_position         = nullptr;
+    const double* tick_size            = nullptr;
+    const double* lot_size             = nullptr;
+};
+
+struct QuoteBatchOutput {
+    PriceTicks* bid_ticks = nullptr;
+    PriceTicks* ask_ticks = nullptr;
+    QtyLots*    bid_lots  = nullptr;
+    QtyLots*    ask_lots  = nullptr;
+};
+
+enum class QuoteKernel : uint8_t { Scalar, Avx2, Avx512 };
+
+// Widest kernel the CPU supports.
+QuoteKernel best_quote_kernel();
+
+// Every kernel performs the same IEEE operations in the same order (no FMA
+// contraction), so results are bit-identical to quote_lane. Requesting a
+// kernel the CPU lacks falls back to the scalar one.
+void compute_quotes(const QuoteBatchInput& in, const QuoteBatchOutput& out);
+void compute_quotes(const QuoteBatchInput& in, const QuoteBatchOutput& out, QuoteKernel kernel);
+
+// Owning storage for one batch. Reuse it across calls: after the first
+// batch of a given size, add() and compute do not allocate.
+class QuoteBatch {
+public:
+    void reserve(size_t n);
+    void clear();
+    size_t size() const { return fair_.size(); }
+
+    // Returns the lane index. params_version is carried through untouched
+    // for the caller (see QuoteEngine::batch_quote).
+    size_t add(double fair, double volatility, double inventory, const MarketMakingParams& p,
+               uint64_t params_version = 0);
+    size_t add(double fair, double volatility, double inventory, double skew_inventory,
+               const MarketMakingParams& p, uint64_t params_version = 0);
+
+    QuoteBatchInput  input() const;
+    QuoteBatchOutput output();
+
+    QuoteLane result(size_t lane) const {
+        return QuoteLane{bid_ticks_[lane], ask_ticks_[lane], bid_lots_[lane], ask_lots_[lane]};
+    }
+    uint64_t params_version(size_t lane) const { return params_version_[lane]; }
+
+private:
+    std::vector<double> fair_, volatility_, inventory_, skew_inventory_;
+    std::vector<double> base_spread_bp_, min_spread_bp_, max_spread_bp_;
+    std::vector<double> volatility_coeff_, inventory_coeff_;
+    std::vector<double> size_base_, size_inventory_scale_, max_position_;
+    std::vector<double> tick_size_, lot_size_;
+    std::vector<PriceTicks> bid_ticks_, ask_ticks_;
+    std::vector<QtyLots>    bid_lots_, ask_lots_;
+    std::vector<uint64_t>   params_version_;
+};
+
+} // namespace mme
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "market/market_view.hpp"
+#include "strategy/quote_engine.hpp"
+#include "util/flat_index_map.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace mme {
+
+enum class ConflationPolicy : uint8_t {
+    LatestWins,    // flush on every drain
+    TimeWindow,    // flush once the oldest pending update is time_window_ms old
+    CountWindow,   // flush once count_window updates have been received
+};
+
+struct ConflationConfig {
+    ConflationPolicy policy         = ConflationPolicy::LatestWins;
+    double           time_window_ms = 0.0;
+    size_t           count_window   = 0;
+};
+
+struct ConflationStats {
+    uint64_t received  = 0;   // updates pushed
+    uint64_t applied   = 0;   // updates handed out by drain()
+    uint64_t conflated = 0;   // updates overwritten by a later one before a drain
+    uint64_t flushes   = 0;
+};
+
+// Buffers full-book snapshots between drain cycles, keeping only the latest
+// per (instrument, venue). A drain hands each surviving snapshot out once,
+// in order of first arrival within the cycle.
+class UpdateConflator {
+public:
+    explicit UpdateConflator(ConflationConfig config = {});
+
+    void push(const VenueBookSnapshot& snapshot, Timestamp now);
+
+    // Whether the policy says the pending updates should be flushed now.
+    bool ready(Timestamp now) const;
+
+    template <typename F>
+    size_t drain(F&& apply) {
+        size_t n = pending_.size();
+        for (const auto& snap : pending_) {
+            apply(snap);
+        }
+        stats_.applied += n;
+        if (n > 0) ++stats_.flushes;
+        pending_.clear();
+        slots_.clear();
+        received_in_window_ = 0;
+        return n;
+    }
+
+    size_t pending() const { return pending_.size(); }
+    const ConflationConfig& config() const { return config_; }
+    const ConflationStats&  stats()  const { return stats_; }
+
+private:
+    static uint64_t key(InstrumentId id, VenueId venue) {
+        return (static_cast<uint64_t>(id) << 8) | venue;
+    }
+
+    ConflationConfig               config_;
+    ConflationStats                stats_;
+    std::vector<VenueBookSnapshot> pending_;
+    FlatIndexMap                   slots_;      // (instrument, venue) -> pending_ index
+    Timestamp                      first_pending_ts_   = 0;
+    size_t                         received_in_window_ = 0;
+};
+
+} // namespace mme
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+
+namespace mme {
+
+using Timestamp = uint64_t; // nanoseconds
+
+inline constexpr Timestamp kNanosPerMilli = 1'000'000;
+
+// Converts a millisecond setting (e.g. quote_refresh_ms) to a Timestamp delta.
+constexpr Timestamp ms_to_ns(double ms) {
+    return ms <= 0.0 ? 0 : static_cast<Timestamp>(ms * static_cast<double>(kNanosPerMilli));
+}
+
+// Time source injected into components that stamp or throttle on time.
+class Clock {
+public:
+    virtual ~Clock() = default;
+    virtual Timestamp now() const = 0;
+};
+
+// std::chrono::steady_clock in nanoseconds.
+class SteadyClock final : public Clock {
+public:
+    Timestamp now() const override;
+};
+
+// Manually driven time for backtests and tests; fully deterministic.
+class SimulatedClock final : public Clock {
+public:
+    explicit SimulatedClock(Timestamp start = 0) : now_(start) {}
+
+    Timestamp now() const override { return now_; }
+    void set(Timestamp t) { now_ = t; }
+    void advance(Timestamp dt) { now_ += dt; }
+
+private:
+    Timestamp now_;
+};
+
+// Reads the invariant TSC and scales it to nanoseconds with a multiplier
+// calibrated against steady_clock at construction. Falls back to
+// steady_clock when the CPU has no invariant TSC (or is not x86-64).
+// Readings share steady_clock's epoch, so the two can be mixed.
+class TscClock final : public Clock {
+public:
+    explicit TscClock(uint32_t calibration_ms = 20);
+
+    Timestamp now() const override;
+
+    bool   using_tsc()      const { return use_tsc_; }
+    double ticks_per_ns()   const { return ticks_per_ns_; }
+
+private:
+    bool      use_tsc_      = false;
+    uint64_t  base_tsc_     = 0;
+    Timestamp base_ns_      = 0;
+    uint64_t  mult_         = 0;   // ns per tick in 32.32 fixed point
+    double    ticks_per_ns_ = 0.0;
+};
+
+// Process-wide steady clock used when no clock is injected.
+const Clock& default_clock();
+
+} // namespace mme
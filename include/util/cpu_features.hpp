@@ -0,0 +1,28 @@
+#pragma once
+
+namespace mme {
+
+// Runtime CPU feature checks used to select SIMD kernels. Results are
+// computed once; on non-x86 or non-GNU compilers they report false and the
+// scalar kernels are used.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MME_X86_DISPATCH 1
+
+inline bool cpu_has_avx2() {
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+}
+
+inline bool cpu_has_avx512f() {
+    static const bool has = __builtin_cpu_supports("avx512f");
+    return has;
+}
+
+#else
+
+inline bool cpu_has_avx2()    { return false; }
+inline bool cpu_has_avx512f() { return false; }
+
+#endif
+
+} // namespace mme
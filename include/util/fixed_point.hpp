@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace mme {
+
+// Prices are carried as integer ticks and quantities as integer lots of the
+// instrument; doubles only appear at the edges (feeds, config, reports,
+// gateway wire calls).
+using PriceTicks = int64_t;
+using QtyLots    = int64_t;
+
+// Per-instrument scale between doubles and ticks / lots.
+struct PriceScale {
+    // Tolerance (in ticks or lots) for values that are on the grid up to
+    // floating-point representation error
+    static constexpr double kGridEpsilon = 1e-9;
+
+    double tick_size = 0.01;
+    double lot_size  = 0.01;
+
+    // Nearest tick, for prices that are already on the grid (book levels)
+    PriceTicks to_ticks(double price) const {
+        return static_cast<PriceTicks>(std::llround(price / tick_size));
+    }
+    // Passive rounding for quotes: bids round down, asks round up
+    PriceTicks bid_ticks(double price) const {
+        return static_cast<PriceTicks>(std::floor(price / tick_size + kGridEpsilon));
+    }
+    PriceTicks ask_ticks(double price) const {
+        return static_cast<PriceTicks>(std::ceil(price / tick_size - kGridEpsilon));
+    }
+    double to_price(PriceTicks ticks) const { return static_cast<double>(ticks) * tick_size; }
+
+    // Whole lots, rounded toward zero so a size never grows
+    QtyLots to_lots(double qty) const {
+        double lots = qty / lot_size;
+        return static_cast<QtyLots>(lots >= 0.0 ? std::floor(lots + kGridEpsilon)
+                                                 : std::ceil(lots - kGridEpsilon));
+    }
+    double to_qty(QtyLots lots) const { return static_cast<double>(lots) * lot_size; }
+};
+
+} // namespace mme
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace mme {
+
+// Open-addressing hash map from a 64-bit key to a 32-bit index, with linear
+// probing and backward-shift deletion (no tombstones). Storage is a single
+// flat array sized to a power of two; it only allocates when it grows.
+class FlatIndexMap {
+public:
+    static constexpr uint32_t kNotFound = UINT32_MAX;
+
+    explicit FlatIndexMap(size_t expected = 1024) { rehash(capacity_for(expected)); }
+
+    uint32_t find(uint64_t key) const {
+        size_t i = bucket(key);
+        while (slots_[i].used) {
+            if (slots_[i].key == key) return slots_[i].value;
+            i = (i + 1) & mask_;
+        }
+        return kNotFound;
+    }
+
+    // Inserts or overwrites.
+    void insert(uint64_t key, uint32_t value) {
+        if ((size_ + 1) * 2 > slots_.size()) rehash(slots_.size() * 2);
+        size_t i = bucket(key);
+        while (slots_[i].used) {
+            if (slots_[i].key == key) {
+                slots_[i].value = value;
+                return;
+            }
+            i = (i + 1) & mask_;
+        }
+        slots_[i] = Slot{key, value, true};
+        ++size_;
+    }
+
+    bool erase(uint64_t key) {
+        size_t i = bucket(key);
+        while (slots_[i].used && slots_[i].key != key) i = (i + 1) & mask_;
+        if (!slots_[i].used) return false;
+
+        // Shift following entries back so probe chains stay unbroken.
+        size_t hole = i;
+        size_t j = i;
+        for (;;) {
+            j = (j + 1) & mask_;
+            if (!slots_[j].used) break;
+            size_t home = bucket(slots_[j].key);
+            bool movable = (hole <= j) ? (home <= hole || home > j)
+                                       : (home <= hole && home > j);
+            if (movable) {
+                slots_[hole] = slots_[j];
+                hole = j;
+            }
+        }
+        slots_[hole].used = false;
+        --size_;
+        return true;
+    }
+
+    void clear() {
+        for (auto& s : slots_) s.used = false;
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+
+private:
+    struct Slot {
+        uint64_t key   = 0;
+        uint32_t value = 0;
+        bool     used  = false;
+    };
+
+    static size_t capacity_for(size_t expected) {
+        size_t cap = 16;
+        while (cap < expected * 2) cap *= 2;
+        return cap;
+    }
+
+    size_t bucket(uint64_t key) const {
+        // Fibonacci hashing spreads sequential exchange order ids.
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> shift_) & mask_;
+    }
+
+    void rehash(size_t new_capacity) {
+        std::vector<Slot> old = std::move(slots_);
+        slots_.assign(new_capacity, Slot{});
+        mask_ = new_capacity - 1;
+        shift_ = 64;
+        for (size_t c = new_capacity; c > 1; c >>= 1) --shift_;
+        size_ = 0;
+        for (const auto& s : old) {
+            if (s.used) insert(s.key, s.value);
+        }
+    }
+
+    std::vector<Slot> slots_;
+    size_t            mask_  = 0;
+    unsigned          shift_ = 64;
+    size_t            size_  = 0;
+};
+
+} // namespace mme
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace mme {
+
+// Fixed-capacity ring that overwrites its oldest element once full.
+// N must be a power of two.
+template <typename T, size_t N>
+class RingBuffer {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "RingBuffer capacity must be a power of two");
+
+public:
+    static constexpr size_t kCapacity = N;
+
+    // Appends `value`; returns true and stores the overwritten element in
+    // `evicted` when the ring was already full.
+    bool push(const T& value, T& evicted) {
+        bool full = size_ == N;
+        if (full) evicted = data_[head_];
+        data_[head_] = value;
+        head_ = (head_ + 1) & (N - 1);
+        if (!full) ++size_;
+        return full;
+    }
+
+    void push(const T& value) {
+        T ignored;
+        push(value, ignored);
+    }
+
+    // ago = 0 is the most recent element.
+    const T& back(size_t ago = 0) const { return data_[(head_ + N - 1 - ago) & (N - 1)]; }
+
+    size_t size()  const { return size_; }
+    bool   empty() const { return size_ == 0; }
+    bool   full()  const { return size_ == N; }
+    static constexpr size_t capacity() { return N; }
+
+    void clear() {
+        head_ = 0;
+        size_ = 0;
+    }
+
+private:
+    std::array<T, N> data_{};
+    size_t head_ = 0;
+    size_t size_ = 0;
+};
+
+} // namespace mme
@@ -0,0 +1,24 @@
+#pragma once
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace mme {
+
+// Pin the calling thread to one CPU. cpu < 0 leaves the thread unpinned.
+// Returns false if pinning was requested but is unsupported or failed.
+inline bool pin_current_thread(int cpu) {
+    if (cpu < 0) return true;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+} // namespace mme
@@ -9,8 +9,43 @@
 
 namespace mme {
 
+namespace {
+
+void record_fill(MetricsCollector& metrics, const MarketDataAggregator& md,
+                 InstrumentId id, double price, double qty) {
+    const auto* view = md.find_view(id);
+    double spread_captured = 0.0;
+    if (view != nullptr && view->mid_price > 0) {
+        spread_captured = (qty > 0)
+            ? (view->mid_price - price)   // bought below mid
+            : (price - view->mid_price);  // sold above mid
+    }
+    metrics.record_fill(id, spread_captured);
+}
+
+// The backtest loop is statically dispatched: the controller calls the
+// simulator directly and fills reach the controller through a concrete
+// functor rather than a std::function.
+struct BacktestFillSink;
+using BacktestGateway    = BasicSimExecutionGateway<BacktestFillSink>;
+using BacktestController = BasicMarketMakerController<BacktestGateway, VenueRouter, QuoteEngine>;
+
+struct BacktestFillSink {
+    BacktestController*         controller = nullptr;
+    MetricsCollector*           metrics    = nullptr;
+    const MarketDataAggregator* md         = nullptr;
+
+    void operator()(const Fill& fill) const {
+        controller->on_fill(fill);
+        record_fill(*metrics, *md, fill.instrument, fill.price, fill.qty);
+    }
+};
+
+} // anonymous namespace
+
 BacktestRunner::BacktestRunner(const BacktestConfig& config)
-    : config_(config) {}
+    : config_(config),
+      params_(std::make_shared<ParamStore>(make_registry(), config_.params)) {}
 
 void BacktestRunner::run() {
     if (config_.data_file.empty()) {
@@ -32,82 +67,153 @@ void BacktestRunner::run_synthetic(size_t num_ticks, size_t num_instruments, siz
     process_snapshots(snapshots);
 }
 
-void BacktestRunner::process_snapshots(const std::vector<VenueBookSnapshot>& snapshots) {
-    // Set up components
-    MarketDataAggregator md;
-    RiskManager risk(config_.params);
-    QuoteEngine qe(config_.params);
-
+std::vector<VenueConfig> BacktestRunner::venues_or_default() const {
     std::vector<VenueConfig> venues = config_.venues;
     if (venues.empty()) {
         venues.push_back(VenueConfig{.id = 1, .name = "SIM", .maker_fee_bp = 1.0,
                                       .taker_fee_bp = 2.0, .latency_ms = 1.0, .cancel_penalty_bp = 0.1});
     }
-    VenueRouter router(venues);
+    return venues;
+}
 
-    // Collect instrument IDs
-    std::vector<InstrumentId> instrument_ids;
+InstrumentRegistry BacktestRunner::make_registry() const {
+    InstrumentRegistry registry(config_.instruments, venues_or_default());
+    const InstrumentRegistry from_params = InstrumentRegistry::from_keys(config_.params);
+    for (InstrumentId id : from_params.ids()) registry.add_instrument(id);
+    return registry;
+}
+
+std::vector<InstrumentId> BacktestRunner::instrument_ids() const {
+    std::vector<InstrumentId> ids;
     for (const auto& [id, _] : config_.params) {
-        instrument_ids.push_back(id);
+        ids.push_back(id);
     }
+    return ids;
+}
 
-    // Fill callback
-    auto fill_cb = [&](InstrumentId id, VenueId venue, double price, double qty) {
-        risk.on_fill(id, price, qty);
-        auto view = md.get_view(id);
-        double spread_captured = 0.0;
-        if (view.mid_price > 0) {
-            spread_captured = (qty > 0)
-                ? (view.mid_price - price)   // bought below mid
-                : (price - view.mid_price);  // sold above mid
-        }
-        metrics_.record_fill(id, spread_captured);
+void BacktestRunner::enable_factor_skew(RiskManager& risk, QuoteEngine& qe) const {
+    size_t num_factors = 0;
+    for (const auto& ic : config_.instruments) {
+        num_factors = std::max(num_factors, ic.factor_loadings.size());
+    }
+    if (num_factors == 0) return;
+
+    FactorExposure& factors = risk.enable_factor_exposure(num_factors);
+    for (const auto& ic : config_.instruments) {
+        if (!ic.factor_loadings.empty()) factors.set_loadings(ic.id, ic.factor_loadings);
+    }
+    qe.set_factor_exposure(risk.factor_exposure());
+}
+
+void BacktestRunner::record_tick(const MarketDataAggregator& md, RiskManager& risk,
+                                 const VenueBookSnapshot& snapshot, Timestamp ts) {
+    // Record metrics for this instrument
+    const auto* view = md.find_view(snapshot.instrument);
+    const double mid    = view ? view->mid_price : 0.0;
+    const double spread = view ? view->spread : 0.0;
+    const auto& pos = risk.position(snapshot.instrument);
+
+    metrics_.record_quote(snapshot.instrument);
+
+    TickMetric tick{
+        .ts              = ts,
+        .instrument      = snapshot.instrument,
+        .mid_price       = mid,
+        .position        = pos.quantity,
+        .realized_pnl    = pos.realized_pnl,
+        .unrealized_pnl  = pos.unrealized_pnl,
+        .bid_price       = mid - spread / 2.0,
+        .ask_price       = mid + spread / 2.0,
+        .spread_captured = 0.0,
     };
+    metrics_.record_tick(tick);
 
-    SimExecutionGateway gw(fill_cb);
-    MarketMakerController controller(md, risk, qe, router, gw, instrument_ids);
+    // Only this instrument's mid moved; the risk totals follow in O(1)
+    risk.on_mark(snapshot.instrument, mid);
+    metrics_.record_exposure(risk.portfolio().total_net_exposure);
+}
 
-    Timestamp ts = 0;
+void BacktestRunner::process_snapshots(const std::vector<VenueBookSnapshot>& snapshots) {
+    if (config_.pipelined) {
+        process_snapshots_pipelined(snapshots);
+        return;
+    }
+
+    // Set up components
+    MarketDataAggregator md;
+    RiskManager risk(params_);
+    risk.set_portfolio_limits(config_.risk_limits);
+    // Simulated time advances 1 ms per snapshot, so results are deterministic
+    SimulatedClock clock;
+    if (config_.risk_limits.max_var > 0.0) risk.enable_portfolio_var(config_.var, &clock);
+    QuoteEngine qe(params_, &clock);
+    enable_factor_skew(risk, qe);
+    VenueRouter router(venues_or_default());
+    std::vector<InstrumentId> ids = instrument_ids();
+
+    // The controller is created after the gateway it drives
+    BacktestGateway gw(BacktestFillSink{.metrics = &metrics_, .md = &md});
+    gw.set_tick_sizes(config_.params);
+    BacktestController controller(md, risk, qe, router, gw, ids, &clock);
+    gw.fill_sink().controller = &controller;
 
     for (const auto& snapshot : snapshots) {
-        ts++;
-        controller.set_current_time(ts);
+        clock.advance(kNanosPerMilli);
         controller.on_market_data(snapshot);
 
         // Check for simulated fills
         gw.check_fills(snapshot);
 
-        // Record metrics for this instrument
-        auto view = md.get_view(snapshot.instrument);
-        const auto& pos = risk.position(snapshot.instrument);
-
-        metrics_.record_quote(snapshot.instrument);
-
-        TickMetric tick{
-            .ts              = ts,
-            .instrument      = snapshot.instrument,
-            .mid_price       = view.mid_price,
-            .position        = pos.quantity,
-            .realized_pnl    = pos.realized_pnl,
-            .unrealized_pnl  = pos.unrealized_pnl,
-            .bid_price       = view.mid_price - view.spread / 2.0,
-            .ask_price       = view.mid_price + view.spread / 2.0,
-            .spread_captured = 0.0,
-        };
-        metrics_.record_tick(tick);
-
-        // Update unrealized P&L
-        std::unordered_map<InstrumentId, double> mids;
-        for (auto id : instrument_ids) {
-            if (md.has_view(id)) {
-                mids[id] = md.get_view(id).mid_price;
-            }
-        }
-        risk.update_unrealized(mids);
-
-        double exposure = risk.portfolio().net_exposure(mids);
-        metrics_.record_exposure(exposure);
+        record_tick(md, risk, snapshot, clock.now());
     }
+    quote_cache_stats_ = qe.cache_stats();
+    final_var_ = risk.portfolio_var() ? risk.portfolio_var()->var() : 0.0;
+}
+
+void BacktestRunner::process_snapshots_pipelined(const std::vector<VenueBookSnapshot>& snapshots) {
+    MarketDataAggregator md;
+    RiskManager risk(params_);
+    risk.set_portfolio_limits(config_.risk_limits);
+    // Live timing: the stages run in real time and tick-to-order latency is
+    // measured on the same clock the controller throttles on
+    TscClock clock;
+    if (config_.risk_limits.max_var > 0.0) risk.enable_portfolio_var(config_.var, &clock);
+    QuoteEngine qe(params_, &clock);
+    enable_factor_skew(risk, qe);
+    VenueRouter router(venues_or_default());
+    std::vector<InstrumentId> ids = instrument_ids();
+
+    // Simulated fills are raised on the gateway thread and handed back to
+    // the strategy thread by the pipeline
+    Pipeline* pipeline_ptr = nullptr;
+    SimExecutionGateway gw([&](const Fill& fill) { pipeline_ptr->post_fill(fill); });
+    gw.set_tick_sizes(config_.params);
+    Pipeline pipeline(config_.pipeline, gw, &clock);
+    pipeline_ptr = &pipeline;
+
+    MarketMakerController controller(md, risk, qe, router, pipeline.gateway(), ids, &clock);
+
+    Timestamp ts = 0;
+    pipeline.set_gateway_market_data_hook([&](const VenueBookSnapshot& snap) {
+        gw.check_fills(snap);
+    });
+    pipeline.set_after_fill([&](const Fill& fill) {
+        record_fill(metrics_, md, fill.instrument, fill.price, fill.qty);
+    });
+    pipeline.set_after_market_data([&](const VenueBookSnapshot& snap) {
+        ts += kNanosPerMilli;   // same tick spacing as the single-threaded path
+        record_tick(md, risk, snap, ts);
+    });
+
+    size_t next = 0;
+    pipeline.run(controller, [&](VenueBookSnapshot& out) {
+        if (next == snapshots.size()) return false;
+        out = snapshots[next++];
+        return true;
+    });
+    pipeline_stats_ = pipeline.stats();
+    quote_cache_stats_ = qe.cache_stats();
+    final_var_ = risk.portfolio_var() ? risk.portfolio_var()->var() : 0.0;
 }
 
 std::vector<VenueBookSnapshot> BacktestRunner::load_csv_data(const std::string& filename) const {
@@ -0,0 +1,96 @@
+#include "market/book_signals.hpp"
+#include "util/cpu_features.hpp"
+
+#ifdef MME_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace mme {
+
+BookSignalSums compute_book_sums_scalar(const double* bid_px, const double* bid_qty,
+                                        const double* ask_px, const double* ask_qty,
+                                        size_t n, double best_bid, double best_ask) {
+    BookSignalSums s;
+    for (size_t i = 0; i < n; ++i) {
+        s.bid_qty      += bid_qty[i];
+        s.bid_notional += bid_px[i] * bid_qty[i];
+        s.ask_qty      += ask_qty[i];
+        s.ask_notional += ask_px[i] * ask_qty[i];
+        if (bid_px[i] == best_bid) s.bid_touch_qty += bid_qty[i];
+        if (ask_px[i] == best_ask) s.ask_touch_qty += ask_qty[i];
+    }
+    return s;
+}
+
+#ifdef MME_X86_DISPATCH
+
+namespace {
+
+__attribute__((target("avx2")))
+double hsum(__m256d v) {
+    __m128d lo = _mm256_castpd256_pd128(v);
+    __m128d hi = _mm256_extractf128_pd(v, 1);
+    lo = _mm_add_pd(lo, hi);
+    return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+}
+
+__attribute__((target("avx2")))
+BookSignalSums compute_book_sums_avx2(const double* bid_px, const double* bid_qty,
+                                      const double* ask_px, const double* ask_qty,
+                                      size_t n, double best_bid, double best_ask) {
+    __m256d bq = _mm256_setzero_pd(), bn = _mm256_setzero_pd();
+    __m256d aq = _mm256_setzero_pd(), an = _mm256_setzero_pd();
+    __m256d bt = _mm256_setzero_pd(), at = _mm256_setzero_pd();
+    const __m256d vbest_bid = _mm256_set1_pd(best_bid);
+    const __m256d vbest_ask = _mm256_set1_pd(best_ask);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d bp = _mm256_loadu_pd(bid_px + i);
+        __m256d bqi = _mm256_loadu_pd(bid_qty + i);
+        __m256d ap = _mm256_loadu_pd(ask_px + i);
+        __m256d aqi = _mm256_loadu_pd(ask_qty + i);
+
+        bq = _mm256_add_pd(bq, bqi);
+        bn = _mm256_add_pd(bn, _mm256_mul_pd(bp, bqi));
+        aq = _mm256_add_pd(aq, aqi);
+        an = _mm256_add_pd(an, _mm256_mul_pd(ap, aqi));
+
+        __m256d bmask = _mm256_cmp_pd(bp, vbest_bid, _CMP_EQ_OQ);
+        __m256d amask = _mm256_cmp_pd(ap, vbest_ask, _CMP_EQ_OQ);
+        bt = _mm256_add_pd(bt, _mm256_and_pd(bmask, bqi));
+        at = _mm256_add_pd(at, _mm256_and_pd(amask, aqi));
+    }
+
+    BookSignalSums s{hsum(bq), hsum(bn), hsum(aq), hsum(an), hsum(bt), hsum(at)};
+
+    if (i < n) {
+        BookSignalSums tail = compute_book_sums_scalar(bid_px + i, bid_qty + i,
+                                                       ask_px + i, ask_qty + i,
+                                                       n - i, best_bid, best_ask);
+        s.bid_qty       += tail.bid_qty;
+        s.bid_notional  += tail.bid_notional;
+        s.ask_qty       += tail.ask_qty;
+        s.ask_notional  += tail.ask_notional;
+        s.bid_touch_qty += tail.bid_touch_qty;
+        s.ask_touch_qty += tail.ask_touch_qty;
+    }
+    return s;
+}
+
+} // anonymous namespace
+
+#endif // MME_X86_DISPATCH
+
+BookSignalSums compute_book_sums(const double* bid_px, const double* bid_qty,
+                                 const double* ask_px, const double* ask_qty,
+                                 size_t n, double best_bid, double best_ask) {
+#ifdef MME_X86_DISPATCH
+    if (cpu_has_avx2()) {
+        return compute_book_sums_avx2(bid_px, bid_qty, ask_px, ask_qty, n, best_bid, best_ask);
+    }
+#endif
+    return compute_book_sums_scalar(bid_px, bid_qty, ask_px, ask_qty, n, best_bid, best_ask);
+}
+
+} // namespace mme
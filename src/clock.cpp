@@ -0,0 +1,75 @@
+#include "util/clock.hpp"
+
+#include <chrono>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <x86intrin.h>
+#define MME_HAVE_TSC 1
+#endif
+
+namespace mme {
+
+namespace {
+
+Timestamp steady_now() {
+    return static_cast<Timestamp>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+#ifdef MME_HAVE_TSC
+bool has_invariant_tsc() {
+    unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007) return false;
+    __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+    return (edx & (1u << 8)) != 0;
+}
+#endif
+
+} // anonymous namespace
+
+Timestamp SteadyClock::now() const {
+    return steady_now();
+}
+
+TscClock::TscClock(uint32_t calibration_ms) {
+#ifdef MME_HAVE_TSC
+    if (!has_invariant_tsc()) return;
+
+    uint64_t tsc0 = __rdtsc();
+    Timestamp ns0 = steady_now();
+    Timestamp target = ns0 + static_cast<Timestamp>(calibration_ms) * kNanosPerMilli;
+    Timestamp ns1 = ns0;
+    while (ns1 < target) ns1 = steady_now();
+    uint64_t tsc1 = __rdtsc();
+
+    if (tsc1 <= tsc0 || ns1 <= ns0) return;
+    ticks_per_ns_ = static_cast<double>(tsc1 - tsc0) / static_cast<double>(ns1 - ns0);
+    mult_ = static_cast<uint64_t>((static_cast<double>(ns1 - ns0) /
+                                   static_cast<double>(tsc1 - tsc0)) * 4294967296.0);
+    base_tsc_ = tsc1;
+    base_ns_ = ns1;
+    use_tsc_ = mult_ != 0;
+#else
+    (void)calibration_ms;
+#endif
+}
+
+Timestamp TscClock::now() const {
+#ifdef MME_HAVE_TSC
+    if (use_tsc_) {
+        uint64_t tsc = __rdtsc();
+        if (tsc <= base_tsc_) return base_ns_;   // guards a slightly lagging core
+        unsigned __int128 dt = static_cast<unsigned __int128>(tsc - base_tsc_) * mult_;
+        return base_ns_ + static_cast<Timestamp>(dt >> 32);
+    }
+#endif
+    return steady_now();
+}
+
+const Clock& default_clock() {
+    static const SteadyClock clock;
+    return clock;
+}
+
+} // namespace mme
@@ -0,0 +1,107 @@
+#include "config/config_watcher.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <system_error>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace mme {
+
+ConfigWatcher::ConfigWatcher(std::string path, std::function<void()> on_change, int poll_ms)
+    : path_(std::move(path)), on_change_(std::move(on_change)), poll_ms_(poll_ms) {}
+
+ConfigWatcher::~ConfigWatcher() { stop(); }
+
+bool ConfigWatcher::start() {
+    if (running()) return true;
+    stop_.store(false, std::memory_order_relaxed);
+
+#ifdef __linux__
+    std::filesystem::path dir = std::filesystem::path(path_).parent_path();
+    if (dir.empty()) dir = ".";
+
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ < 0) return false;
+    if (inotify_add_watch(inotify_fd_, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        close(inotify_fd_);
+        inotify_fd_ = -1;
+        return false;
+    }
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        close(inotify_fd_);
+        inotify_fd_ = -1;
+        return false;
+    }
+    thread_ = std::thread([this] { run_inotify(); });
+#else
+    std::error_code ec;
+    if (!std::filesystem::exists(std::filesystem::path(path_).parent_path(), ec)) return false;
+    thread_ = std::thread([this] { run_polling(); });
+#endif
+    return true;
+}
+
+void ConfigWatcher::stop() {
+    if (!running()) return;
+    stop_.store(true, std::memory_order_relaxed);
+#ifdef __linux__
+    uint64_t one = 1;
+    [[maybe_unused]] ssize_t n = write(wake_fd_, &one, sizeof(one));
+#endif
+    thread_.join();
+#ifdef __linux__
+    close(inotify_fd_);
+    close(wake_fd_);
+    inotify_fd_ = wake_fd_ = -1;
+#endif
+}
+
+void ConfigWatcher::run_inotify() {
+#ifdef __linux__
+    const std::string name = std::filesystem::path(path_).filename().string();
+    alignas(inotify_event) char buf[4096];
+
+    pollfd fds[2] = {{inotify_fd_, POLLIN, 0}, {wake_fd_, POLLIN, 0}};
+    while (!stop_.load(std::memory_order_relaxed)) {
+        if (poll(fds, 2, -1) < 0) continue;   // EINTR
+        if (fds[1].revents & POLLIN) break;
+        if (!(fds[0].revents & POLLIN)) continue;
+
+        // Several events for one save (e.g. write then rename) fire one callback
+        bool changed = false;
+        ssize_t len;
+        while ((len = read(inotify_fd_, buf, sizeof(buf))) > 0) {
+            for (ssize_t off = 0; off < len;) {
+                const auto* ev = reinterpret_cast<const inotify_event*>(buf + off);
+                if (ev->len > 0 && name == ev->name) changed = true;
+                off += static_cast<ssize_t>(sizeof(inotify_event) + ev->len);
+            }
+        }
+        if (changed) on_change_();
+    }
+#else
+    run_polling();
+#endif
+}
+
+void ConfigWatcher::run_polling() {
+    std::error_code ec;
+    auto last = std::filesystem::last_write_time(path_, ec);
+    while (!stop_.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(poll_ms_));
+        auto now = std::filesystem::last_write_time(path_, ec);
+        if (!ec && now != last) {
+            last = now;
+            on_change_();
+        }
+    }
+}
+
+} // namespace mme
@@ -0,0 +1,55 @@
+#include "risk/factor_exposure.hpp"
+
+#include <algorithm>
+
+namespace mme {
+
+FactorExposure::FactorExposure(const InstrumentRegistry& registry, size_t num_factors)
+    : registry_(registry),
+      k_(num_factors),
+      beta_(registry.size() * num_factors, 0.0),
+      norm_(registry.size(), 0.0),
+      exposure_(registry.size(), 0.0),
+      factors_(num_factors, 0.0) {}
+
+void FactorExposure::set_loadings_at(InstrumentIndex index, const std::vector<double>& loadings) {
+    if (index >= norm_.size()) return;
+    double* beta = beta_.data() + index * k_;
+    const double w = exposure_[index];
+    double norm = 0.0;
+    for (size_t k = 0; k < k_; ++k) {
+        const double b = k < loadings.size() ? loadings[k] : 0.0;
+        factors_[k] += (b - beta[k]) * w;
+        beta[k] = b;
+        norm += b * b;
+    }
+    norm_[index] = norm;
+}
+
+void FactorExposure::set_exposure_at(InstrumentIndex index, double exposure) {
+    if (index >= norm_.size()) return;
+    const double d = exposure - exposure_[index];
+    exposure_[index] = exposure;
+    if (d == 0.0 || norm_[index] == 0.0) return;
+    const double* beta = beta_.data() + index * k_;
+    for (size_t k = 0; k < k_; ++k) factors_[k] += beta[k] * d;
+}
+
+double FactorExposure::hedged_exposure_at(InstrumentIndex index) const {
+    if (index >= norm_.size()) return 0.0;
+    if (norm_[index] == 0.0) return exposure_[index];
+    const double* beta = beta_.data() + index * k_;
+    double proj = 0.0;
+    for (size_t k = 0; k < k_; ++k) proj += beta[k] * factors_[k];
+    return proj / norm_[index];
+}
+
+void FactorExposure::resync() {
+    std::fill(factors_.begin(), factors_.end(), 0.0);
+    for (size_t i = 0; i < exposure_.size(); ++i) {
+        const double* beta = beta_.data() + i * k_;
+        for (size_t k = 0; k < k_; ++k) factors_[k] += beta[k] * exposure_[i];
+    }
+}
+
+} // namespace mme
@@ -0,0 +1,38 @@
+#include "config/instrument_registry.hpp"
+
+namespace mme {
+
+InstrumentRegistry::InstrumentRegistry(const std::vector<InstrumentConfig>& instruments,
+                                       const std::vector<VenueConfig>& venues)
+    : by_id_(instruments.size()) {
+    venue_index_.fill(kNoVenue);
+    for (const auto& ic : instruments) add_instrument(ic.id, ic.symbol);
+    for (const auto& vc : venues) add_venue(vc.id);
+}
+
+InstrumentIndex InstrumentRegistry::add_instrument(InstrumentId id, std::string symbol) {
+    InstrumentIndex existing = index(id);
+    if (existing != kNoInstrument) return existing;
+
+    auto idx = static_cast<InstrumentIndex>(ids_.size());
+    ids_.push_back(id);
+    by_id_.insert(id, idx);
+    if (!symbol.empty()) by_symbol_.emplace(symbol, idx);
+    symbols_.push_back(std::move(symbol));
+    return idx;
+}
+
+VenueIndex InstrumentRegistry::add_venue(VenueId id) {
+    if (venue_index_[id] != kNoVenue) return venue_index_[id];
+    auto idx = static_cast<VenueIndex>(venue_ids_.size());
+    venue_ids_.push_back(id);
+    venue_index_[id] = idx;
+    return idx;
+}
+
+InstrumentIndex InstrumentRegistry::index(std::string_view symbol) const {
+    auto it = by_symbol_.find(std::string(symbol));
+    return it != by_symbol_.end() ? it->second : kNoInstrument;
+}
+
+} // namespace mme
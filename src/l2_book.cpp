@@ -0,0 +1,159 @@
+#include "market/l2_book.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace mme {
+
+// --- PriceLadder ---
+
+PriceLadder::PriceLadder(bool is_bid, size_t window)
+    : is_bid_(is_bid), qty_(window == 0 ? 1 : window, 0.0) {}
+
+void PriceLadder::set(int64_t tick, double qty) {
+    if (!in_window(tick)) {
+        // Past the window on the deep side: parked until the window reaches it
+        if (!empty() && !better(tick, best_)) {
+            if (qty > 0.0) {
+                overflow_[tick] = qty;
+            } else {
+                overflow_.erase(tick);
+            }
+            return;
+        }
+        if (qty <= 0.0) return; // nothing rests beyond the touch
+        // A new touch outside the window moves the window to it
+        recenter(tick);
+    }
+
+    double& slot_qty = qty_[slot(tick)];
+    bool was_set = slot_qty > 0.0;
+
+    if (qty > 0.0) {
+        slot_qty = qty;
+        if (!was_set) {
+            ++levels_;
+            if (levels_ == 1 || better(tick, best_)) best_ = tick;
+        }
+    } else if (was_set) {
+        slot_qty = 0.0;
+        --levels_;
+        if (tick == best_) rescan_best();
+    }
+}
+
+void PriceLadder::clear() {
+    std::fill(qty_.begin(), qty_.end(), 0.0);
+    overflow_.clear();
+    levels_ = 0;
+    best_ = 0;
+}
+
+double PriceLadder::quantity_at(int64_t tick) const {
+    if (in_window(tick)) return qty_[slot(tick)];
+    auto it = overflow_.find(tick);
+    return it != overflow_.end() ? it->second : 0.0;
+}
+
+void PriceLadder::recenter(int64_t tick) {
+    int64_t w = static_cast<int64_t>(qty_.size());
+    int64_t new_lo = tick - w / 2;
+    int64_t shift = new_lo - lo_;
+
+    // The ring is indexed by tick modulo the window, so only the slots whose
+    // ticks leave the window are touched; their levels are parked.
+    const int64_t leave_lo = shift > 0 ? lo_ : std::max(new_lo + w, lo_);
+    const int64_t leave_hi = shift > 0 ? std::min(new_lo, lo_ + w) : lo_ + w;
+    for (int64_t t = leave_lo; shift != 0 && t < leave_hi; ++t) {
+        double& q = qty_[slot(t)];
+        if (q > 0.0) {
+            overflow_[t] = q;
+            --levels_;
+            q = 0.0;
+        }
+    }
+    lo_ = new_lo;
+
+    // Parked levels the window now covers move back into the ring
+    for (auto it = overflow_.lower_bound(lo_); it != overflow_.end() && it->first < lo_ + w;) {
+        qty_[slot(it->first)] = it->second;
+        ++levels_;
+        it = overflow_.erase(it);
+    }
+
+    if (levels_ > 0 && !in_window(best_)) rescan_best();
+}
+
+void PriceLadder::rescan_best() {
+    if (levels_ == 0) {
+        if (overflow_.empty()) {
+            best_ = 0;
+            return;
+        }
+        // The ring emptied: the best parked level is the touch again
+        const int64_t t = is_bid_ ? overflow_.rbegin()->first : overflow_.begin()->first;
+        recenter(t);
+        best_ = t;
+        return;
+    }
+    int64_t w = static_cast<int64_t>(qty_.size());
+    int64_t step = is_bid_ ? -1 : 1;
+    int64_t t = in_window(best_) ? best_ : (is_bid_ ? lo_ + w - 1 : lo_);
+    for (; in_window(t); t += step) {
+        if (qty_[slot(t)] > 0.0) {
+            best_ = t;
+            return;
+        }
+    }
+}
+
+// --- L2Book ---
+
+L2Book::L2Book(double tick_size, size_t window_ticks)
+    : tick_size_(tick_size > 0.0 ? tick_size : 0.01),
+      bids_(true, window_ticks),
+      asks_(false, window_ticks) {}
+
+int64_t L2Book::to_tick(double price) const {
+    return static_cast<int64_t>(std::llround(price / tick_size_));
+}
+
+void L2Book::apply(const LevelUpdate& update) {
+    auto& ladder = (update.side == LevelSide::Bid) ? bids_ : asks_;
+    double qty = (update.action == LevelAction::Delete) ? 0.0 : update.quantity;
+    ladder.set(to_tick(update.price), qty);
+}
+
+void L2Book::clear() {
+    bids_.clear();
+    asks_.clear();
+}
+
+double L2Book::best_bid() const {
+    return bids_.empty() ? 0.0 : to_price(bids_.best());
+}
+
+double L2Book::best_ask() const {
+    return asks_.empty() ? std::numeric_limits<double>::max() : to_price(asks_.best());
+}
+
+double L2Book::depth(LevelSide side, size_t levels) const {
+    const auto& ladder = (side == LevelSide::Bid) ? bids_ : asks_;
+    double total = 0.0;
+    ladder.for_each_level(levels, [&](int64_t, double q) { total += q; });
+    return total;
+}
+
+void L2Book::to_snapshot(VenueBookSnapshot& out) const {
+    out.bids.clear();
+    out.asks.clear();
+    bids_.for_each_level(BookSide::capacity(), [&](int64_t t, double q) {
+        out.bids.push_back(BookLevel{to_price(t), q});
+    });
+    asks_.for_each_level(BookSide::capacity(), [&](int64_t t, double q) {
+        out.asks.push_back(BookLevel{to_price(t), q});
+    });
+}
+
+} // namespace mme
@@ -0,0 +1,217 @@
+#include "market/l3_book.hpp"
+#include "market/market_data_aggregator.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace mme {
+
+L3Book::L3Book(InstrumentId instrument, VenueId venue, double tick_size,
+               size_t expected_orders)
+    : instrument_(instrument),
+      venue_(venue),
+      tick_size_(tick_size > 0.0 ? tick_size : 0.01),
+      index_(expected_orders),
+      level_index_(1024),
+      bids_(true),
+      asks_(false) {
+    orders_.reserve(expected_orders);
+}
+
+bool L3Book::apply(const OrderMessage& msg) {
+    switch (msg.type) {
+        case OrderMessageType::Add:
+            return add(msg.order_id, msg.side, msg.price, msg.quantity);
+        case OrderMessageType::Execute:
+            return execute(msg.order_id, msg.quantity);
+        case OrderMessageType::Cancel:
+            return cancel(msg.order_id, msg.quantity);
+        case OrderMessageType::Replace:
+            return replace(msg.order_id, msg.new_order_id, msg.price, msg.quantity);
+    }
+    return false;
+}
+
+bool L3Book::add(uint64_t order_id, LevelSide side, double price, double quantity) {
+    if (quantity <= 0.0 || index_.find(order_id) != FlatIndexMap::kNotFound) return false;
+
+    int64_t tick = to_tick(price);
+    uint32_t idx = alloc_order();
+    uint32_t lvl_idx = acquire_level(side, tick);
+
+    Order& o = orders_[idx];
+    o = Order{.id = order_id, .tick = tick, .quantity = quantity,
+              .prev = kNil, .next = kNil, .level = lvl_idx, .side = side};
+
+    // Append to the level's FIFO
+    Level& lvl = levels_[lvl_idx];
+    o.prev = lvl.tail;
+    if (lvl.tail != kNil) {
+        orders_[lvl.tail].next = idx;
+    } else {
+        lvl.head = idx;
+    }
+    lvl.tail = idx;
+    ++lvl.count;
+    lvl.quantity += quantity;
+
+    ladder(side).set(tick, lvl.quantity);
+    index_.insert(order_id, idx);
+    return true;
+}
+
+bool L3Book::execute(uint64_t order_id, double quantity) {
+    uint32_t idx = index_.find(order_id);
+    if (idx == FlatIndexMap::kNotFound) return false;
+    reduce_order(idx, quantity);
+    return true;
+}
+
+bool L3Book::cancel(uint64_t order_id, double quantity) {
+    uint32_t idx = index_.find(order_id);
+    if (idx == FlatIndexMap::kNotFound) return false;
+    if (quantity <= 0.0) {
+        remove_order(idx);
+    } else {
+        reduce_order(idx, quantity);
+    }
+    return true;
+}
+
+bool L3Book::replace(uint64_t order_id, uint64_t new_order_id, double price, double quantity) {
+    uint32_t idx = index_.find(order_id);
+    if (idx == FlatIndexMap::kNotFound) return false;
+    // Validate before touching the book, so a rejected replace leaves the
+    // original order resting
+    if (quantity <= 0.0) return false;
+    if (new_order_id != order_id && index_.find(new_order_id) != FlatIndexMap::kNotFound) {
+        return false;
+    }
+    LevelSide side = orders_[idx].side;
+    remove_order(idx);
+    return add(new_order_id, side, price, quantity);
+}
+
+void L3Book::clear() {
+    orders_.clear();
+    free_orders_.clear();
+    levels_.clear();
+    free_levels_.clear();
+    index_.clear();
+    level_index_.clear();
+    bids_.clear();
+    asks_.clear();
+}
+
+double L3Book::best_bid() const {
+    return bids_.empty() ? 0.0 : to_price(bids_.best());
+}
+
+double L3Book::best_ask() const {
+    return asks_.empty() ? std::numeric_limits<double>::max() : to_price(asks_.best());
+}
+
+double L3Book::level_quantity(LevelSide side, double price) const {
+    uint32_t lvl = level_index_.find(level_key(side, to_tick(price)));
+    return (lvl != FlatIndexMap::kNotFound) ? levels_[lvl].quantity : 0.0;
+}
+
+uint32_t L3Book::level_order_count(LevelSide side, double price) const {
+    uint32_t lvl = level_index_.find(level_key(side, to_tick(price)));
+    return (lvl != FlatIndexMap::kNotFound) ? levels_[lvl].count : 0;
+}
+
+double L3Book::queue_ahead(uint64_t order_id) const {
+    uint32_t idx = index_.find(order_id);
+    if (idx == FlatIndexMap::kNotFound) return -1.0;
+    double ahead = 0.0;
+    for (uint32_t p = orders_[idx].prev; p != kNil; p = orders_[p].prev) {
+        ahead += orders_[p].quantity;
+    }
+    return ahead;
+}
+
+void L3Book::to_snapshot(VenueBookSnapshot& out) const {
+    out.instrument = instrument_;
+    out.venue = venue_;
+    out.bids.clear();
+    out.asks.clear();
+    bids_.for_each_level(BookSide::capacity(), [&](int64_t t, double q) {
+        out.bids.push_back(BookLevel{to_price(t), q});
+    });
+    asks_.for_each_level(BookSide::capacity(), [&](int64_t t, double q) {
+        out.asks.push_back(BookLevel{to_price(t), q});
+    });
+}
+
+void L3Book::publish(MarketDataAggregator& md) const {
+    VenueBookSnapshot snap;
+    to_snapshot(snap);
+    md.on_book_update(snap);
+}
+
+int64_t L3Book::to_tick(double price) const {
+    return static_cast<int64_t>(std::llround(price / tick_size_));
+}
+
+uint32_t L3Book::alloc_order() {
+    if (!free_orders_.empty()) {
+        uint32_t idx = free_orders_.back();
+        free_orders_.pop_back();
+        return idx;
+    }
+    orders_.emplace_back();
+    return static_cast<uint32_t>(orders_.size() - 1);
+}
+
+uint32_t L3Book::acquire_level(LevelSide side, int64_t tick) {
+    uint64_t key = level_key(side, tick);
+    uint32_t idx = level_index_.find(key);
+    if (idx != FlatIndexMap::kNotFound) return idx;
+
+    if (!free_levels_.empty()) {
+        idx = free_levels_.back();
+        free_levels_.pop_back();
+        levels_[idx] = Level{};
+    } else {
+        levels_.emplace_back();
+        idx = static_cast<uint32_t>(levels_.size() - 1);
+    }
+    level_index_.insert(key, idx);
+    return idx;
+}
+
+void L3Book::reduce_order(uint32_t idx, double quantity) {
+    Order& o = orders_[idx];
+    if (quantity >= o.quantity - 1e-12) {
+        remove_order(idx);
+        return;
+    }
+    o.quantity -= quantity;
+    Level& lvl = levels_[o.level];
+    lvl.quantity -= quantity;
+    ladder(o.side).set(o.tick, lvl.quantity);
+}
+
+void L3Book::remove_order(uint32_t idx) {
+    Order& o = orders_[idx];
+    Level& lvl = levels_[o.level];
+
+    if (o.prev != kNil) orders_[o.prev].next = o.next; else lvl.head = o.next;
+    if (o.next != kNil) orders_[o.next].prev = o.prev; else lvl.tail = o.prev;
+    --lvl.count;
+    lvl.quantity -= o.quantity;
+
+    if (lvl.count == 0) {
+        level_index_.erase(level_key(o.side, o.tick));
+        free_levels_.push_back(o.level);
+        ladder(o.side).set(o.tick, 0.0);
+    } else {
+        ladder(o.side).set(o.tick, lvl.quantity);
+    }
+
+    index_.erase(o.id);
+    free_orders_.push_back(idx);
+}
+
+} // namespace mme
@@ -1,4 +1,5 @@
 #include "backtest/backtest_runner.hpp"
+#include "config/config_watcher.hpp"
 #include "config/instrument_config.hpp"
 #include "config/venue_config.hpp"
 #include "strategy/market_making_params.hpp"
@@ -147,6 +148,27 @@ private:
     }
 };
 
+mme::VolatilityEstimator parse_volatility_estimator(const std::string& name) {
+    if (name == "ewma_slow")  return mme::VolatilityEstimator::EwmaSlow;
+    if (name == "ewma_fast")  return mme::VolatilityEstimator::EwmaFast;
+    if (name == "ewma_burst") return mme::VolatilityEstimator::EwmaBurst;
+    if (name == "realized")   return mme::VolatilityEstimator::Realized;
+    if (name == "range")      return mme::VolatilityEstimator::Range;
+    return mme::VolatilityEstimator::Ewma;
+}
+
+mme::FairPrice parse_fair_price(const std::string& name) {
+    if (name == "microprice")   return mme::FairPrice::Microprice;
+    if (name == "weighted_mid") return mme::FairPrice::WeightedMid;
+    return mme::FairPrice::Mid;
+}
+
+mme::WaitStrategy parse_wait_strategy(const std::string& name) {
+    if (name == "busy_poll") return mme::WaitStrategy::BusyPoll;
+    if (name == "blocking")  return mme::WaitStrategy::Blocking;
+    return mme::WaitStrategy::Yield;
+}
+
 mme::BacktestConfig load_config(const std::string& path) {
     std::ifstream f(path);
     std::string content((std::istreambuf_iterator<char>(f)),
@@ -167,6 +189,9 @@ mme::BacktestConfig load_config(const std::string& path) {
             ic.lot_size = inst.get_number("lot_size", 1.0);
             ic.base_spread_bp = inst.get_number("base_spread_bp", 10.0);
             ic.inventory_limit = inst.get_number("inventory_limit", 100.0);
+            if (auto* betas = inst.get_array("factor_loadings")) {
+                for (const auto& b : betas->arr) ic.factor_loadings.push_back(b.number);
+            }
             config.instruments.push_back(ic);
 
             // Build params from instrument config + defaults
@@ -177,14 +202,24 @@ mme::BacktestConfig load_config(const std::string& path) {
                 params.max_spread_bp = p->get_number("max_spread_bp", 50.0);
                 params.volatility_coeff = p->get_number("volatility_coeff", 1.0);
                 params.inventory_coeff = p->get_number("inventory_coeff", 0.5);
+                params.factor_skew_weight = p->get_number("factor_skew_weight", 0.0);
                 params.size_base = p->get_number("size_base", 1.0);
                 params.size_inventory_scale = p->get_number("size_inventory_scale", 0.5);
                 params.quote_refresh_ms = p->get_number("quote_refresh_ms", 100.0);
                 params.max_position = p->get_number("max_position", ic.inventory_limit);
+                params.requote_min_ticks = p->get_number("requote_min_ticks", 1.0);
+                params.requote_size_tolerance = p->get_number("requote_size_tolerance", 0.1);
+                params.quote_cache_vol_bucket = p->get_number("quote_cache_vol_bucket", 0.0);
+                params.max_order_rate = p->get_number("max_order_rate", 0.0);
+                params.volatility_estimator =
+                    parse_volatility_estimator(p->get_string("volatility_estimator", "ewma"));
+                params.fair_price = parse_fair_price(p->get_string("fair_price", "mid"));
             } else {
                 params.base_spread_bp = ic.base_spread_bp;
                 params.max_position = ic.inventory_limit;
             }
+            params.tick_size = ic.tick_size;
+            params.lot_size = ic.lot_size;
             config.params[ic.id] = params;
         }
     }
@@ -206,6 +241,26 @@ mme::BacktestConfig load_config(const std::string& path) {
     config.data_file = root.get_string("data_file");
     config.fill_probability = root.get_number("fill_probability", 0.3);
 
+    if (auto* r = root.get_object("risk")) {
+        config.risk_limits.max_gross_notional = r->get_number("max_gross_notional", 0.0);
+        config.risk_limits.max_net_exposure = r->get_number("max_net_exposure", 0.0);
+        config.risk_limits.max_var = r->get_number("max_var", 0.0);
+        config.var.lambda = r->get_number("var_lambda", config.var.lambda);
+        config.var.confidence_z = r->get_number("var_confidence_z", config.var.confidence_z);
+        config.var.horizon_samples = r->get_number("var_horizon_samples", config.var.horizon_samples);
+        config.var.sample_interval = mme::ms_to_ns(r->get_number("var_sample_ms", 1000.0));
+    }
+
+    if (auto* p = root.get_object("pipeline")) {
+        config.pipeline.wait = parse_wait_strategy(p->get_string("wait", "yield"));
+        config.pipeline.feed_cpu = static_cast<int>(p->get_number("feed_cpu", -1));
+        config.pipeline.strategy_cpu = static_cast<int>(p->get_number("strategy_cpu", -1));
+        config.pipeline.gateway_cpu = static_cast<int>(p->get_number("gateway_cpu", -1));
+        config.pipeline.queue_capacity =
+            static_cast<size_t>(p->get_number("queue_capacity", 4096));
+        config.pipeline.conflate = p->get_number("conflate", 0) != 0;
+    }
+
     return config;
 }
 
@@ -215,6 +270,8 @@ int main(int argc, char* argv[]) {
     std::string config_path = "data/config.json";
     bool synthetic = true;
     size_t num_ticks = 10000;
+    bool pipelined = false;
+    bool watch = false;
 
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
@@ -224,11 +281,17 @@ int main(int argc, char* argv[]) {
             num_ticks = std::stoull(argv[++i]);
         } else if (arg == "--data") {
             synthetic = false;
+        } else if (arg == "--pipeline") {
+            pipelined = true;
+        } else if (arg == "--watch") {
+            watch = true;
         } else if (arg == "--help") {
             std::cout << "Usage: market_maker [options]\n"
                       << "  --config <path>  Config file (default: data/config.json)\n"
                       << "  --ticks <n>      Number of synthetic ticks (default: 10000)\n"
                       << "  --data           Use CSV data from config instead of synthetic\n"
+                      << "  --pipeline       Run feed/strategy/gateway stages on separate threads\n"
+                      << "  --watch          Reload strategy params when the config file changes\n"
                       << "  --help           Show this help\n";
             return 0;
         }
@@ -236,9 +299,25 @@ int main(int argc, char* argv[]) {
 
     std::cout << "Loading config from: " << config_path << "\n";
     auto config = load_config(config_path);
+    config.pipelined = pipelined;
 
     mme::BacktestRunner runner(config);
 
+    // Only the per-instrument params are reloaded; everything else in the
+    // file is read once at startup
+    mme::ConfigWatcher watcher(config_path, [&] {
+        auto reloaded = load_config(config_path);
+        std::string error;
+        if (runner.param_store().publish(reloaded.params, &error)) {
+            std::cout << "Params reloaded, version " << runner.param_store().version() << "\n";
+        } else {
+            std::cerr << "Params reload rejected: " << error << "\n";
+        }
+    });
+    if (watch && !watcher.start()) {
+        std::cerr << "Cannot watch " << config_path << "\n";
+    }
+
     if (synthetic) {
         std::cout << "Running synthetic backtest with " << num_ticks << " ticks, "
                   << config.params.size() << " instruments, "
@@ -254,6 +333,25 @@ int main(int argc, char* argv[]) {
     runner.write_csv("data/backtest_results.csv");
 
     std::cout << "\n" << runner.metrics().generate_report();
+
+    if (pipelined) {
+        const auto& ps = runner.pipeline_stats();
+        const auto& lat = ps.tick_to_order;
+        std::cout << "\nPipeline: " << ps.ticks_handled << " ticks, " << ps.commands
+                  << " order actions, " << ps.fills << " fills, stalls feed/strategy "
+                  << ps.feed_stalls << "/" << ps.strategy_stalls << "\n"
+                  << "Tick-to-order (ns): min " << lat.min_ns << "  p50 " << lat.p50_ns
+                  << "  p99 " << lat.p99_ns << "  max " << lat.max_ns
+                  << "  mean " << static_cast<uint64_t>(lat.mean_ns) << "\n";
+    }
+    const auto& cache = runner.quote_cache_stats();
+    if (cache.hits + cache.misses > 0) {
+        std::cout << "\nQuote cache: " << cache.hits << " hits, " << cache.misses
+                  << " misses, hit rate " << cache.hit_rate() << "\n";
+    }
+    if (runner.final_var() > 0.0) {
+        std::cout << "\nPortfolio VaR: " << runner.final_var() << "\n";
+    }
     std::cout << "\nResults written to REPORT.md and data/backtest_results.csv\n";
 
     return 0;
@@ -1,4 +1,5 @@
 #include "market/market_data_aggregator.hpp"
+#include "market/book_signals.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -8,101 +9,219 @@
 namespace mme {
 
 MarketDataAggregator::MarketDataAggregator(double ewma_alpha)
-    : ewma_alpha_(ewma_alpha) {}
-
-void MarketDataAggregator::on_book_update(const VenueBookSnapshot& snapshot) {
-    auto& state = states_[snapshot.instrument];
-    state.view.id = snapshot.instrument;
-
-    // Update or add venue snapshot
-    bool found = false;
-    for (auto& vs : state.view.venues) {
-        if (vs.venue == snapshot.venue) {
-            vs = snapshot;
-            found = true;
+    : ewma_alphas_{ewma_alpha, kSlowEwmaAlpha, kFastEwmaAlpha, kBurstEwmaAlpha} {}
+
+MarketDataAggregator::MarketDataAggregator(const std::array<double, kNumEwmaHorizons>& ewma_alphas)
+    : ewma_alphas_(ewma_alphas) {}
+
+InstrumentIndex MarketDataAggregator::index_for(InstrumentId id) {
+    InstrumentIndex index = registry_.index(id);
+    if (index != kNoInstrument) return index;
+    index = registry_.add_instrument(id);
+    states_.emplace_back(ewma_alphas_);
+    states_.back().view.id = id;
+    return index;
+}
+
+bool MarketDataAggregator::add_instruments(const InstrumentRegistry& registry) {
+    bool aligned = true;
+    for (InstrumentIndex i = 0; i < registry.size(); ++i) {
+        aligned &= index_for(registry.id(i)) == i;
+    }
+    return aligned;
+}
+
+BookChange MarketDataAggregator::on_book_update(const VenueBookSnapshot& snapshot) {
+    return on_book_update_at(index_for(snapshot.instrument), snapshot);
+}
+
+BookChange MarketDataAggregator::on_book_update_at(InstrumentIndex index,
+                                                   const VenueBookSnapshot& snapshot) {
+    auto& state = states_[index];
+    state.has_data = true;
+
+    // Locate or add the venue slot
+    size_t slot = state.view.venues.size();
+    for (size_t i = 0; i < state.view.venues.size(); ++i) {
+        if (state.view.venues[i].venue == snapshot.venue) {
+            slot = i;
             break;
         }
     }
-    if (!found) {
+    if (slot == state.view.venues.size()) {
         state.view.venues.push_back(snapshot);
+        state.tops.push_back(VenueTop{});
+        size_t n = state.view.venues.size() * kMaxBookDepth;
+        state.bid_px.resize(n, 0.0);
+        state.bid_qty.resize(n, 0.0);
+        state.ask_px.resize(n, 0.0);
+        state.ask_qty.resize(n, 0.0);
+    } else {
+        auto& vs = state.view.venues[slot];
+        if (vs.bids == snapshot.bids && vs.asks == snapshot.asks) {
+            return BookChange::Unchanged;
+        }
+        vs = snapshot;
     }
 
-    rebuild_aggregate(state);
+    write_depth(state, slot, snapshot);
 
-    if (state.view.mid_price > 0.0) {
+    VenueTop old_top = state.tops[slot];
+    VenueTop new_top = venue_top(snapshot);
+    state.tops[slot] = new_top;
+    ++state.view.version;
+    state.view.weighted_depth += new_top.depth - old_top.depth;
+
+    // Consolidated touch: an improvement is taken directly; only a venue
+    // that was at the touch and backed off forces a rescan of cached bests.
+    double prev_bid = state.best_bid;
+    double prev_ask = state.best_ask;
+    bool rescan = false;
+
+    if (new_top.best_bid >= state.best_bid) {
+        state.best_bid = new_top.best_bid;
+    } else if (old_top.best_bid == state.best_bid) {
+        rescan = true;
+    }
+    if (new_top.best_ask <= state.best_ask) {
+        state.best_ask = new_top.best_ask;
+    } else if (old_top.best_ask == state.best_ask) {
+        rescan = true;
+    }
+    if (rescan) {
+        rescan_touch(state);
+    }
+
+    update_signals(state);
+
+    if (state.best_bid == prev_bid && state.best_ask == prev_ask) {
+        return BookChange::BookChanged;
+    }
+
+    if (state.best_bid > 0.0 && state.best_ask < std::numeric_limits<double>::max()) {
+        state.view.mid_price = (state.best_bid + state.best_ask) / 2.0;
+        state.view.spread = state.best_ask - state.best_bid;
         update_volatility(state, state.view.mid_price);
     }
+    return BookChange::TouchChanged;
 }
 
-InstrumentMarketView MarketDataAggregator::get_view(InstrumentId id) const {
-    auto it = states_.find(id);
-    if (it == states_.end()) {
-        return InstrumentMarketView{.id = id};
+BookChange MarketDataAggregator::on_level_update(const LevelUpdate& update) {
+    InstrumentIndex index = index_for(update.instrument);
+    auto& state = states_[index];
+
+    L2Book* book = nullptr;
+    for (auto& vb : state.l2_books) {
+        if (vb.venue == update.venue) {
+            book = &vb.book;
+            break;
+        }
+    }
+    if (book == nullptr) {
+        auto tick_it = tick_sizes_.find(update.instrument);
+        double tick = (tick_it != tick_sizes_.end()) ? tick_it->second : kDefaultTickSize;
+        state.l2_books.push_back(VenueL2{update.venue, L2Book(tick)});
+        book = &state.l2_books.back().book;
     }
-    return it->second.view;
+
+    book->apply(update);
+
+    scratch_snapshot_.instrument = update.instrument;
+    scratch_snapshot_.venue = update.venue;
+    book->to_snapshot(scratch_snapshot_);
+    return on_book_update_at(index, scratch_snapshot_);
 }
 
-bool MarketDataAggregator::has_view(InstrumentId id) const {
-    return states_.count(id) > 0;
+void MarketDataAggregator::set_tick_size(InstrumentId id, double tick_size) {
+    tick_sizes_[id] = tick_size;
 }
 
-void MarketDataAggregator::rebuild_aggregate(InstrumentState& state) {
-    double global_best_bid = 0.0;
-    double global_best_ask = std::numeric_limits<double>::max();
-    double total_depth = 0.0;
+const L2Book* MarketDataAggregator::find_l2_book(InstrumentId id, VenueId venue) const {
+    InstrumentIndex index = registry_.index(id);
+    if (index == kNoInstrument) return nullptr;
+    for (const auto& vb : states_[index].l2_books) {
+        if (vb.venue == venue) return &vb.book;
+    }
+    return nullptr;
+}
 
-    for (const auto& vs : state.view.venues) {
-        if (!vs.bids.empty()) {
-            global_best_bid = std::max(global_best_bid, vs.best_bid());
-        }
-        if (!vs.asks.empty()) {
-            global_best_ask = std::min(global_best_ask, vs.best_ask());
-        }
+InstrumentMarketView MarketDataAggregator::get_view(InstrumentId id) const {
+    if (const InstrumentMarketView* view = find_view(id)) return *view;
+    InstrumentMarketView empty;
+    empty.id = id;
+    return empty;
+}
 
-        // Weighted depth: sum of top-3 levels' quantity across venues
-        for (size_t i = 0; i < std::min(vs.bids.size(), size_t(3)); ++i) {
-            total_depth += vs.bids[i].quantity;
-        }
-        for (size_t i = 0; i < std::min(vs.asks.size(), size_t(3)); ++i) {
-            total_depth += vs.asks[i].quantity;
-        }
-    }
+bool MarketDataAggregator::has_view(InstrumentId id) const {
+    return find_view(id) != nullptr;
+}
 
-    if (global_best_bid > 0.0 && global_best_ask < std::numeric_limits<double>::max()) {
-        state.view.mid_price = (global_best_bid + global_best_ask) / 2.0;
-        state.view.spread = global_best_ask - global_best_bid;
-    }
+MarketDataAggregator::VenueTop MarketDataAggregator::venue_top(const VenueBookSnapshot& vs) {
+    VenueTop top;
+    if (!vs.bids.empty()) top.best_bid = vs.best_bid();
+    if (!vs.asks.empty()) top.best_ask = vs.best_ask();
 
-    state.view.weighted_depth = total_depth;
-    state.view.volatility = std::sqrt(state.ewma_variance);
+    // Weighted depth: sum of top-3 levels' quantity
+    for (size_t i = 0; i < std::min(vs.bids.size(), size_t(3)); ++i) {
+        top.depth += vs.bids[i].quantity;
+    }
+    for (size_t i = 0; i < std::min(vs.asks.size(), size_t(3)); ++i) {
+        top.depth += vs.asks[i].quantity;
+    }
+    return top;
 }
 
-void MarketDataAggregator::update_volatility(InstrumentState& state, double new_mid) {
-    state.mid_history.push_back(new_mid);
-    if (state.mid_history.size() > kMaxMidHistory) {
-        state.mid_history.pop_front();
+void MarketDataAggregator::rescan_touch(InstrumentState& state) {
+    state.best_bid = 0.0;
+    state.best_ask = std::numeric_limits<double>::max();
+    for (const auto& top : state.tops) {
+        state.best_bid = std::max(state.best_bid, top.best_bid);
+        state.best_ask = std::min(state.best_ask, top.best_ask);
     }
+}
 
-    if (state.mid_history.size() < 2) {
-        return;
+void MarketDataAggregator::write_depth(InstrumentState& state, size_t slot,
+                                       const VenueBookSnapshot& vs) {
+    size_t base = slot * kMaxBookDepth;
+    for (size_t i = 0; i < kMaxBookDepth; ++i) {
+        bool has_bid = i < vs.bids.size();
+        bool has_ask = i < vs.asks.size();
+        state.bid_px[base + i]  = has_bid ? vs.bids[i].price : 0.0;
+        state.bid_qty[base + i] = has_bid ? vs.bids[i].quantity : 0.0;
+        state.ask_px[base + i]  = has_ask ? vs.asks[i].price : 0.0;
+        state.ask_qty[base + i] = has_ask ? vs.asks[i].quantity : 0.0;
     }
+}
+
+void MarketDataAggregator::update_signals(InstrumentState& state) {
+    auto& view = state.view;
+    BookSignalSums s = compute_book_sums(state.bid_px.data(), state.bid_qty.data(),
+                                         state.ask_px.data(), state.ask_qty.data(),
+                                         state.bid_px.size(), state.best_bid, state.best_ask);
 
-    // Compute log return
-    double prev = state.mid_history[state.mid_history.size() - 2];
-    if (prev <= 0.0) return;
+    double total = s.bid_qty + s.ask_qty;
+    view.imbalance = (total > 0.0) ? (s.bid_qty - s.ask_qty) / total : 0.0;
 
-    double log_return = std::log(new_mid / prev);
+    if (s.bid_qty > 0.0 && s.ask_qty > 0.0) {
+        view.weighted_mid = (s.bid_notional / s.bid_qty + s.ask_notional / s.ask_qty) / 2.0;
+    } else {
+        view.weighted_mid = 0.0;
+    }
 
-    if (!state.initialized) {
-        state.ewma_variance = log_return * log_return;
-        state.initialized = true;
+    // Microprice leans towards the side with less quantity at the touch
+    double touch = s.bid_touch_qty + s.ask_touch_qty;
+    if (s.bid_touch_qty > 0.0 && s.ask_touch_qty > 0.0) {
+        view.microprice = (state.best_bid * s.ask_touch_qty
+                         + state.best_ask * s.bid_touch_qty) / touch;
     } else {
-        // EWMA: variance_t = alpha * r_t^2 + (1 - alpha) * variance_{t-1}
-        state.ewma_variance = ewma_alpha_ * (log_return * log_return)
-                            + (1.0 - ewma_alpha_) * state.ewma_variance;
+        view.microprice = 0.0;
     }
+}
 
-    state.view.volatility = std::sqrt(state.ewma_variance);
+void MarketDataAggregator::update_volatility(InstrumentState& state, double new_mid) {
+    state.vol.on_mid(new_mid);
+    state.view.vol_estimates = state.vol.estimates();
+    state.view.volatility = state.view.vol_estimates.ewma[0];
 }
 
 } // namespace mme
@@ -0,0 +1,235 @@
+#include "risk/matrix_kernels.hpp"
+#include "util/cpu_features.hpp"
+
+#ifdef MME_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace mme {
+
+namespace {
+
+double dot_scalar(const double* x, const double* y, size_t n) {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) sum += x[i] * y[i];
+    return sum;
+}
+
+void axpy_scalar(double a, const double* x, double* y, size_t n) {
+    for (size_t i = 0; i < n; ++i) y[i] += a * x[i];
+}
+
+void gemv_scalar(const double* a, size_t stride, size_t n, const double* x, double* y) {
+    size_t r = 0;
+    for (; r + 4 <= n; r += 4) {
+        const double* a0 = a + r * stride;
+        const double* a1 = a0 + stride;
+        const double* a2 = a1 + stride;
+        const double* a3 = a2 + stride;
+        double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+        for (size_t c = 0; c < n; ++c) {
+            s0 += a0[c] * x[c];
+            s1 += a1[c] * x[c];
+            s2 += a2[c] * x[c];
+            s3 += a3[c] * x[c];
+        }
+        y[r] = s0;
+        y[r + 1] = s1;
+        y[r + 2] = s2;
+        y[r + 3] = s3;
+    }
+    for (; r < n; ++r) y[r] = dot_scalar(a + r * stride, x, n);
+}
+
+#ifdef MME_X86_DISPATCH
+
+// --- AVX2: 4 lanes ---
+
+__attribute__((target("avx2")))
+inline double hsum(__m256d v) {
+    __m128d lo = _mm256_castpd256_pd128(v);
+    __m128d hi = _mm256_extractf128_pd(v, 1);
+    lo = _mm_add_pd(lo, hi);
+    return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+}
+
+__attribute__((target("avx2")))
+double dot_avx2(const double* x, const double* y, size_t n) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_loadu_pd(x + i + 4),
+                                                 _mm256_loadu_pd(y + i + 4)));
+    }
+    double sum = hsum(_mm256_add_pd(acc0, acc1));
+    for (; i < n; ++i) sum += x[i] * y[i];
+    return sum;
+}
+
+__attribute__((target("avx2")))
+void axpy_avx2(double a, const double* x, double* y, size_t n) {
+    const __m256d va = _mm256_set1_pd(a);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d vy = _mm256_add_pd(_mm256_loadu_pd(y + i),
+                                   _mm256_mul_pd(va, _mm256_loadu_pd(x + i)));
+        _mm256_storeu_pd(y + i, vy);
+    }
+    for (; i < n; ++i) y[i] += a * x[i];
+}
+
+__attribute__((target("avx2")))
+void gemv_avx2(const double* a, size_t stride, size_t n, const double* x, double* y) {
+    size_t r = 0;
+    for (; r + 4 <= n; r += 4) {
+        const double* a0 = a + r * stride;
+        const double* a1 = a0 + stride;
+        const double* a2 = a1 + stride;
+        const double* a3 = a2 + stride;
+        __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+        __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+        size_t c = 0;
+        for (; c + 4 <= n; c += 4) {
+            __m256d vx = _mm256_loadu_pd(x + c);
+            s0 = _mm256_add_pd(s0, _mm256_mul_pd(_mm256_loadu_pd(a0 + c), vx));
+            s1 = _mm256_add_pd(s1, _mm256_mul_pd(_mm256_loadu_pd(a1 + c), vx));
+            s2 = _mm256_add_pd(s2, _mm256_mul_pd(_mm256_loadu_pd(a2 + c), vx));
+            s3 = _mm256_add_pd(s3, _mm256_mul_pd(_mm256_loadu_pd(a3 + c), vx));
+        }
+        double t0 = hsum(s0), t1 = hsum(s1), t2 = hsum(s2), t3 = hsum(s3);
+        for (; c < n; ++c) {
+            t0 += a0[c] * x[c];
+            t1 += a1[c] * x[c];
+            t2 += a2[c] * x[c];
+            t3 += a3[c] * x[c];
+        }
+        y[r] = t0;
+        y[r + 1] = t1;
+        y[r + 2] = t2;
+        y[r + 3] = t3;
+    }
+    for (; r < n; ++r) y[r] = dot_avx2(a + r * stride, x, n);
+}
+
+// --- AVX-512: 8 lanes ---
+
+// Horizontal sum via the AVX2 one. _mm512_reduce_add_pd (and even
+// _mm512_castpd512_pd256) extract through _mm512_undefined_pd() in GCC 12,
+// which trips -Wmaybe-uninitialized; the zero-masked extract does not.
+__attribute__((target("avx512f")))
+inline double hsum(__m512d v) {
+    return hsum(_mm256_add_pd(_mm512_maskz_extractf64x4_pd(0xFF, v, 0),
+                              _mm512_maskz_extractf64x4_pd(0xFF, v, 1)));
+}
+
+__attribute__((target("avx512f")))
+double dot_avx512(const double* x, const double* y, size_t n) {
+    __m512d acc = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc = _mm512_add_pd(acc, _mm512_mul_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i)));
+    }
+    double sum = hsum(acc);
+    for (; i < n; ++i) sum += x[i] * y[i];
+    return sum;
+}
+
+__attribute__((target("avx512f")))
+void axpy_avx512(double a, const double* x, double* y, size_t n) {
+    const __m512d va = _mm512_set1_pd(a);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d vy = _mm512_add_pd(_mm512_loadu_pd(y + i),
+                                   _mm512_mul_pd(va, _mm512_loadu_pd(x + i)));
+        _mm512_storeu_pd(y + i, vy);
+    }
+    for (; i < n; ++i) y[i] += a * x[i];
+}
+
+__attribute__((target("avx512f")))
+void gemv_avx512(const double* a, size_t stride, size_t n, const double* x, double* y) {
+    size_t r = 0;
+    for (; r + 4 <= n; r += 4) {
+        const double* a0 = a + r * stride;
+        const double* a1 = a0 + stride;
+        const double* a2 = a1 + stride;
+        const double* a3 = a2 + stride;
+        __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+        __m512d s2 = _mm512_setzero_pd(), s3 = _mm512_setzero_pd();
+        size_t c = 0;
+        for (; c + 8 <= n; c += 8) {
+            __m512d vx = _mm512_loadu_pd(x + c);
+            s0 = _mm512_add_pd(s0, _mm512_mul_pd(_mm512_loadu_pd(a0 + c), vx));
+            s1 = _mm512_add_pd(s1, _mm512_mul_pd(_mm512_loadu_pd(a1 + c), vx));
+            s2 = _mm512_add_pd(s2, _mm512_mul_pd(_mm512_loadu_pd(a2 + c), vx));
+            s3 = _mm512_add_pd(s3, _mm512_mul_pd(_mm512_loadu_pd(a3 + c), vx));
+        }
+        double t0 = hsum(s0), t1 = hsum(s1);
+        double t2 = hsum(s2), t3 = hsum(s3);
+        for (; c < n; ++c) {
+            t0 += a0[c] * x[c];
+            t1 += a1[c] * x[c];
+            t2 += a2[c] * x[c];
+            t3 += a3[c] * x[c];
+        }
+        y[r] = t0;
+        y[r + 1] = t1;
+        y[r + 2] = t2;
+        y[r + 3] = t3;
+    }
+    for (; r < n; ++r) y[r] = dot_avx512(a + r * stride, x, n);
+}
+
+#endif // MME_X86_DISPATCH
+
+} // anonymous namespace
+
+MatrixKernel best_matrix_kernel() {
+    if (cpu_has_avx512f()) return MatrixKernel::Avx512;
+    if (cpu_has_avx2()) return MatrixKernel::Avx2;
+    return MatrixKernel::Scalar;
+}
+
+double dot(const double* x, const double* y, size_t n, MatrixKernel kernel) {
+#ifdef MME_X86_DISPATCH
+    if (kernel == MatrixKernel::Avx512 && cpu_has_avx512f()) return dot_avx512(x, y, n);
+    if (kernel == MatrixKernel::Avx2 && cpu_has_avx2()) return dot_avx2(x, y, n);
+#endif
+    (void)kernel;
+    return dot_scalar(x, y, n);
+}
+
+void axpy(double a, const double* x, double* y, size_t n, MatrixKernel kernel) {
+#ifdef MME_X86_DISPATCH
+    if (kernel == MatrixKernel::Avx512 && cpu_has_avx512f()) {
+        axpy_avx512(a, x, y, n);
+        return;
+    }
+    if (kernel == MatrixKernel::Avx2 && cpu_has_avx2()) {
+        axpy_avx2(a, x, y, n);
+        return;
+    }
+#endif
+    (void)kernel;
+    axpy_scalar(a, x, y, n);
+}
+
+void gemv(const double* a, size_t stride, size_t n, const double* x, double* y,
+          MatrixKernel kernel) {
+#ifdef MME_X86_DISPATCH
+    if (kernel == MatrixKernel::Avx512 && cpu_has_avx512f()) {
+        gemv_avx512(a, stride, n, x, y);
+        return;
+    }
+    if (kernel == MatrixKernel::Avx2 && cpu_has_avx2()) {
+        gemv_avx2(a, stride, n, x, y);
+        return;
+    }
+#endif
+    (void)kernel;
+    gemv_scalar(a, stride, n, x, y);
+}
+
+} // namespace mme
@@ -9,21 +9,31 @@
 
 namespace mme {
 
+MetricsCollector::InstrumentSeries& MetricsCollector::series_for(InstrumentId id) {
+    InstrumentIndex index = registry_.index(id);
+    if (index == kNoInstrument) {
+        index = registry_.add_instrument(id);
+        series_.emplace_back();
+    }
+    return series_[index];
+}
+
 void MetricsCollector::record_tick(const TickMetric& metric) {
-    ticks_[metric.instrument].push_back(metric);
+    series_for(metric.instrument).ticks.push_back(metric);
 }
 
 void MetricsCollector::record_fill(InstrumentId id, double spread_captured) {
-    fill_counts_[id]++;
-    spread_captures_[id].push_back(spread_captured);
+    auto& s = series_for(id);
+    ++s.fills;
+    s.spread_captures.push_back(spread_captured);
 }
 
 void MetricsCollector::record_quote(InstrumentId id) {
-    quote_counts_[id]++;
+    ++series_for(id).quotes;
 }
 
 void MetricsCollector::record_cancel(InstrumentId id) {
-    cancel_counts_[id]++;
+    ++series_for(id).cancels;
 }
 
 void MetricsCollector::record_exposure(double exposure) {
@@ -34,10 +44,11 @@ InstrumentMetrics MetricsCollector::compute_instrument_metrics(InstrumentId id)
     InstrumentMetrics m;
     m.id = id;
 
-    auto ticks_it = ticks_.find(id);
-    if (ticks_it == ticks_.end() || ticks_it->second.empty()) return m;
+    InstrumentIndex index = registry_.index(id);
+    if (index == kNoInstrument || series_[index].ticks.empty()) return m;
 
-    const auto& ticks = ticks_it->second;
+    const auto& series = series_[index];
+    const auto& ticks = series.ticks;
 
     // P&L and inventory series
     double peak_pnl = 0.0;
@@ -75,20 +86,14 @@ InstrumentMetrics MetricsCollector::compute_instrument_metrics(InstrumentId id)
     }
 
     // Average spread captured
-    auto sc_it = spread_captures_.find(id);
-    if (sc_it != spread_captures_.end() && !sc_it->second.empty()) {
-        m.avg_spread_captured = std::accumulate(sc_it->second.begin(), sc_it->second.end(), 0.0)
-                                / sc_it->second.size();
+    const auto& sc = series.spread_captures;
+    if (!sc.empty()) {
+        m.avg_spread_captured = std::accumulate(sc.begin(), sc.end(), 0.0) / sc.size();
     }
 
-    auto qc_it = quote_counts_.find(id);
-    m.total_quotes = (qc_it != quote_counts_.end()) ? qc_it->second : 0;
-
-    auto fc_it = fill_counts_.find(id);
-    m.total_fills = (fc_it != fill_counts_.end()) ? fc_it->second : 0;
-
-    auto cc_it = cancel_counts_.find(id);
-    m.total_cancels = (cc_it != cancel_counts_.end()) ? cc_it->second : 0;
+    m.total_quotes = series.quotes;
+    m.total_fills = series.fills;
+    m.total_cancels = series.cancels;
 
     return m;
 }
@@ -97,8 +102,9 @@ GlobalMetrics MetricsCollector::compute_global_metrics() const {
     GlobalMetrics g;
     g.max_exposure = max_exposure_;
 
-    for (const auto& [id, _] : ticks_) {
-        auto m = compute_instrument_metrics(id);
+    for (InstrumentIndex i = 0; i < series_.size(); ++i) {
+        if (series_[i].ticks.empty()) continue;
+        auto m = compute_instrument_metrics(registry_.id(i));
         g.total_pnl += m.realized_pnl;
         g.total_quotes += m.total_quotes;
         g.total_fills += m.total_fills;
@@ -112,8 +118,8 @@ void MetricsCollector::write_csv(const std::string& filename) const {
     std::ofstream f(filename);
     f << "timestamp,instrument,mid_price,position,realized_pnl,unrealized_pnl,bid_price,ask_price,spread_captured\n";
 
-    for (const auto& [id, ticks] : ticks_) {
-        for (const auto& t : ticks) {
+    for (const auto& series : series_) {
+        for (const auto& t : series.ticks) {
             f << t.ts << ","
               << t.instrument << ","
               << std::fixed << std::setprecision(6)
@@ -151,8 +157,9 @@ std::string MetricsCollector::generate_report() const {
     ss << "| Instrument | Realized P&L | Sharpe | Max DD | Avg Spread Captured | Quotes | Fills | Max Pos | Min Pos |\n";
     ss << "|------------|-------------|--------|--------|---------------------|--------|-------|---------|--------|\n";
 
-    for (const auto& [id, _] : ticks_) {
-        auto m = compute_instrument_metrics(id);
+    for (InstrumentIndex i = 0; i < series_.size(); ++i) {
+        if (series_[i].ticks.empty()) continue;
+        auto m = compute_instrument_metrics(registry_.id(i));
         ss << "| " << m.id
            << " | " << m.realized_pnl
            << " | " << m.sharpe_approx
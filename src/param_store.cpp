@@ -0,0 +1,94 @@
+#include "strategy/param_store.hpp"
+
+#include <cmath>
+
+namespace mme {
+
+namespace {
+
+bool fail(std::string* error, std::string message) {
+    if (error) *error = std::move(message);
+    return false;
+}
+
+} // anonymous namespace
+
+ParamStore::ParamStore(const InstrumentRegistry& registry,
+                       const std::unordered_map<InstrumentId, MarketMakingParams>& params)
+    : registry_(registry) {
+    auto set = std::make_unique<ParamSet>();
+    set->version = 1;
+    set->params.resize(registry_.size());
+    set->configured.assign(registry_.size(), 0);
+    for (const auto& [id, p] : params) {
+        InstrumentIndex i = registry_.index(id);
+        if (i == kNoInstrument) continue;
+        set->params[i] = p;
+        set->configured[i] = 1;
+    }
+    current_.store(set.get(), std::memory_order_release);
+    versions_.push_back(std::move(set));
+}
+
+bool ParamStore::validate(const MarketMakingParams& p, std::string* error) {
+    for (double v : {p.base_spread_bp, p.min_spread_bp, p.max_spread_bp, p.volatility_coeff,
+                     p.inventory_coeff, p.factor_skew_weight, p.size_base,
+                     p.size_inventory_scale, p.quote_refresh_ms, p.tick_size, p.lot_size,
+                     p.requote_min_ticks, p.requote_size_tolerance, p.max_position,
+                     p.max_order_rate, p.quote_cache_vol_bucket}) {
+        if (!std::isfinite(v)) return fail(error, "non-finite parameter");
+    }
+    if (p.tick_size <= 0.0 || p.lot_size <= 0.0) {
+        return fail(error, "tick_size and lot_size must be positive");
+    }
+    if (p.min_spread_bp < 0.0 || p.min_spread_bp > p.max_spread_bp) {
+        return fail(error, "need 0 <= min_spread_bp <= max_spread_bp");
+    }
+    if (p.base_spread_bp < 0.0) return fail(error, "base_spread_bp is negative");
+    if (p.size_base <= 0.0) return fail(error, "size_base must be positive");
+    if (p.factor_skew_weight < 0.0 || p.factor_skew_weight > 1.0) {
+        return fail(error, "factor_skew_weight must be in [0, 1]");
+    }
+    if (p.max_position < 0.0) return fail(error, "max_position is negative");
+    if (p.max_order_rate < 0.0) return fail(error, "max_order_rate is negative");
+    if (p.quote_cache_vol_bucket < 0.0) return fail(error, "quote_cache_vol_bucket is negative");
+    if (p.quote_refresh_ms < 0.0 || p.requote_min_ticks < 0.0 || p.requote_size_tolerance < 0.0) {
+        return fail(error, "negative requote setting");
+    }
+    return true;
+}
+
+bool ParamStore::publish(const std::unordered_map<InstrumentId, MarketMakingParams>& params,
+                         std::string* error) {
+    std::lock_guard<std::mutex> lock(publish_mutex_);
+    const ParamSet& cur = *current_.load(std::memory_order_relaxed);
+
+    auto next = std::make_unique<ParamSet>(cur);
+    bool changed = false;
+    for (const auto& [id, p] : params) {
+        InstrumentIndex i = registry_.index(id);
+        std::string prefix = "instrument " + std::to_string(id) + ": ";
+        if (i == kNoInstrument) return fail(error, prefix + "not in the registry");
+
+        std::string why;
+        if (!validate(p, &why)) return fail(error, prefix + why);
+
+        // Live orders sit on the old grid, so the grid itself is fixed
+        if (const auto* old = cur.at(i);
+            old && (old->tick_size != p.tick_size || old->lot_size != p.lot_size)) {
+            return fail(error, prefix + "tick_size / lot_size cannot change at runtime");
+        }
+
+        if (!cur.configured[i] || !(cur.params[i] == p)) changed = true;
+        next->params[i] = p;
+        next->configured[i] = 1;
+    }
+    if (!changed) return true;
+
+    next->version = cur.version + 1;
+    current_.store(next.get(), std::memory_order_release);
+    versions_.push_back(std::move(next));
+    return true;
+}
+
+} // namespace mme
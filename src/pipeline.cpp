@@ -0,0 +1,329 @@
+#include "runtime/pipeline.hpp"
+#include "strategy/market_maker_controller.hpp"
+#include "util/thread_affinity.hpp"
+
+#include <thread>
+
+namespace mme {
+
+// --- QueuedExecutionGateway ---
+
+void QueuedExecutionGateway::push(GatewayCommand cmd) {
+    cmd.tick_ns = tick_ns_;
+    pipeline_.push_command(cmd);
+}
+
+uint64_t QueuedExecutionGateway::send_limit_order(const LiveOrder& order) {
+    GatewayCommand cmd{.action = {.type = OrderActionType::New, .order = order}};
+    cmd.action.order.id = next_order_id_++;
+    push(cmd);
+    return cmd.action.order.id;
+}
+
+void QueuedExecutionGateway::cancel_order(uint64_t order_id) {
+    GatewayCommand cmd;
+    cmd.action.type = OrderActionType::Cancel;
+    cmd.action.order.id = order_id;
+    push(cmd);
+}
+
+bool QueuedExecutionGateway::amend_order(uint64_t order_id, double new_price, double new_size) {
+    if (order_id == 0 || order_id >= next_order_id_) return false;
+    GatewayCommand cmd;
+    cmd.type = GatewayCommandType::AmendOrder;
+    cmd.action.type = OrderActionType::Amend;
+    cmd.action.order.id = order_id;
+    cmd.action.order.price = new_price;
+    cmd.action.order.size = new_size;
+    push(cmd);
+    return true;
+}
+
+bool QueuedExecutionGateway::amend_limit_order(const LiveOrder& order) {
+    if (order.id == 0 || order.id >= next_order_id_) return false;
+    push(GatewayCommand{.action = {.type = OrderActionType::Amend, .order = order}});
+    return true;
+}
+
+void QueuedExecutionGateway::send_batch(std::span<OrderAction> actions) {
+    for (auto& a : actions) {
+        if (a.type == OrderActionType::New) a.order.id = next_order_id_++;
+        a.ok = true;
+        push(GatewayCommand{.action = a});
+    }
+}
+
+size_t QueuedExecutionGateway::cancel_all() {
+    GatewayCommand cmd;
+    cmd.type = GatewayCommandType::CancelAll;
+    push(cmd);
+    return 0;
+}
+
+size_t QueuedExecutionGateway::cancel_instrument(InstrumentId instrument) {
+    GatewayCommand cmd;
+    cmd.type = GatewayCommandType::CancelInstrument;
+    cmd.instrument = instrument;
+    push(cmd);
+    return 0;
+}
+
+size_t QueuedExecutionGateway::cancel_venue(VenueId venue) {
+    GatewayCommand cmd;
+    cmd.type = GatewayCommandType::CancelVenue;
+    cmd.venue = venue;
+    push(cmd);
+    return 0;
+}
+
+// --- Pipeline ---
+
+Pipeline::Pipeline(const PipelineConfig& config, IExecutionGateway& downstream,
+                   const Clock* clock)
+    : config_(config),
+      downstream_(downstream),
+      clock_(clock ? clock : &default_clock()),
+      proxy_(*this),
+      md_queue_(config.queue_capacity),
+      command_queue_(config.queue_capacity),
+      gateway_md_queue_(config.queue_capacity),
+      fill_queue_(config.queue_capacity),
+      tick_to_order_(config.max_latency_samples) {}
+
+void Pipeline::run(MarketMakerController& controller, FeedSource feed) {
+    feed_done_.store(false);
+    strategy_done_.store(false);
+    tick_to_order_.clear();
+    stats_ = PipelineStats{};
+
+    std::thread gateway([this] { gateway_loop(); });
+    std::thread strategy([this, &controller] { strategy_loop(controller); });
+    std::thread feeder([this, &feed] { feed_loop(feed); });
+
+    feeder.join();
+    strategy.join();
+    gateway.join();
+
+    // Fills raised after the strategy stage stopped
+    Fill fill;
+    while (fill_queue_.try_pop(fill)) handle_fill(controller, fill);
+    for (const auto& f : fill_overflow_) handle_fill(controller, f);
+    fill_overflow_.clear();
+
+    stats_.tick_to_order = tick_to_order_.summary();
+}
+
+void Pipeline::feed_loop(FeedSource& feed) {
+    pin_current_thread(config_.feed_cpu);
+
+    MarketDataEvent ev;
+    while (feed(ev.snapshot)) {
+        ev.recv_ns = clock_->now();
+        while (!md_queue_.try_push(ev)) {
+            ++stats_.feed_stalls;
+            backoff(config_.wait);
+        }
+        ++stats_.ticks_in;
+        wake(strategy_wake_);
+    }
+
+    feed_done_.store(true, std::memory_order_release);
+    wake(strategy_wake_);
+}
+
+void Pipeline::strategy_loop(MarketMakerController& controller) {
+    pin_current_thread(config_.strategy_cpu);
+
+    MarketDataEvent ev;
+    Fill fill;
+    std::vector<MarketDataEvent> batch;
+    if (config_.conflate) batch.reserve(md_queue_.capacity());
+
+    for (;;) {
+        uint32_t seen = strategy_wake_.observe();
+        bool worked = false;
+
+        // Fills first so inventory is current before the next quote
+        while (fill_queue_.try_pop(fill)) {
+            handle_fill(controller, fill);
+            worked = true;
+        }
+
+        if (config_.conflate) {
+            while (batch.size() < md_queue_.capacity() && md_queue_.try_pop(ev)) {
+                batch.push_back(ev);
+            }
+            if (!batch.empty()) {
+                const uint64_t oldest = batch.front().recv_ns;
+                proxy_.set_tick_ns(oldest);
+                for (const auto& e : batch) controller.enqueue_market_data(e.snapshot);
+                controller.drain_market_data();
+                for (const auto& e : batch) {
+                    if (gateway_md_hook_) {
+                        while (!gateway_md_queue_.try_push(e.snapshot)) backoff(config_.wait);
+                        wake(gateway_wake_);
+                    }
+                    if (after_md_) after_md_(e.snapshot);
+                }
+                stats_.ticks_handled += batch.size();
+                batch.clear();
+                worked = true;
+            }
+        } else if (md_queue_.try_pop(ev)) {
+            proxy_.set_tick_ns(ev.recv_ns);
+            controller.on_market_data(ev.snapshot);
+            if (gateway_md_hook_) {
+                while (!gateway_md_queue_.try_push(ev.snapshot)) backoff(config_.wait);
+                wake(gateway_wake_);
+            }
+            if (after_md_) after_md_(ev.snapshot);
+            ++stats_.ticks_handled;
+            worked = true;
+        }
+
+        if (worked) continue;
+        if (feed_done_.load(std::memory_order_acquire) && md_queue_.empty()) break;
+        strategy_wake_.idle(config_.wait, seen);
+    }
+
+    strategy_done_.store(true, std::memory_order_release);
+    wake(gateway_wake_);
+}
+
+void Pipeline::gateway_loop() {
+    pin_current_thread(config_.gateway_cpu);
+
+    GatewayCommand cmd;
+    VenueBookSnapshot snap;
+
+    for (;;) {
+        uint32_t seen = gateway_wake_.observe();
+        bool worked = false;
+
+        // Orders queued before a snapshot are sent before the hook sees it
+        while (command_queue_.try_pop(cmd)) {
+            execute(cmd);
+            worked = true;
+        }
+        if (gateway_md_queue_.try_pop(snap)) {
+            gateway_md_hook_(snap);
+            worked = true;
+        }
+
+        if (!fill_overflow_.empty()) {
+            size_t sent = 0;
+            while (sent < fill_overflow_.size() && fill_queue_.try_push(fill_overflow_[sent])) ++sent;
+            fill_overflow_.erase(fill_overflow_.begin(), fill_overflow_.begin() + sent);
+            if (sent > 0) wake(strategy_wake_);
+        }
+
+        if (worked) continue;
+        if (strategy_done_.load(std::memory_order_acquire) &&
+            command_queue_.empty() && gateway_md_queue_.empty()) {
+            break;
+        }
+        gateway_wake_.idle(config_.wait, seen);
+    }
+}
+
+template <typename Pred>
+void Pipeline::forget_orders(Pred pred) {
+    std::erase_if(id_map_, [&](const auto& entry) {
+        if (!pred(entry.second)) return false;
+        local_ids_.erase(entry.second.downstream_id);
+        return true;
+    });
+}
+
+void Pipeline::execute(const GatewayCommand& cmd) {
+    switch (cmd.type) {
+        case GatewayCommandType::CancelAll:
+            downstream_.cancel_all();
+            id_map_.clear();
+            local_ids_.clear();
+            return;
+        case GatewayCommandType::CancelInstrument:
+            downstream_.cancel_instrument(cmd.instrument);
+            forget_orders([&](const TrackedOrder& o) { return o.instrument == cmd.instrument; });
+            return;
+        case GatewayCommandType::CancelVenue:
+            downstream_.cancel_venue(cmd.venue);
+            forget_orders([&](const TrackedOrder& o) { return o.venue == cmd.venue; });
+            return;
+        case GatewayCommandType::Action:
+        case GatewayCommandType::AmendOrder:
+            break;
+    }
+
+    const auto& a = cmd.action;
+    switch (a.type) {
+        case OrderActionType::New: {
+            LiveOrder order = a.order;
+            order.id = 0;
+            uint64_t id = downstream_.send_limit_order(order);
+            if (id != 0) {
+                id_map_[a.order.id] = {.downstream_id = id, .instrument = a.order.instrument,
+                                       .venue = a.order.venue};
+                local_ids_[id] = a.order.id;
+            }
+            break;
+        }
+        case OrderActionType::Cancel: {
+            auto it = id_map_.find(a.order.id);
+            if (it == id_map_.end()) return;
+            downstream_.cancel_order(it->second.downstream_id);
+            local_ids_.erase(it->second.downstream_id);
+            id_map_.erase(it);
+            break;
+        }
+        case OrderActionType::Amend: {
+            auto it = id_map_.find(a.order.id);
+            if (it == id_map_.end()) return;
+            LiveOrder order = a.order;
+            order.id = it->second.downstream_id;
+            const bool ok = cmd.type == GatewayCommandType::AmendOrder
+                ? downstream_.amend_order(order.id, order.price, order.size)
+                : downstream_.amend_limit_order(order);
+            if (!ok) {
+                local_ids_.erase(it->second.downstream_id);
+                id_map_.erase(it);
+            }
+            break;
+        }
+    }
+    ++stats_.commands;
+    tick_to_order_.record(clock_->now() - cmd.tick_ns);
+}
+
+void Pipeline::push_command(const GatewayCommand& cmd) {
+    while (!command_queue_.try_push(cmd)) {
+        ++stats_.strategy_stalls;
+        backoff(config_.wait);
+    }
+    wake(gateway_wake_);
+}
+
+void Pipeline::post_fill(const Fill& downstream_fill) {
+    Fill fill = downstream_fill;
+    auto it = local_ids_.find(downstream_fill.order_id);
+    fill.order_id = it != local_ids_.end() ? it->second : 0;
+    if (it != local_ids_.end() && downstream_fill.leaves <= 0) {
+        id_map_.erase(it->second);
+        local_ids_.erase(it);
+    }
+    // Never block the gateway thread on the strategy: that could deadlock
+    // against a strategy waiting on a full command queue
+    if (!fill_overflow_.empty() || !fill_queue_.try_push(fill)) {
+        fill_overflow_.push_back(fill);
+        return;
+    }
+    wake(strategy_wake_);
+}
+
+void Pipeline::handle_fill(MarketMakerController& controller, const Fill& fill) {
+    controller.on_fill(fill);
+    if (after_fill_) after_fill_(fill);
+    ++stats_.fills;
+}
+
+} // namespace mme
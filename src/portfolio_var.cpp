@@ -0,0 +1,144 @@
+#include "risk/portfolio_var.hpp"
+
+#include <cmath>
+
+namespace mme {
+
+namespace {
+
+// Far above the smallest normal double, so entries divided by the scale
+// stay well inside the exponent range
+constexpr double kRenormalizeBelow = 1e-100;
+
+} // anonymous namespace
+
+PortfolioVarEngine::PortfolioVarEngine(const InstrumentRegistry& registry,
+                                       const VarConfig& config, const Clock* clock)
+    : config_(config),
+      clock_(clock ? clock : &default_clock()),
+      kernel_(best_matrix_kernel()),
+      n_(registry.size()),
+      stride_((registry.size() + 7) & ~size_t{7}),
+      cov_(n_ * stride_, 0.0),
+      exposure_(n_, 0.0),
+      cov_w_(n_, 0.0),
+      mid_(n_, 0.0),
+      sampled_mid_(n_, 0.0),
+      pending_(n_, 0) {
+    touched_.reserve(n_);
+    returns_.reserve(n_);
+}
+
+void PortfolioVarEngine::on_mid_at(InstrumentIndex index, double mid) {
+    if (index >= n_ || !(mid > 0.0)) return;
+
+    const Timestamp now = clock_->now();
+    const Timestamp interval = config_.sample_interval > 0 ? config_.sample_interval : 1;
+    if (next_sample_ == 0) {
+        next_sample_ = now + interval;
+    } else if (now >= next_sample_) {
+        // The pending returns belong to the first elapsed interval; any
+        // further ones saw no move and only decay
+        const Timestamp elapsed = (now - next_sample_) / interval;
+        sample();
+        if (elapsed > 0) {
+            scale_ *= std::pow(config_.lambda, static_cast<double>(elapsed));
+            samples_ += elapsed;
+            if (scale_ < kRenormalizeBelow) renormalize();
+        }
+        next_sample_ += (elapsed + 1) * interval;
+    }
+
+    mid_[index] = mid;
+    if (sampled_mid_[index] == 0.0) {
+        sampled_mid_[index] = mid;
+    } else if (!pending_[index]) {
+        pending_[index] = 1;
+        touched_.push_back(index);
+    }
+}
+
+void PortfolioVarEngine::sample() {
+    scale_ *= config_.lambda;
+    ++samples_;
+    if (scale_ < kRenormalizeBelow) renormalize();
+
+    returns_.clear();
+    size_t k = 0;
+    double rw = 0.0;   // r . w over the touched instruments
+    for (InstrumentIndex i : touched_) {
+        pending_[i] = 0;
+        const double r = std::log(mid_[i] / sampled_mid_[i]);
+        sampled_mid_[i] = mid_[i];
+        if (r == 0.0) continue;
+        touched_[k++] = i;
+        returns_.push_back(r);
+        rw += r * exposure_[i];
+    }
+    touched_.resize(k);
+
+    // Rank-1 update restricted to the touched rows and columns; every
+    // other entry only decays, which the scale already accounts for
+    const double a = (1.0 - config_.lambda) / scale_;
+    for (size_t p = 0; p < k; ++p) {
+        double* row = cov_.data() + touched_[p] * stride_;
+        const double ar = a * returns_[p];
+        for (size_t q = 0; q < k; ++q) row[touched_[q]] += ar * returns_[q];
+        cov_w_[touched_[p]] += ar * rw;
+    }
+    quad_ += a * rw * rw;
+    touched_.clear();
+}
+
+void PortfolioVarEngine::set_exposure_at(InstrumentIndex index, double exposure) {
+    if (index >= n_) return;
+    const double d = exposure - exposure_[index];
+    if (d == 0.0) return;
+
+    // Symmetric, so row `index` is column `index`
+    const double* row = cov_.data() + index * stride_;
+    quad_ += 2.0 * d * cov_w_[index] + d * d * row[index];
+    axpy(d, row, cov_w_.data(), n_, kernel_);
+    exposure_[index] = exposure;
+}
+
+double PortfolioVarEngine::variance() const {
+    const double v = quad_ * scale_;
+    return v > 0.0 ? v : 0.0;
+}
+
+double PortfolioVarEngine::var() const {
+    return config_.confidence_z * std::sqrt(variance() * config_.horizon_samples);
+}
+
+double PortfolioVarEngine::var_with(InstrumentIndex index, double delta) const {
+    if (index >= n_) return var();
+    const double quad = quad_ + 2.0 * delta * cov_w_[index] +
+                        delta * delta * cov_[index * stride_ + index];
+    const double v = quad * scale_;
+    return config_.confidence_z * std::sqrt((v > 0.0 ? v : 0.0) * config_.horizon_samples);
+}
+
+double PortfolioVarEngine::marginal_var_at(InstrumentIndex index) const {
+    const double sigma = std::sqrt(variance());
+    if (index >= n_ || sigma <= 0.0) return 0.0;
+    return config_.confidence_z * std::sqrt(config_.horizon_samples) *
+           cov_w_[index] * scale_ / sigma;
+}
+
+void PortfolioVarEngine::resync() {
+    gemv(cov_.data(), stride_, n_, exposure_.data(), cov_w_.data(), kernel_);
+    quad_ = dot(exposure_.data(), cov_w_.data(), n_, kernel_);
+}
+
+void PortfolioVarEngine::renormalize() {
+    for (size_t i = 0; i < n_; ++i) {
+        double* row = cov_.data() + i * stride_;
+        for (size_t j = 0; j < n_; ++j) row[j] *= scale_;
+        cov_w_[i] *= scale_;
+    }
+    quad_ *= scale_;
+    scale_ = 1.0;
+}
+
+} // namespace mme
@@ -1,95 +1,179 @@
 #include "strategy/quote_engine.hpp"
 
-#include <algorithm>
 #include <cmath>
-#include <chrono>
 
 namespace mme {
 
-QuoteEngine::QuoteEngine(std::unordered_map<InstrumentId, MarketMakingParams> params)
-    : params_(std::move(params)) {}
+QuoteEngine::QuoteEngine(const std::unordered_map<InstrumentId, MarketMakingParams>& params,
+                         const Clock* clock)
+    : QuoteEngine(InstrumentRegistry::from_keys(params), params, clock) {}
+
+QuoteEngine::QuoteEngine(const InstrumentRegistry& registry,
+                         const std::unordered_map<InstrumentId, MarketMakingParams>& params,
+                         const Clock* clock)
+    : QuoteEngine(std::make_shared<ParamStore>(registry, params), clock) {}
+
+QuoteEngine::QuoteEngine(std::shared_ptr<const ParamStore> store, const Clock* clock)
+    : store_(std::move(store)),
+      clock_(clock ? clock : &default_clock()),
+      cache_(store_->registry().size()) {}
 
 Quote QuoteEngine::compute_quote(const InstrumentMarketView& view,
                                   const InstrumentPosition& position,
                                   VenueId venue) const {
-    auto it = params_.find(view.id);
-    if (it == params_.end()) {
+    return compute_quote_at(registry().index(view.id), view, position, venue);
+}
+
+Quote QuoteEngine::compute_quote_at(InstrumentIndex index,
+                                     const InstrumentMarketView& view,
+                                     const InstrumentPosition& position,
+                                     VenueId venue) const {
+    // One load per quote, so every field comes from the same version
+    const ParamSet& set = store_->current();
+    const MarketMakingParams* params = set.at(index);
+    if (params == nullptr) {
         return Quote{.id = view.id, .venue = venue};
     }
 
-    const auto& p = it->second;
-    double mid = view.mid_price;
+    const auto& p = *params;
+    double mid = select_fair_price(view, p.fair_price);
 
     if (mid <= 0.0) {
         return Quote{.id = view.id, .venue = venue};
     }
 
-    double spread_bp = compute_spread(p, view.volatility);
-    double spread_abs = spread_bp * mid / 10000.0;
-
-    double skew = compute_skew(p, position.quantity, p.max_position, spread_abs);
-    double size = compute_size(p, position.quantity, p.max_position);
+    double vol = select_volatility(view, p.volatility_estimator);
+    double skew_inv = skew_inventory(index, p, position.quantity, mid);
+    if (p.quote_cache_vol_bucket > 0.0) {
+        CacheKey key = cache_key(p, set.version, mid, vol, position.quantity, skew_inv);
+        if (const QuoteLane* hit = cache_lookup(index, key)) {
+            return make_quote(view.id, venue, *hit, p.scale(), set.version);
+        }
+        auto& entry = cache_[index];
+        entry.lane = quote_lane(mid, vol, position.quantity, skew_inv, p);
+        entry.valid = true;
+        return make_quote(view.id, venue, entry.lane, p.scale(), set.version);
+    }
 
-    double bid_price = mid - spread_abs / 2.0 - skew;
-    double ask_price = mid + spread_abs / 2.0 - skew;
+    QuoteLane lane = quote_lane(mid, vol, position.quantity, skew_inv, p);
+    return make_quote(view.id, venue, lane, p.scale(), set.version);
+}
 
-    // Determine per-side size based on position limits
-    double bid_size = size;
-    double ask_size = size;
+size_t QuoteEngine::add_to_batch(QuoteBatch& batch, InstrumentIndex index,
+                                 const InstrumentMarketView& view,
+                                 const InstrumentPosition& position) const {
+    const ParamSet& set = store_->current();
+    const auto& p = set.params[index];
+    double fair = select_fair_price(view, p.fair_price);
+    double vol = select_volatility(view, p.volatility_estimator);
+    double skew_inv = skew_inventory(index, p, position.quantity, fair);
+    if (p.quote_cache_vol_bucket > 0.0 && fair > 0.0 &&
+        cache_lookup(index, cache_key(p, set.version, fair, vol, position.quantity, skew_inv))) {
+        return kCachedLane;
+    }
+    return batch.add(fair, vol, position.quantity, skew_inv, p, set.version);
+}
 
-    // If close to long limit, reduce bid size; if close to short limit, reduce ask size
-    double normalized_inv = (p.max_position > 0) ? position.quantity / p.max_position : 0.0;
-    if (normalized_inv > 0.8) {
-        bid_size *= std::max(0.1, 1.0 - normalized_inv);
+Quote QuoteEngine::batch_quote(const QuoteBatch& batch, size_t lane, InstrumentIndex index,
+                               VenueId venue) const {
+    // Tick and lot sizes never change across versions, so the current scale
+    // matches the one the lane was staged with
+    const PriceScale scale = store_->current().params[index].scale();
+    auto& entry = cache_[index];
+    if (lane == kCachedLane) {
+        return make_quote(registry().id(index), venue, entry.lane, scale,
+                          entry.key.params_version);
     }
-    if (normalized_inv < -0.8) {
-        ask_size *= std::max(0.1, 1.0 + normalized_inv);
+
+    // Fill the entry add_to_batch claimed, if it is still the same request
+    if (!entry.valid && entry.key.params_version == batch.params_version(lane)) {
+        entry.lane = batch.result(lane);
+        entry.valid = true;
     }
+    return make_quote(registry().id(index), venue, batch.result(lane), scale,
+                      batch.params_version(lane));
+}
 
-    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()).count();
+QuoteEngine::CacheKey QuoteEngine::cache_key(const MarketMakingParams& p, uint64_t version,
+                                             double fair, double volatility, double inventory,
+                                             double skew_inventory) {
+    return CacheKey{
+        .fair_ticks     = std::llround(fair / p.tick_size),
+        .vol_bucket     = static_cast<int64_t>(std::floor(volatility / p.quote_cache_vol_bucket)),
+        .inventory      = inventory,
+        .skew_lots      = p.scale().to_lots(skew_inventory),
+        .params_version = version,
+    };
+}
+
+const QuoteLane* QuoteEngine::cache_lookup(InstrumentIndex index, const CacheKey& key) const {
+    auto& entry = cache_[index];
+    if (entry.valid && entry.key == key) {
+        ++cache_stats_.hits;
+        return &entry.lane;
+    }
+    ++cache_stats_.misses;
+    entry.key = key;
+    entry.valid = false;
+    return nullptr;
+}
 
+Quote QuoteEngine::make_quote(InstrumentId id, VenueId venue, const QuoteLane& lane,
+                              const PriceScale& scale, uint64_t params_version) const {
     return Quote{
-        .id        = view.id,
+        .id        = id,
         .venue     = venue,
-        .bid_price = bid_price,
-        .ask_price = ask_price,
-        .bid_size  = bid_size,
-        .ask_size  = ask_size,
-        .ts        = static_cast<Timestamp>(now),
+        .bid_ticks = lane.bid_ticks,
+        .ask_ticks = lane.ask_ticks,
+        .bid_lots  = lane.bid_lots,
+        .ask_lots  = lane.ask_lots,
+        .bid_price = scale.to_price(lane.bid_ticks),
+        .ask_price = scale.to_price(lane.ask_ticks),
+        .bid_size  = scale.to_qty(lane.bid_lots),
+        .ask_size  = scale.to_qty(lane.ask_lots),
+        .ts        = clock_->now(),
+        .params_version = params_version,
     };
 }
 
-double QuoteEngine::compute_spread(const MarketMakingParams& p, double volatility) const {
-    // spread = max(min_spread, min(max_spread, base_spread + vol_coeff * volatility))
-    // volatility is in log-return units; scale to bp by multiplying by 10000
-    double vol_bp = volatility * 10000.0;
-    double spread = p.base_spread_bp + p.volatility_coeff * vol_bp;
-    return std::clamp(spread, p.min_spread_bp, p.max_spread_bp);
+double QuoteEngine::skew_inventory(InstrumentIndex index, const MarketMakingParams& p,
+                                   double inventory, double fair) const {
+    if (factors_ == nullptr || p.factor_skew_weight <= 0.0 || fair <= 0.0 ||
+        !factors_->has_loadings_at(index)) {
+        return inventory;
+    }
+    const double hedged = factors_->hedged_exposure_at(index) / fair;
+    const PriceScale scale = p.scale();
+    return scale.to_qty(scale.to_lots((1.0 - p.factor_skew_weight) * inventory +
+                                      p.factor_skew_weight * hedged));
 }
 
-double QuoteEngine::compute_skew(const MarketMakingParams& p,
-                                  double inventory,
-                                  double max_position,
-                                  double spread) const {
-    if (max_position <= 0.0) return 0.0;
-
-    // Normalized inventory: q_tilde = q / Q_max
-    double q_tilde = inventory / max_position;
-
-    // Skew delta = inventory_coeff * q_tilde * spread
-    return p.inventory_coeff * q_tilde * spread;
+const MarketMakingParams* QuoteEngine::params(InstrumentId id) const {
+    return params_at(registry().index(id));
 }
 
-double QuoteEngine::compute_size(const MarketMakingParams& p,
-                                  double inventory,
-                                  double max_position) const {
-    if (max_position <= 0.0) return p.size_base;
+double QuoteEngine::select_fair_price(const InstrumentMarketView& view, FairPrice fair_price) {
+    double price = 0.0;
+    switch (fair_price) {
+        case FairPrice::Mid:         price = view.mid_price; break;
+        case FairPrice::Microprice:  price = view.microprice; break;
+        case FairPrice::WeightedMid: price = view.weighted_mid; break;
+    }
+    // Signals are unavailable until both sides have depth
+    return (price > 0.0) ? price : view.mid_price;
+}
 
-    // size = size_base * (1 - beta * |q_tilde|), clamped at min
-    double q_tilde = std::abs(inventory) / max_position;
-    double size = p.size_base * (1.0 - p.size_inventory_scale * q_tilde);
-    return std::max(size, p.size_base * 0.1); // floor at 10% of base
+double QuoteEngine::select_volatility(const InstrumentMarketView& view,
+                                      VolatilityEstimator estimator) {
+    switch (estimator) {
+        case VolatilityEstimator::Ewma:      return view.volatility;
+        case VolatilityEstimator::EwmaSlow:  return view.vol_estimates.ewma[1];
+        case VolatilityEstimator::EwmaFast:  return view.vol_estimates.ewma[2];
+        case VolatilityEstimator::EwmaBurst: return view.vol_estimates.ewma[3];
+        case VolatilityEstimator::Realized:  return view.vol_estimates.realized;
+        case VolatilityEstimator::Range:     return view.vol_estimates.range;
+    }
+    return view.volatility;
 }
 
 } // namespace mme
@@ -0,0 +1,434 @@
+#include "strategy/quote_kernels.hpp"
+#include "util/cpu_features.hpp"
+
+#include <cmath>
+
+#ifdef MME_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+// Built with -ffp-contract=off (see CMakeLists.txt): a fused multiply-add
+// in one kernel but not another would break bit-exactness.
+
+namespace mme {
+
+namespace {
+
+constexpr double kEps = PriceScale::kGridEpsilon;
+
+// The quote math on plain doubles. Comparisons and min / max are written
+// the way std::clamp / std::max evaluate them so the vector kernels can
+// mirror them with compares and blends.
+inline void quote_lane_raw(double fair, double vol, double inv, double skew_inv,
+                           double base_bp, double min_bp, double max_bp,
+                           double vol_coeff, double inv_coeff,
+                           double size_base, double size_scale, double max_pos,
+                           double tick, double lot,
+                           PriceTicks& bid_ticks, PriceTicks& ask_ticks,
+                           QtyLots& bid_lots, QtyLots& ask_lots) {
+    if (fair <= 0.0) {
+        bid_ticks = ask_ticks = 0;
+        bid_lots = ask_lots = 0;
+        return;
+    }
+
+    // spread = clamp(base + vol_coeff * vol_bp, min, max); vol in log-return units
+    double spread_bp = base_bp + vol_coeff * (vol * 10000.0);
+    spread_bp = spread_bp < min_bp ? min_bp : (max_bp < spread_bp ? max_bp : spread_bp);
+    double spread_abs = spread_bp * fair / 10000.0;
+
+    // Size shrinks with normalized inventory q / Q_max; the skew follows
+    // the skew inventory, which is the position itself unless a factor
+    // model blends in portfolio exposure
+    bool   has_limit = max_pos > 0.0;
+    double q         = has_limit ? inv / max_pos : 0.0;
+    double qs        = has_limit ? skew_inv / max_pos : 0.0;
+    double skew      = has_limit ? inv_coeff * qs * spread_abs : 0.0;
+    double size      = size_base;
+    if (has_limit) {
+        double shrunk = size_base * (1.0 - size_scale * (std::abs(inv) / max_pos));
+        double floor_size = size_base * 0.1;
+        size = shrunk < floor_size ? floor_size : shrunk;
+    }
+
+    double bid = fair - spread_abs / 2.0 - skew;
+    double ask = fair + spread_abs / 2.0 - skew;
+
+    // Near a limit, shrink the side that would extend the position
+    double bid_size = size;
+    double ask_size = size;
+    if (q > 0.8) {
+        double f = 1.0 - q;
+        bid_size *= (0.1 < f) ? f : 0.1;
+    }
+    if (q < -0.8) {
+        double f = 1.0 + q;
+        ask_size *= (0.1 < f) ? f : 0.1;
+    }
+
+    // Bids round down and asks up, so the edge never shrinks
+    double bt = std::floor(bid / tick + kEps);
+    double at = std::ceil(ask / tick - kEps);
+    if (at <= bt) at = bt + 1.0;
+
+    double bl = bid_size / lot;
+    double al = ask_size / lot;
+    bl = bl >= 0.0 ? std::floor(bl + kEps) : std::ceil(bl - kEps);
+    al = al >= 0.0 ? std::floor(al + kEps) : std::ceil(al - kEps);
+
+    bid_ticks = static_cast<PriceTicks>(bt);
+    ask_ticks = static_cast<PriceTicks>(at);
+    bid_lots  = static_cast<QtyLots>(bl);
+    ask_lots  = static_cast<QtyLots>(al);
+}
+
+// Lanes without a separate skew inventory skew on their position
+inline const double* skew_inventory(const QuoteBatchInput& in) {
+    return in.skew_inventory ? in.skew_inventory : in.inventory;
+}
+
+void compute_quotes_scalar(const QuoteBatchInput& in, const QuoteBatchOutput& out, size_t begin) {
+    const double* skew_inv = skew_inventory(in);
+    for (size_t i = begin; i < in.n; ++i) {
+        quote_lane_raw(in.fair[i], in.volatility[i], in.inventory[i], skew_inv[i],
+                       in.base_spread_bp[i], in.min_spread_bp[i], in.max_spread_bp[i],
+                       in.volatility_coeff[i], in.inventory_coeff[i],
+                       in.size_base[i], in.size_inventory_scale[i], in.max_position[i],
+                       in.tick_size[i], in.lot_size[i],
+                       out.bid_ticks[i], out.ask_ticks[i], out.bid_lots[i], out.ask_lots[i]);
+    }
+}
+
+#ifdef MME_X86_DISPATCH
+
+// --- AVX2: 4 lanes ---
+
+__attribute__((target("avx2")))
+inline __m256d sel(__m256d mask, __m256d if_false, __m256d if_true) {
+    return _mm256_blendv_pd(if_false, if_true, mask);
+}
+
+__attribute__((target("avx2")))
+void compute_quotes_avx2(const QuoteBatchInput& in, const QuoteBatchOutput& out) {
+    const __m256d zero  = _mm256_setzero_pd();
+    const __m256d one   = _mm256_set1_pd(1.0);
+    const __m256d two   = _mm256_set1_pd(2.0);
+    const __m256d tenth = _mm256_set1_pd(0.1);
+    const __m256d lim   = _mm256_set1_pd(0.8);
+    const __m256d bp    = _mm256_set1_pd(10000.0);
+    const __m256d eps   = _mm256_set1_pd(kEps);
+    const __m256d sign  = _mm256_set1_pd(-0.0);
+    constexpr int kFloor = _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC;
+    constexpr int kCeil  = _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC;
+
+    alignas(32) double bt[4], at[4], bl[4], al[4];
+    const double* skew_inv = skew_inventory(in);
+
+    size_t i = 0;
+    for (; i + 4 <= in.n; i += 4) {
+        __m256d fair      = _mm256_loadu_pd(in.fair + i);
+        __m256d vol       = _mm256_loadu_pd(in.volatility + i);
+        __m256d inv       = _mm256_loadu_pd(in.inventory + i);
+        __m256d sinv      = _mm256_loadu_pd(skew_inv + i);
+        __m256d base_bp   = _mm256_loadu_pd(in.base_spread_bp + i);
+        __m256d min_bp    = _mm256_loadu_pd(in.min_spread_bp + i);
+        __m256d max_bp    = _mm256_loadu_pd(in.max_spread_bp + i);
+        __m256d vol_coeff = _mm256_loadu_pd(in.volatility_coeff + i);
+        __m256d inv_coeff = _mm256_loadu_pd(in.inventory_coeff + i);
+        __m256d size_base = _mm256_loadu_pd(in.size_base + i);
+        __m256d scale     = _mm256_loadu_pd(in.size_inventory_scale + i);
+        __m256d max_pos   = _mm256_loadu_pd(in.max_position + i);
+        __m256d tick      = _mm256_loadu_pd(in.tick_size + i);
+        __m256d lot       = _mm256_loadu_pd(in.lot_size + i);
+
+        __m256d spread_bp = _mm256_add_pd(base_bp, _mm256_mul_pd(vol_coeff, _mm256_mul_pd(vol, bp)));
+        __m256d clamped = sel(_mm256_cmp_pd(max_bp, spread_bp, _CMP_LT_OQ), spread_bp, max_bp);
+        spread_bp = sel(_mm256_cmp_pd(spread_bp, min_bp, _CMP_LT_OQ), clamped, min_bp);
+        __m256d spread_abs = _mm256_div_pd(_mm256_mul_pd(spread_bp, fair), bp);
+
+        __m256d has_limit = _mm256_cmp_pd(max_pos, zero, _CMP_GT_OQ);
+        __m256d q    = sel(has_limit, zero, _mm256_div_pd(inv, max_pos));
+        __m256d qs   = sel(has_limit, zero, _mm256_div_pd(sinv, max_pos));
+        __m256d skew = sel(has_limit, zero, _mm256_mul_pd(_mm256_mul_pd(inv_coeff, qs), spread_abs));
+
+        __m256d abs_inv = _mm256_andnot_pd(sign, inv);
+        __m256d shrunk = _mm256_mul_pd(
+            size_base, _mm256_sub_pd(one, _mm256_mul_pd(scale, _mm256_div_pd(abs_inv, max_pos))));
+        __m256d floor_size = _mm256_mul_pd(size_base, tenth);
+        shrunk = sel(_mm256_cmp_pd(shrunk, floor_size, _CMP_LT_OQ), shrunk, floor_size);
+        __m256d size = sel(has_limit, size_base, shrunk);
+
+        __m256d half = _mm256_div_pd(spread_abs, two);
+        __m256d bid = _mm256_sub_pd(_mm256_sub_pd(fair, half), skew);
+        __m256d ask = _mm256_sub_pd(_mm256_add_pd(fair, half), skew);
+
+        __m256d fb = _mm256_sub_pd(one, q);
+        fb = sel(_mm256_cmp_pd(tenth, fb, _CMP_LT_OQ), tenth, fb);
+        __m256d bid_size = sel(_mm256_cmp_pd(q, lim, _CMP_GT_OQ), size, _mm256_mul_pd(size, fb));
+        __m256d fa = _mm256_add_pd(one, q);
+        fa = sel(_mm256_cmp_pd(tenth, fa, _CMP_LT_OQ), tenth, fa);
+        __m256d neg_lim = _mm256_sub_pd(zero, lim);
+        __m256d ask_size = sel(_mm256_cmp_pd(q, neg_lim, _CMP_LT_OQ), size, _mm256_mul_pd(size, fa));
+
+        __m256d vbt = _mm256_round_pd(_mm256_add_pd(_mm256_div_pd(bid, tick), eps), kFloor);
+        __m256d vat = _mm256_round_pd(_mm256_sub_pd(_mm256_div_pd(ask, tick), eps), kCeil);
+        vat = sel(_mm256_cmp_pd(vat, vbt, _CMP_LE_OQ), vat, _mm256_add_pd(vbt, one));
+
+        __m256d vbl = _mm256_div_pd(bid_size, lot);
+        vbl = sel(_mm256_cmp_pd(vbl, zero, _CMP_GE_OQ),
+                  _mm256_round_pd(_mm256_sub_pd(vbl, eps), kCeil),
+                  _mm256_round_pd(_mm256_add_pd(vbl, eps), kFloor));
+        __m256d val = _mm256_div_pd(ask_size, lot);
+        val = sel(_mm256_cmp_pd(val, zero, _CMP_GE_OQ),
+                  _mm256_round_pd(_mm256_sub_pd(val, eps), kCeil),
+                  _mm256_round_pd(_mm256_add_pd(val, eps), kFloor));
+
+        // fair <= 0 lanes produce no quote (NaN fair is quoted, as in the scalar path)
+        int ok = _mm256_movemask_pd(_mm256_cmp_pd(fair, zero, _CMP_NLE_UQ));
+        _mm256_store_pd(bt, vbt);
+        _mm256_store_pd(at, vat);
+        _mm256_store_pd(bl, vbl);
+        _mm256_store_pd(al, val);
+        for (size_t k = 0; k < 4; ++k) {
+            bool live = (ok >> k) & 1;
+            out.bid_ticks[i + k] = live ? static_cast<PriceTicks>(bt[k]) : 0;
+            out.ask_ticks[i + k] = live ? static_cast<PriceTicks>(at[k]) : 0;
+            out.bid_lots[i + k]  = live ? static_cast<QtyLots>(bl[k]) : 0;
+            out.ask_lots[i + k]  = live ? static_cast<QtyLots>(al[k]) : 0;
+        }
+    }
+    compute_quotes_scalar(in, out, i);
+}
+
+// --- AVX-512: 8 lanes ---
+
+// vrndscalepd merged into its own input. The unmasked intrinsic merges into
+// _mm512_undefined_pd(), which GCC 12 reports as -Wmaybe-uninitialized.
+template <int Mode>
+__attribute__((target("avx512f")))
+inline __m512d roundscale(__m512d v) {
+    return _mm512_mask_roundscale_pd(v, 0xFF, v, Mode);
+}
+
+__attribute__((target("avx512f")))
+void compute_quotes_avx512(const QuoteBatchInput& in, const QuoteBatchOutput& out) {
+    const __m512d zero  = _mm512_setzero_pd();
+    const __m512d one   = _mm512_set1_pd(1.0);
+    const __m512d two   = _mm512_set1_pd(2.0);
+    const __m512d tenth = _mm512_set1_pd(0.1);
+    const __m512d lim   = _mm512_set1_pd(0.8);
+    const __m512d neg_lim = _mm512_set1_pd(-0.8);
+    const __m512d bp    = _mm512_set1_pd(10000.0);
+    const __m512d eps   = _mm512_set1_pd(kEps);
+    constexpr int kFloor = _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC;
+    constexpr int kCeil  = _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC;
+
+    alignas(64) double bt[8], at[8], bl[8], al[8];
+    const double* skew_inv = skew_inventory(in);
+
+    size_t i = 0;
+    for (; i + 8 <= in.n; i += 8) {
+        __m512d fair      = _mm512_loadu_pd(in.fair + i);
+        __m512d vol       = _mm512_loadu_pd(in.volatility + i);
+        __m512d inv       = _mm512_loadu_pd(in.inventory + i);
+        __m512d sinv      = _mm512_loadu_pd(skew_inv + i);
+        __m512d base_bp   = _mm512_loadu_pd(in.base_spread_bp + i);
+        __m512d min_bp    = _mm512_loadu_pd(in.min_spread_bp + i);
+        __m512d max_bp    = _mm512_loadu_pd(in.max_spread_bp + i);
+        __m512d vol_coeff = _mm512_loadu_pd(in.volatility_coeff + i);
+        __m512d inv_coeff = _mm512_loadu_pd(in.inventory_coeff + i);
+        __m512d size_base = _mm512_loadu_pd(in.size_base + i);
+        __m512d scale     = _mm512_loadu_pd(in.size_inventory_scale + i);
+        __m512d max_pos   = _mm512_loadu_pd(in.max_position + i);
+        __m512d tick      = _mm512_loadu_pd(in.tick_size + i);
+        __m512d lot       = _mm512_loadu_pd(in.lot_size + i);
+
+        // _mm512_mask_blend_pd(m, a, b) picks b where m is set
+        __m512d spread_bp = _mm512_add_pd(base_bp, _mm512_mul_pd(vol_coeff, _mm512_mul_pd(vol, bp)));
+        __m512d clamped = _mm512_mask_blend_pd(
+            _mm512_cmp_pd_mask(max_bp, spread_bp, _CMP_LT_OQ), spread_bp, max_bp);
+        spread_bp = _mm512_mask_blend_pd(
+            _mm512_cmp_pd_mask(spread_bp, min_bp, _CMP_LT_OQ), clamped, min_bp);
+        __m512d spread_abs = _mm512_div_pd(_mm512_mul_pd(spread_bp, fair), bp);
+
+        __mmask8 has_limit = _mm512_cmp_pd_mask(max_pos, zero, _CMP_GT_OQ);
+        __m512d q    = _mm512_mask_blend_pd(has_limit, zero, _mm512_div_pd(inv, max_pos));
+        __m512d qs   = _mm512_mask_blend_pd(has_limit, zero, _mm512_div_pd(sinv, max_pos));
+        __m512d skew = _mm512_mask_blend_pd(
+            has_limit, zero, _mm512_mul_pd(_mm512_mul_pd(inv_coeff, qs), spread_abs));
+
+        __m512d abs_inv = _mm512_abs_pd(inv);
+        __m512d shrunk = _mm512_mul_pd(
+            size_base, _mm512_sub_pd(one, _mm512_mul_pd(scale, _mm512_div_pd(abs_inv, max_pos))));
+        __m512d floor_size = _mm512_mul_pd(size_base, tenth);
+        shrunk = _mm512_mask_blend_pd(
+            _mm512_cmp_pd_mask(shrunk, floor_size, _CMP_LT_OQ), shrunk, floor_size);
+        __m512d size = _mm512_mask_blend_pd(has_limit, size_base, shrunk);
+
+        __m512d half = _mm512_div_pd(spread_abs, two);
+        __m512d bid = _mm512_sub_pd(_mm512_sub_pd(fair, half), skew);
+        __m512d ask = _mm512_sub_pd(_mm512_add_pd(fair, half), skew);
+
+        __m512d fb = _mm512_sub_pd(one, q);
+        fb = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(tenth, fb, _CMP_LT_OQ), tenth, fb);
+        __m512d bid_size = _mm512_mask_blend_pd(
+            _mm512_cmp_pd_mask(q, lim, _CMP_GT_OQ), size, _mm512_mul_pd(size, fb));
+        __m512d fa = _mm512_add_pd(one, q);
+        fa = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(tenth, fa, _CMP_LT_OQ), tenth, fa);
+        __m512d ask_size = _mm512_mask_blend_pd(
+            _mm512_cmp_pd_mask(q, neg_lim, _CMP_LT_OQ), size, _mm512_mul_pd(size, fa));
+
+        __m512d vbt = roundscale<kFloor>(_mm512_add_pd(_mm512_div_pd(bid, tick), eps));
+        __m512d vat = roundscale<kCeil>(_mm512_sub_pd(_mm512_div_pd(ask, tick), eps));
+        vat = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(vat, vbt, _CMP_LE_OQ), vat,
+                                   _mm512_add_pd(vbt, one));
+
+        __m512d vbl = _mm512_div_pd(bid_size, lot);
+        vbl = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(vbl, zero, _CMP_GE_OQ),
+                                   roundscale<kCeil>(_mm512_sub_pd(vbl, eps)),
+                                   roundscale<kFloor>(_mm512_add_pd(vbl, eps)));
+        __m512d val = _mm512_div_pd(ask_size, lot);
+        val = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(val, zero, _CMP_GE_OQ),
+                                   roundscale<kCeil>(_mm512_sub_pd(val, eps)),
+                                   roundscale<kFloor>(_mm512_add_pd(val, eps)));
+
+        __mmask8 ok = _mm512_cmp_pd_mask(fair, zero, _CMP_NLE_UQ);
+        _mm512_store_pd(bt, vbt);
+        _mm512_store_pd(at, vat);
+        _mm512_store_pd(bl, vbl);
+        _mm512_store_pd(al, val);
+        for (size_t k = 0; k < 8; ++k) {
+            bool live = (ok >> k) & 1;
+            out.bid_ticks[i + k] = live ? static_cast<PriceTicks>(bt[k]) : 0;
+            out.ask_ticks[i + k] = live ? static_cast<PriceTicks>(at[k]) : 0;
+            out.bid_lots[i + k]  = live ? static_cast<QtyLots>(bl[k]) : 0;
+            out.ask_lots[i + k]  = live ? static_cast<QtyLots>(al[k]) : 0;
+        }
+    }
+    compute_quotes_scalar(in, out, i);
+}
+
+#endif // MME_X86_DISPATCH
+
+} // anonymous namespace
+
+QuoteLane quote_lane(double fair, double volatility, double inventory,
+                     const MarketMakingParams& p) {
+    return quote_lane(fair, volatility, inventory, inventory, p);
+}
+
+QuoteLane quote_lane(double fair, double volatility, double inventory, double skew_inventory,
+                     const MarketMakingParams& p) {
+    QuoteLane q;
+    quote_lane_raw(fair, volatility, inventory, skew_inventory,
+                   p.base_spread_bp, p.min_spread_bp, p.max_spread_bp,
+                   p.volatility_coeff, p.inventory_coeff,
+                   p.size_base, p.size_inventory_scale, p.max_position,
+                   p.tick_size, p.lot_size,
+                   q.bid_ticks, q.ask_ticks, q.bid_lots, q.ask_lots);
+    return q;
+}
+
+QuoteKernel best_quote_kernel() {
+    if (cpu_has_avx512f()) return QuoteKernel::Avx512;
+    if (cpu_has_avx2()) return QuoteKernel::Avx2;
+    return QuoteKernel::Scalar;
+}
+
+void compute_quotes(const QuoteBatchInput& in, const QuoteBatchOutput& out) {
+    compute_quotes(in, out, best_quote_kernel());
+}
+
+void compute_quotes(const QuoteBatchInput& in, const QuoteBatchOutput& out, QuoteKernel kernel) {
+#ifdef MME_X86_DISPATCH
+    if (kernel == QuoteKernel::Avx512 && cpu_has_avx512f()) {
+        compute_quotes_avx512(in, out);
+        return;
+    }
+    if (kernel == QuoteKernel::Avx2 && cpu_has_avx2()) {
+        compute_quotes_avx2(in, out);
+        return;
+    }
+#endif
+    (void)kernel;
+    compute_quotes_scalar(in, out, 0);
+}
+
+// --- QuoteBatch ---
+
+void QuoteBatch::reserve(size_t n) {
+    for (auto* v : {&fair_, &volatility_, &inventory_, &skew_inventory_, &base_spread_bp_, &min_spread_bp_,
+                    &max_spread_bp_, &volatility_coeff_, &inventory_coeff_, &size_base_,
+                    &size_inventory_scale_, &max_position_, &tick_size_, &lot_size_}) {
+        v->reserve(n);
+    }
+    for (auto* v : {&bid_ticks_, &ask_ticks_, &bid_lots_, &ask_lots_}) v->reserve(n);
+    params_version_.reserve(n);
+}
+
+void QuoteBatch::clear() {
+    for (auto* v : {&fair_, &volatility_, &inventory_, &skew_inventory_, &base_spread_bp_, &min_spread_bp_,
+                    &max_spread_bp_, &volatility_coeff_, &inventory_coeff_, &size_base_,
+                    &size_inventory_scale_, &max_position_, &tick_size_, &lot_size_}) {
+        v->clear();
+    }
+    params_version_.clear();
+}
+
+size_t QuoteBatch::add(double fair, double volatility, double inventory,
+                       const MarketMakingParams& p, uint64_t params_version) {
+    return add(fair, volatility, inventory, inventory, p, params_version);
+}
+
+size_t QuoteBatch::add(double fair, double volatility, double inventory, double skew_inventory,
+                       const MarketMakingParams& p, uint64_t params_version) {
+    fair_.push_back(fair);
+    volatility_.push_back(volatility);
+    inventory_.push_back(inventory);
+    skew_inventory_.push_back(skew_inventory);
+    base_spread_bp_.push_back(p.base_spread_bp);
+    min_spread_bp_.push_back(p.min_spread_bp);
+    max_spread_bp_.push_back(p.max_spread_bp);
+    volatility_coeff_.push_back(p.volatility_coeff);
+    inventory_coeff_.push_back(p.inventory_coeff);
+    size_base_.push_back(p.size_base);
+    size_inventory_scale_.push_back(p.size_inventory_scale);
+    max_position_.push_back(p.max_position);
+    tick_size_.push_back(p.tick_size);
+    lot_size_.push_back(p.lot_size);
+    params_version_.push_back(params_version);
+    return fair_.size() - 1;
+}
+
+QuoteBatchInput QuoteBatch::input() const {
+    return QuoteBatchInput{
+        .n                    = fair_.size(),
+        .fair                 = fair_.data(),
+        .volatility           = volatility_.data(),
+        .inventory            = inventory_.data(),
+        .skew_inventory       = skew_inventory_.data(),
+        .base_spread_bp       = base_spread_bp_.data(),
+        .min_spread_bp        = min_spread_bp_.data(),
+        .max_spread_bp        = max_spread_bp_.data(),
+        .volatility_coeff     = volatility_coeff_.data(),
+        .inventory_coeff      = inventory_coeff_.data(),
+        .size_base            = size_base_.data(),
+        .size_inventory_scale = size_inventory_scale_.data(),
+        .max_position         = max_position_.data(),
+        .tick_size            = tick_size_.data(),
+        .lot_size             = lot_size_.data(),
+    };
+}
+
+QuoteBatchOutput QuoteBatch::output() {
+    const size_t n = fair_.size();
+    for (auto* v : {&bid_ticks_, &ask_ticks_, &bid_lots_, &ask_lots_}) v->resize(n);
+    return QuoteBatchOutput{
+        .bid_ticks = bid_ticks_.data(),
+        .ask_ticks = ask_ticks_.data(),
+        .bid_lots  = bid_lots_.data(),
+        .ask_lots  = ask_lots_.data(),
+    };
+}
+
+} // namespace mme
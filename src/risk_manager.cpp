@@ -1,17 +1,41 @@
 #include "risk/risk_manager.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 namespace mme {
 
 const InstrumentPosition RiskManager::kEmptyPosition = {};
+const OpenOrders         RiskManager::kNoOpenOrders  = {};
 
-RiskManager::RiskManager(std::unordered_map<InstrumentId, MarketMakingParams> params)
-    : params_(std::move(params)) {}
+RiskManager::RiskManager(const std::unordered_map<InstrumentId, MarketMakingParams>& params)
+    : RiskManager(InstrumentRegistry::from_keys(params), params) {}
+
+RiskManager::RiskManager(const InstrumentRegistry& registry,
+                         const std::unordered_map<InstrumentId, MarketMakingParams>& params)
+    : RiskManager(std::make_shared<ParamStore>(registry, params)) {}
+
+RiskManager::RiskManager(std::shared_ptr<const ParamStore> store)
+    : store_(std::move(store)),
+      registry_(store_->registry()),
+      open_(registry_.size()) {
+    portfolio_.positions.resize(registry_.size());
+    for (InstrumentIndex i = 0; i < registry_.size(); ++i) {
+        portfolio_.positions[i].id = registry_.id(i);
+    }
+}
 
 void RiskManager::on_fill(InstrumentId id, double price, double qty) {
-    auto& pos = portfolio_.positions[id];
-    pos.id = id;
+    InstrumentIndex index = registry_.index(id);
+    if (index == kNoInstrument) {
+        index = registry_.add_instrument(id);
+        portfolio_.positions.push_back(InstrumentPosition{.id = id});
+    }
+    on_fill_at(index, price, qty);
+}
+
+void RiskManager::on_fill_at(InstrumentIndex index, double price, double qty) {
+    auto& pos = portfolio_.positions[index];
 
     double old_qty = pos.quantity;
     double new_qty = old_qty + qty;
@@ -44,56 +68,220 @@ void RiskManager::on_fill(InstrumentId id, double price, double qty) {
     }
 
     pos.quantity = new_qty;
+    refresh_position(pos);
+}
+
+void RiskManager::on_mark(InstrumentId id, double mid) {
+    InstrumentIndex index = registry_.index(id);
+    if (index != kNoInstrument) on_mark_at(index, mid);
+}
+
+void RiskManager::on_mark_at(InstrumentIndex index, double mid) {
+    if (index >= portfolio_.positions.size() || mid <= 0.0) return;
+    auto& pos = portfolio_.positions[index];
+    pos.mark_price = mid;
+    if (var_) var_->on_mid_at(index, mid);
+    refresh_position(pos);
+}
+
+void RiskManager::refresh_position(InstrumentPosition& pos) {
+    double unrealized = 0.0;
+    if (pos.mark_price > 0.0 && std::abs(pos.quantity) > 1e-12) {
+        unrealized = (pos.mark_price - pos.avg_price) * pos.quantity;
+    }
+    double price    = pos.mark_price > 0.0 ? pos.mark_price : pos.avg_price;
+    double exposure = pos.quantity * price;
+    double notional = std::abs(pos.quantity) * price;
+
+    portfolio_.total_unrealized_pnl += unrealized - pos.unrealized_pnl;
+    portfolio_.total_net_exposure   += exposure - pos.net_exposure;
+    portfolio_.total_gross_notional += notional - pos.gross_notional;
+    pos.unrealized_pnl = unrealized;
+    pos.net_exposure   = exposure;
+    pos.gross_notional = notional;
+    const auto index = static_cast<InstrumentIndex>(&pos - portfolio_.positions.data());
+    if (var_) var_->set_exposure_at(index, exposure);
+    if (factors_) factors_->set_exposure_at(index, exposure);
 }
 
-bool RiskManager::can_quote(InstrumentId id, double bid_size, double ask_size) const {
-    auto it = params_.find(id);
-    if (it == params_.end()) return false;
+void RiskManager::enable_portfolio_var(const VarConfig& config, const Clock* clock) {
+    var_ = std::make_unique<PortfolioVarEngine>(registry_, config, clock);
+    for (InstrumentIndex i = 0; i < var_->size(); ++i) {
+        const auto& pos = portfolio_.positions[i];
+        if (pos.mark_price > 0.0) var_->on_mid_at(i, pos.mark_price);
+        var_->set_exposure_at(i, pos.net_exposure);
+    }
+}
+
+FactorExposure& RiskManager::enable_factor_exposure(size_t num_factors) {
+    factors_ = std::make_unique<FactorExposure>(registry_, num_factors);
+    for (InstrumentIndex i = 0; i < factors_->size(); ++i) {
+        factors_->set_exposure_at(i, portfolio_.positions[i].net_exposure);
+    }
+    return *factors_;
+}
 
-    auto pos_it = portfolio_.positions.find(id);
-    double current_qty = (pos_it != portfolio_.positions.end()) ? pos_it->second.quantity : 0.0;
+bool RiskManager::can_quote_at(InstrumentIndex index, double bid_size, double ask_size) const {
+    const MarketMakingParams* p = params_at(index);
+    if (p == nullptr) return false;
+
+    double current_qty = portfolio_.positions[index].quantity;
 
     // Check if buying bid_size or selling ask_size would breach limits
-    double max_pos = it->second.max_position;
+    double max_pos = p->max_position;
     bool buy_ok = std::abs(current_qty + bid_size) <= max_pos;
     bool sell_ok = std::abs(current_qty - ask_size) <= max_pos;
 
     return buy_ok || sell_ok; // At least one side should be quoteable
 }
 
-bool RiskManager::within_limits(InstrumentId id, double delta_qty) const {
-    auto it = params_.find(id);
-    if (it == params_.end()) return false;
+bool RiskManager::within_limits_at(InstrumentIndex index, double delta_qty) const {
+    const MarketMakingParams* p = params_at(index);
+    if (p == nullptr) return false;
+
+    const OpenOrders& open = open_orders_at(index);
+    const PriceScale scale = p->scale();
+    double current_qty = portfolio_.positions[index].quantity;
+    double worst = delta_qty >= 0.0 ? current_qty + scale.to_qty(open.buy_lots) + delta_qty
+                                    : current_qty - scale.to_qty(open.sell_lots) + delta_qty;
+    return std::abs(worst) <= p->max_position;
+}
+
+RiskCheck RiskManager::check_order_at(InstrumentIndex index, PriceTicks price, QtyLots lots,
+                                      Timestamp now, PriceTicks replaced_price,
+                                      QtyLots replaced_lots) const {
+    const MarketMakingParams* p = params_at(index);
+    if (p == nullptr) return RiskCheck::NotConfigured;
+
+    const OpenOrders& open = open_orders_at(index);
+    const PriceScale scale = p->scale();
+    const bool    buy      = lots > 0;
+    const QtyLots size     = buy ? lots : -lots;
+    const QtyLots replaced = replaced_lots < 0 ? -replaced_lots : replaced_lots;
+
+    // Worst case: every open order on this side fills, the replaced one excepted.
+    // Only the side that extends the position is bounded, so a reducing
+    // order is never blocked.
+    const double qty = portfolio_.positions[index].quantity;
+    if (buy) {
+        if (qty + scale.to_qty(open.buy_lots - replaced + size) > p->max_position) {
+            return RiskCheck::PositionLimit;
+        }
+    } else if (qty - scale.to_qty(open.sell_lots - replaced + size) < -p->max_position) {
+        return RiskCheck::PositionLimit;
+    }
+
+    const double added = static_cast<double>(size * price - replaced * replaced_price) *
+                         scale.tick_size * scale.lot_size;
+    if (limits_.max_gross_notional > 0.0) {
+        // The part of the order that unwinds the position (beyond what the
+        // other open orders on this side already unwind) adds no gross, and
+        // an order that adds none passes even over the limit
+        const QtyLots held      = scale.to_lots(buy ? std::max(-qty, 0.0) : std::max(qty, 0.0));
+        const QtyLots unwinding = std::max<QtyLots>(
+            held - ((buy ? open.buy_lots : open.sell_lots) - replaced), 0);
+        const QtyLots extending = std::max<QtyLots>(size - unwinding, 0);
+        const double gross_added =
+            static_cast<double>(extending * price - replaced * replaced_price) *
+            scale.tick_size * scale.lot_size;
+        if (gross_added > 0.0 &&
+            portfolio_.total_gross_notional + open_buy_notional_ + open_sell_notional_ +
+                    gross_added > limits_.max_gross_notional) {
+            return RiskCheck::GrossNotional;
+        }
+    }
+    if (limits_.max_net_exposure > 0.0) {
+        if (buy ? portfolio_.total_net_exposure + open_buy_notional_ + added >
+                      limits_.max_net_exposure
+                : portfolio_.total_net_exposure - open_sell_notional_ - added <
+                      -limits_.max_net_exposure) {
+            return RiskCheck::NetExposure;
+        }
+    }
+
+    // Reducing orders always pass, so a breach never blocks unwinding
+    if (var_ && limits_.max_var > 0.0) {
+        const int64_t open_lot_ticks = buy ? open.buy_lot_ticks : -open.sell_lot_ticks;
+        const double delta = static_cast<double>(open_lot_ticks) * scale.tick_size * scale.lot_size +
+                             (buy ? added : -added);
+        const double after = var_->var_with(index, delta);
+        if (after > limits_.max_var && after > var_->var()) return RiskCheck::PortfolioVar;
+    }
+
+    // Generic cell rate algorithm: one timestamp per instrument, bursts of
+    // up to one second's worth of orders
+    if (p->max_order_rate > 0.0) {
+        const double interval = 1e9 / p->max_order_rate;
+        const double burst    = std::max(1.0, p->max_order_rate);
+        const Timestamp tat   = std::max(open.rate_tat, now);
+        if (static_cast<double>(tat - now) > (burst - 1.0) * interval) {
+            return RiskCheck::OrderRate;
+        }
+    }
+    return RiskCheck::Ok;
+}
+
+void RiskManager::on_order_open_at(InstrumentIndex index, PriceTicks price, QtyLots lots,
+                                   Timestamp now) {
+    add_open(index, price, lots, +1);
 
-    auto pos_it = portfolio_.positions.find(id);
-    double current_qty = (pos_it != portfolio_.positions.end()) ? pos_it->second.quantity : 0.0;
+    const MarketMakingParams* p = params_at(index);
+    if (p == nullptr || p->max_order_rate <= 0.0 || index >= open_.size()) return;
+    auto& open = open_[index];
+    open.rate_tat = std::max(open.rate_tat, now) +
+                    static_cast<Timestamp>(1e9 / p->max_order_rate);
+}
 
-    return std::abs(current_qty + delta_qty) <= it->second.max_position;
+void RiskManager::on_order_closed_at(InstrumentIndex index, PriceTicks price, QtyLots lots) {
+    add_open(index, price, lots, -1);
+}
+
+void RiskManager::add_open(InstrumentIndex index, PriceTicks price, QtyLots lots, int sign) {
+    const MarketMakingParams* p = params_at(index);
+    if (p == nullptr || index >= open_.size() || lots == 0) return;
+
+    auto& open = open_[index];
+    const double unit = p->tick_size * p->lot_size;
+    const QtyLots size = lots > 0 ? lots : -lots;
+    QtyLots& side_lots      = lots > 0 ? open.buy_lots : open.sell_lots;
+    int64_t& side_lot_ticks = lots > 0 ? open.buy_lot_ticks : open.sell_lot_ticks;
+    double&  side_notional  = lots > 0 ? open_buy_notional_ : open_sell_notional_;
+
+    // A close without a matching open (e.g. a late fill after a mass
+    // cancel) must not leave negative exposure behind
+    const int64_t old_lot_ticks = side_lot_ticks;
+    side_lots      = std::max<QtyLots>(0, side_lots + sign * size);
+    side_lot_ticks = std::max<int64_t>(0, side_lot_ticks + sign * size * price);
+    side_notional += static_cast<double>(side_lot_ticks - old_lot_ticks) * unit;
 }
 
 void RiskManager::update_unrealized(const std::unordered_map<InstrumentId, double>& mid_prices) {
+    for (const auto& [id, mid] : mid_prices) on_mark(id, mid);
+}
+
+void RiskManager::resync_totals() {
     portfolio_.total_unrealized_pnl = 0.0;
-    for (auto& [id, pos] : portfolio_.positions) {
-        auto it = mid_prices.find(id);
-        if (it != mid_prices.end() && std::abs(pos.quantity) > 1e-12) {
-            if (pos.quantity > 0) {
-                pos.unrealized_pnl = (it->second - pos.avg_price) * pos.quantity;
-            } else {
-                pos.unrealized_pnl = (pos.avg_price - it->second) * std::abs(pos.quantity);
-            }
-        } else {
-            pos.unrealized_pnl = 0.0;
-        }
+    portfolio_.total_net_exposure   = 0.0;
+    portfolio_.total_gross_notional = 0.0;
+    for (const auto& pos : portfolio_.positions) {
         portfolio_.total_unrealized_pnl += pos.unrealized_pnl;
+        portfolio_.total_net_exposure   += pos.net_exposure;
+        portfolio_.total_gross_notional += pos.gross_notional;
+    }
+
+    open_buy_notional_  = 0.0;
+    open_sell_notional_ = 0.0;
+    for (InstrumentIndex i = 0; i < open_.size(); ++i) {
+        const MarketMakingParams* p = params_at(i);
+        if (p == nullptr) continue;
+        const double unit = p->tick_size * p->lot_size;
+        open_buy_notional_  += static_cast<double>(open_[i].buy_lot_ticks) * unit;
+        open_sell_notional_ += static_cast<double>(open_[i].sell_lot_ticks) * unit;
     }
 }
 
 const InstrumentPosition& RiskManager::position(InstrumentId id) const {
-    auto it = portfolio_.positions.find(id);
-    if (it != portfolio_.positions.end()) {
-        return it->second;
-    }
-    return kEmptyPosition;
+    return position_at(registry_.index(id));
 }
 
 } // namespace mme
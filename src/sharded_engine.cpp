@@ -0,0 +1,152 @@
+#include "runtime/sharded_engine.hpp"
+#include "util/thread_affinity.hpp"
+
+namespace mme {
+
+namespace {
+
+std::unordered_map<InstrumentId, MarketMakingParams> shard_params(
+    const std::unordered_map<InstrumentId, MarketMakingParams>& params,
+    const std::function<bool(InstrumentId)>& owned) {
+    std::unordered_map<InstrumentId, MarketMakingParams> out;
+    for (const auto& [id, p] : params) {
+        if (owned(id)) out.emplace(id, p);
+    }
+    return out;
+}
+
+} // anonymous namespace
+
+ShardedEngine::Shard::Shard(size_t index_, const ShardedEngineConfig& config,
+                            std::unordered_map<InstrumentId, MarketMakingParams> params,
+                            const std::vector<VenueConfig>& venues,
+                            const GatewayFactory& make_gateway)
+    : index(index_),
+      risk(params),
+      qe(params, &clock),
+      router(venues),
+      queue(config.queue_capacity) {
+    for (const auto& [id, _] : params) instruments.push_back(id);
+
+    gw = make_gateway(index, [this](const Fill& fill) {
+        controller->on_fill(fill);
+        ++fills;
+        published.fills.store(fills, std::memory_order_relaxed);
+        published.realized_pnl.store(risk.portfolio().total_realized_pnl,
+                                     std::memory_order_relaxed);
+    });
+    controller = std::make_unique<MarketMakerController>(md, risk, qe, router, *gw,
+                                                         instruments, &clock);
+}
+
+ShardedEngine::ShardedEngine(const ShardedEngineConfig& config,
+                             const std::unordered_map<InstrumentId, MarketMakingParams>& params,
+                             const std::vector<VenueConfig>& venues,
+                             GatewayFactory make_gateway)
+    : config_(config) {
+    if (config_.num_shards == 0) config_.num_shards = 1;
+    if (config_.publish_every == 0) config_.publish_every = 1;
+    if (config_.shared_ledger) {
+        ledger_ = std::make_unique<SharedRiskLedger>(InstrumentRegistry::from_keys(params),
+                                                     params, config_.firm_limits);
+    }
+
+    shards_.reserve(config_.num_shards);
+    for (size_t s = 0; s < config_.num_shards; ++s) {
+        auto owned = [this, s](InstrumentId id) { return shard_of(id) == s; };
+        shards_.push_back(std::make_unique<Shard>(
+            s, config_, shard_params(params, owned), venues, make_gateway));
+        shards_.back()->controller->set_shared_ledger(ledger_.get());
+    }
+}
+
+ShardedEngine::~ShardedEngine() {
+    stop();
+}
+
+size_t ShardedEngine::shard_of(InstrumentId id) const {
+    // Fibonacci hashing keeps consecutive ids from landing on one shard
+    uint64_t h = (static_cast<uint64_t>(id) * 0x9E3779B97F4A7C15ull) >> 32;
+    return static_cast<size_t>(h % config_.num_shards);
+}
+
+void ShardedEngine::start() {
+    if (running_) return;
+    stopping_.store(false);
+    running_ = true;
+    for (auto& shard : shards_) {
+        Shard& s = *shard;
+        s.thread = std::thread([this, &s] { run_shard(s); });
+    }
+}
+
+void ShardedEngine::dispatch(const VenueBookSnapshot& snapshot, Timestamp ts) {
+    Shard& s = *shards_[shard_of(snapshot.instrument)];
+    ShardEvent ev{.snapshot = snapshot, .ts = ts};
+    while (!s.queue.try_push(ev)) backoff(config_.wait);
+    s.wake.notify(config_.wait);
+}
+
+void ShardedEngine::stop() {
+    if (!running_) return;
+    stopping_.store(true, std::memory_order_release);
+    for (auto& shard : shards_) shard->wake.notify(config_.wait);
+    for (auto& shard : shards_) shard->thread.join();
+    running_ = false;
+}
+
+PortfolioTotals ShardedEngine::totals() const {
+    PortfolioTotals t;
+    for (const auto& shard : shards_) {
+        const auto& p = shard->published;
+        t.realized_pnl   += p.realized_pnl.load(std::memory_order_relaxed);
+        t.unrealized_pnl += p.unrealized_pnl.load(std::memory_order_relaxed);
+        t.net_exposure   += p.net_exposure.load(std::memory_order_relaxed);
+        t.gross_notional += p.gross_notional.load(std::memory_order_relaxed);
+        t.ticks          += p.ticks.load(std::memory_order_relaxed);
+        t.fills          += p.fills.load(std::memory_order_relaxed);
+    }
+    return t;
+}
+
+void ShardedEngine::run_shard(Shard& shard) {
+    int cpu = shard.index < config_.shard_cpus.size() ? config_.shard_cpus[shard.index] : -1;
+    pin_current_thread(cpu);
+
+    ShardEvent ev;
+    for (;;) {
+        uint32_t seen = shard.wake.observe();
+        if (shard.queue.try_pop(ev)) {
+            shard.clock.set(ev.ts);
+            shard.controller->on_market_data(ev.snapshot);
+            if (const auto* view = shard.md.find_view(ev.snapshot.instrument)) {
+                shard.risk.on_mark(ev.snapshot.instrument, view->mid_price);
+                if (ledger_) ledger_->on_mark(ev.snapshot.instrument, view->mid_price);
+            }
+            if (after_md_) after_md_(shard.index, *shard.gw, ev.snapshot);
+
+            ++shard.ticks;
+            shard.published.ticks.store(shard.ticks, std::memory_order_relaxed);
+            if (config_.resync_every != 0 && shard.ticks % config_.resync_every == 0) {
+                shard.risk.resync_totals();
+            }
+            if (shard.ticks % config_.publish_every == 0) publish(shard);
+            continue;
+        }
+        if (stopping_.load(std::memory_order_acquire) && shard.queue.empty()) break;
+        shard.wake.idle(config_.wait, seen);
+    }
+    shard.risk.resync_totals();
+    publish(shard);
+}
+
+void ShardedEngine::publish(Shard& shard) {
+    const auto& pf = shard.risk.portfolio();
+    auto& p = shard.published;
+    p.realized_pnl.store(pf.total_realized_pnl, std::memory_order_relaxed);
+    p.unrealized_pnl.store(pf.total_unrealized_pnl, std::memory_order_relaxed);
+    p.net_exposure.store(pf.total_net_exposure, std::memory_order_relaxed);
+    p.gross_notional.store(pf.total_gross_notional, std::memory_order_relaxed);
+}
+
+} // namespace mme
@@ -0,0 +1,181 @@
+#include "risk/shared_risk_ledger.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace mme {
+
+SharedRiskLedger::SharedRiskLedger(
+    const InstrumentRegistry& registry,
+    const std::unordered_map<InstrumentId, MarketMakingParams>& params,
+    const PortfolioLimits& limits)
+    : registry_(registry),
+      limits_(limits),
+      max_gross_units_(std::llround(limits.max_gross_notional / kLedgerNotionalUnit)),
+      max_net_units_(std::llround(limits.max_net_exposure / kLedgerNotionalUnit)),
+      slots_(std::make_unique<Slot[]>(registry_.size())) {
+    for (InstrumentIndex i = 0; i < registry_.size(); ++i) {
+        auto it = params.find(registry_.id(i));
+        if (it == params.end()) continue;
+        const PriceScale scale = it->second.scale();
+        auto& slot = slots_[i];
+        slot.max_lots   = scale.to_lots(it->second.max_position);
+        slot.tick_size  = scale.tick_size;
+        slot.unit_value = scale.tick_size * scale.lot_size;
+        slot.configured = true;
+    }
+}
+
+int64_t SharedRiskLedger::to_units(const Slot& slot, int64_t lot_ticks) const {
+    return std::llround(static_cast<double>(lot_ticks) * slot.unit_value / kLedgerNotionalUnit);
+}
+
+bool SharedRiskLedger::claim(std::atomic<int64_t>& value, int64_t delta, int64_t max) {
+    if (max == 0) {
+        value.fetch_add(delta, std::memory_order_acq_rel);
+        return true;
+    }
+    int64_t cur = value.load(std::memory_order_relaxed);
+    for (;;) {
+        const int64_t next = cur + delta;
+        // Only a move toward the bound can breach it
+        if ((delta > 0 && next > max) || (delta < 0 && next < -max)) return false;
+        if (value.compare_exchange_weak(cur, next, std::memory_order_acq_rel,
+                                        std::memory_order_relaxed)) {
+            return true;
+        }
+        counters_.cas_retries.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+RiskCheck SharedRiskLedger::reserve(InstrumentIndex index, PriceTicks price, QtyLots lots,
+                                    LedgerReservation* out) {
+    if (index >= registry_.size() || !slots_[index].configured || lots == 0) {
+        return RiskCheck::NotConfigured;
+    }
+    Slot& slot = slots_[index];
+    const bool    buy  = lots > 0;
+    const QtyLots size = buy ? lots : -lots;
+    auto& open = buy ? slot.open_buy : slot.open_sell;
+
+    // Worst-case position: the order plus every open order on its side
+    // filling. A commit raises the position before it drops the open lots,
+    // so a racing fill can only make this look worse. The open lots are
+    // read with acquire (here and on a failed CAS) so the position loaded
+    // after them is at least as new as the commit that last changed them.
+    QtyLots cur = open.load(std::memory_order_acquire);
+    for (;;) {
+        const QtyLots pos = slot.position.load(std::memory_order_acquire);
+        const bool over = buy ? pos + cur + size > slot.max_lots
+                              : pos - cur - size < -slot.max_lots;
+        if (over) {
+            counters_.position_limit.fetch_add(1, std::memory_order_relaxed);
+            return RiskCheck::PositionLimit;
+        }
+        if (open.compare_exchange_weak(cur, cur + size, std::memory_order_acq_rel,
+                                       std::memory_order_acquire)) {
+            break;
+        }
+        counters_.cas_retries.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const int64_t notional = to_units(slot, size * price);
+    if (!claim(totals_.gross, notional, max_gross_units_)) {
+        open.fetch_sub(size, std::memory_order_acq_rel);
+        counters_.gross_notional.fetch_add(1, std::memory_order_relaxed);
+        counters_.rollbacks.fetch_add(1, std::memory_order_relaxed);
+        return RiskCheck::GrossNotional;
+    }
+    if (!claim(buy ? totals_.longs : totals_.shorts, buy ? notional : -notional,
+               max_net_units_)) {
+        totals_.gross.fetch_sub(notional, std::memory_order_acq_rel);
+        open.fetch_sub(size, std::memory_order_acq_rel);
+        counters_.net_exposure.fetch_add(1, std::memory_order_relaxed);
+        counters_.rollbacks.fetch_add(1, std::memory_order_relaxed);
+        return RiskCheck::NetExposure;
+    }
+
+    if (out) *out = LedgerReservation{.index = index, .lots = lots, .notional = notional};
+    return RiskCheck::Ok;
+}
+
+void SharedRiskLedger::release(LedgerReservation& r) {
+    if (!r) return;
+    Slot& slot = slots_[r.index];
+    if (r.lots > 0) {
+        slot.open_buy.fetch_sub(r.lots, std::memory_order_acq_rel);
+        totals_.longs.fetch_sub(r.notional, std::memory_order_acq_rel);
+    } else {
+        slot.open_sell.fetch_sub(-r.lots, std::memory_order_acq_rel);
+        totals_.shorts.fetch_add(r.notional, std::memory_order_acq_rel);
+    }
+    totals_.gross.fetch_sub(r.notional, std::memory_order_acq_rel);
+    r = LedgerReservation{};
+}
+
+void SharedRiskLedger::commit(LedgerReservation& r, QtyLots lots, PriceTicks fill_price) {
+    if (!r || lots <= 0) return;
+    const QtyLots remaining = r.lots > 0 ? r.lots : -r.lots;
+    const QtyLots filled    = std::min(lots, remaining);
+    const QtyLots sign      = r.lots > 0 ? 1 : -1;
+
+    // Position first, then the reservation, so the fill is never absent
+    // from both
+    on_fill_at(r.index, fill_price, sign * filled);
+
+    // The last fill returns whatever rounding left over
+    const int64_t part = filled == remaining ? r.notional : r.notional * filled / remaining;
+    LedgerReservation piece{.index = r.index, .lots = sign * filled, .notional = part};
+    release(piece);
+    r.lots     -= sign * filled;
+    r.notional -= part;
+    if (r.lots == 0) r = LedgerReservation{};
+}
+
+void SharedRiskLedger::on_fill_at(InstrumentIndex index, PriceTicks price, QtyLots lots) {
+    if (index >= registry_.size() || lots == 0) return;
+    Slot& slot = slots_[index];
+    slot.position.fetch_add(lots, std::memory_order_acq_rel);
+    const PriceTicks mark = slot.mark.load(std::memory_order_relaxed);
+    revalue(slot, mark > 0 ? mark : price);
+}
+
+void SharedRiskLedger::on_mark_at(InstrumentIndex index, PriceTicks mid) {
+    if (index >= registry_.size() || mid <= 0) return;
+    Slot& slot = slots_[index];
+    slot.mark.store(mid, std::memory_order_relaxed);
+    revalue(slot, mid);
+}
+
+void SharedRiskLedger::on_mark(InstrumentId id, double mid) {
+    InstrumentIndex index = registry_.index(id);
+    if (index == kNoInstrument || !slots_[index].configured) return;
+    on_mark_at(index, std::llround(mid / slots_[index].tick_size));
+}
+
+void SharedRiskLedger::revalue(Slot& slot, PriceTicks price) {
+    const QtyLots pos   = slot.position.load(std::memory_order_relaxed);
+    const int64_t net   = to_units(slot, pos * price);
+    const int64_t gross = net < 0 ? -net : net;
+    const int64_t dnet  = net - slot.net_units;
+
+    totals_.gross.fetch_add(gross - slot.gross_units, std::memory_order_acq_rel);
+    if (dnet != 0) {
+        totals_.longs.fetch_add(dnet, std::memory_order_acq_rel);
+        totals_.shorts.fetch_add(dnet, std::memory_order_acq_rel);
+    }
+    slot.gross_units = gross;
+    slot.net_units   = net;
+}
+
+LedgerStats SharedRiskLedger::stats() const {
+    return LedgerStats{
+        .cas_retries    = counters_.cas_retries.load(std::memory_order_relaxed),
+        .rollbacks      = counters_.rollbacks.load(std::memory_order_relaxed),
+        .position_limit = counters_.position_limit.load(std::memory_order_relaxed),
+        .gross_notional = counters_.gross_notional.load(std::memory_order_relaxed),
+        .net_exposure   = counters_.net_exposure.load(std::memory_order_relaxed),
+    };
+}
+
+} // namespace mme
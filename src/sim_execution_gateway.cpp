@@ -4,58 +4,32 @@ namespace mme {
 
 // --- SimExecutionGateway ---
 
-SimExecutionGateway::SimExecutionGateway(FillCallback on_fill)
-    : on_fill_(std::move(on_fill)) {}
-
 uint64_t SimExecutionGateway::send_limit_order(const LiveOrder& order) {
-    uint64_t id = next_order_id_++;
-    LiveOrder stored = order;
-    stored.id = id;
-    orders_[id] = stored;
-    return id;
+    return sim_.send_limit_order(order);
 }
 
 void SimExecutionGateway::cancel_order(uint64_t order_id) {
-    orders_.erase(order_id);
+    sim_.cancel_order(order_id);
+}
+
+bool SimExecutionGateway::amend_order(uint64_t order_id, double new_price, double new_size) {
+    return sim_.amend_order(order_id, new_price, new_size);
+}
+
+bool SimExecutionGateway::amend_limit_order(const LiveOrder& order) {
+    return sim_.amend_limit_order(order);
 }
 
-void SimExecutionGateway::check_fills(const VenueBookSnapshot& snapshot) {
-    std::vector<uint64_t> filled_ids;
-
-    for (auto& [id, order] : orders_) {
-        if (order.instrument != snapshot.instrument || order.venue != snapshot.venue) {
-            continue;
-        }
-
-        bool fill = false;
-        double fill_price = order.price;
-
-        if (order.side == OrderSide::Buy) {
-            // Buy order fills if best ask <= order price
-            if (!snapshot.asks.empty() && snapshot.asks.front().price <= order.price) {
-                fill = true;
-                fill_price = order.price; // filled at limit
-            }
-        } else {
-            // Sell order fills if best bid >= order price
-            if (!snapshot.bids.empty() && snapshot.bids.front().price >= order.price) {
-                fill = true;
-                fill_price = order.price;
-            }
-        }
-
-        if (fill) {
-            double signed_qty = (order.side == OrderSide::Buy) ? order.size : -order.size;
-            if (on_fill_) {
-                on_fill_(order.instrument, order.venue, fill_price, signed_qty);
-            }
-            filled_ids.push_back(id);
-        }
-    }
-
-    for (uint64_t id : filled_ids) {
-        orders_.erase(id);
-    }
+size_t SimExecutionGateway::cancel_all() {
+    return sim_.cancel_all();
+}
+
+size_t SimExecutionGateway::cancel_instrument(InstrumentId instrument) {
+    return sim_.cancel_instrument(instrument);
+}
+
+size_t SimExecutionGateway::cancel_venue(VenueId venue) {
+    return sim_.cancel_venue(venue);
 }
 
 // --- NullExecutionGateway ---
@@ -69,4 +43,30 @@ void NullExecutionGateway::cancel_order(uint64_t /*order_id*/) {
     ++cancels_sent_;
 }
 
+bool NullExecutionGateway::amend_order(uint64_t /*order_id*/, double /*new_price*/,
+                                       double /*new_size*/) {
+    ++amends_sent_;
+    return true;
+}
+
+void NullExecutionGateway::send_batch(std::span<OrderAction> actions) {
+    ++batches_sent_;
+    IExecutionGateway::send_batch(actions);
+}
+
+size_t NullExecutionGateway::cancel_all() {
+    ++mass_cancels_;
+    return 0;
+}
+
+size_t NullExecutionGateway::cancel_instrument(InstrumentId /*instrument*/) {
+    ++mass_cancels_;
+    return 0;
+}
+
+size_t NullExecutionGateway::cancel_venue(VenueId /*venue*/) {
+    ++mass_cancels_;
+    return 0;
+}
+
 } // namespace mme
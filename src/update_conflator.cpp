@@ -0,0 +1,41 @@
+#include "strategy/update_conflator.hpp"
+
+namespace mme {
+
+UpdateConflator::UpdateConflator(ConflationConfig config)
+    : config_(config), slots_(256) {
+    pending_.reserve(256);
+}
+
+void UpdateConflator::push(const VenueBookSnapshot& snapshot, Timestamp now) {
+    ++stats_.received;
+    ++received_in_window_;
+    if (pending_.empty()) {
+        first_pending_ts_ = now;
+    }
+
+    uint64_t k = key(snapshot.instrument, snapshot.venue);
+    uint32_t slot = slots_.find(k);
+    if (slot != FlatIndexMap::kNotFound) {
+        pending_[slot] = snapshot;   // latest wins
+        ++stats_.conflated;
+        return;
+    }
+    slots_.insert(k, static_cast<uint32_t>(pending_.size()));
+    pending_.push_back(snapshot);
+}
+
+bool UpdateConflator::ready(Timestamp now) const {
+    if (pending_.empty()) return false;
+    switch (config_.policy) {
+        case ConflationPolicy::LatestWins:
+            return true;
+        case ConflationPolicy::TimeWindow:
+            return now - first_pending_ts_ >= ms_to_ns(config_.time_window_ms);
+        case ConflationPolicy::CountWindow:
+            return received_in_window_ >= config_.count_window;
+    }
+    return true;
+}
+
+} // namespace mme
@@ -0,0 +1,73 @@
+#include "market/volatility_estimators.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace mme {
+
+namespace {
+
+// Parkinson (1980): E[ln(H/L)^2] = 4 ln(2) sigma^2
+const double kParkinsonScale = 1.0 / (4.0 * std::log(2.0));
+
+} // anonymous namespace
+
+VolatilityTracker::VolatilityTracker(const std::array<double, kNumEwmaHorizons>& alphas)
+    : alpha_(alphas) {
+    for (size_t i = 0; i < kNumEwmaHorizons; ++i) {
+        decay_[i] = 1.0 - alpha_[i];
+    }
+}
+
+void VolatilityTracker::on_mid(double mid) {
+    if (mid <= 0.0) return;
+
+    if (last_mid_ <= 0.0) {
+        last_mid_ = mid;
+        bar_high_ = bar_low_ = mid;
+        return;
+    }
+
+    double log_return = std::log(mid / last_mid_);
+    double r2 = log_return * log_return;
+    last_mid_ = mid;
+
+    // EWMA: variance_t = alpha * r_t^2 + (1 - alpha) * variance_{t-1},
+    // seeded with the first squared return. All horizons in one pass.
+    if (!initialized_) {
+        variance_.fill(r2);
+        initialized_ = true;
+    } else {
+        for (size_t i = 0; i < kNumEwmaHorizons; ++i) {
+            variance_[i] = alpha_[i] * r2 + decay_[i] * variance_[i];
+        }
+    }
+    for (size_t i = 0; i < kNumEwmaHorizons; ++i) {
+        estimates_.ewma[i] = std::sqrt(variance_[i]);
+    }
+
+    // Rolling realized variance over the ring window
+    double evicted = 0.0;
+    if (returns_sq_.push(r2, evicted)) {
+        sum_returns_sq_ -= evicted;
+    }
+    sum_returns_sq_ += r2;
+    double realized_var = std::max(0.0, sum_returns_sq_) / static_cast<double>(returns_sq_.size());
+    estimates_.realized = std::sqrt(realized_var);
+
+    // High-low range over fixed bars, scaled to per-tick variance and
+    // smoothed with the primary EWMA horizon.
+    bar_high_ = std::max(bar_high_, mid);
+    bar_low_ = std::min(bar_low_, mid);
+    if (++bar_ticks_ == kRangeBarTicks) {
+        double hl = std::log(bar_high_ / bar_low_);
+        double bar_var = kParkinsonScale * hl * hl / static_cast<double>(kRangeBarTicks);
+        range_var_ = range_ready_ ? alpha_[0] * bar_var + decay_[0] * range_var_ : bar_var;
+        range_ready_ = true;
+        estimates_.range = std::sqrt(range_var_);
+        bar_high_ = bar_low_ = mid;
+        bar_ticks_ = 0;
+    }
+}
+
+} // namespace mme
@@ -6,6 +6,9 @@
 #include "execution/sim_execution_gateway.hpp"
 #include "execution/venue_router.hpp"
 #include "backtest/backtest_runner.hpp"
+#include "runtime/sharded_engine.hpp"
+
+#include <random>
 
 using namespace mme;
 
@@ -45,10 +48,11 @@ TEST_F(EndToEndTest, ControllerQuotesOnMarketData) {
     VenueRouter router(venues);
 
     int fill_count = 0;
-    SimExecutionGateway gw([&](InstrumentId id, VenueId, double price, double qty) {
-        risk.on_fill(id, price, qty);
+    SimExecutionGateway gw([&](const Fill& fill) {
+        risk.on_fill(fill.instrument, fill.price, fill.qty);
         fill_count++;
     });
+    gw.set_tick_sizes(params_map);
 
     MarketMakerController controller(md, risk, qe, router, gw, instruments);
 
@@ -71,9 +75,10 @@ TEST_F(EndToEndTest, MultiInstrumentQuoting) {
     QuoteEngine qe(params_map);
     VenueRouter router(venues);
 
-    SimExecutionGateway gw([&](InstrumentId id, VenueId, double price, double qty) {
-        risk.on_fill(id, price, qty);
+    SimExecutionGateway gw([&](const Fill& fill) {
+        risk.on_fill(fill.instrument, fill.price, fill.qty);
     });
+    gw.set_tick_sizes(params_map);
 
     MarketMakerController controller(md, risk, qe, router, gw, instruments);
 
@@ -92,15 +97,407 @@ TEST_F(EndToEndTest, MultiInstrumentQuoting) {
     EXPECT_GE(gw.active_order_count(), 3u);
 }
 
+TEST_F(EndToEndTest, MisalignedRegistriesThrow) {
+    QuoteEngine qe(params_map);
+    VenueRouter router(venues);
+    NullExecutionGateway gw;
+
+    // Risk manager indexes the same instruments in another order
+    InstrumentRegistry reversed;
+    for (InstrumentId id = 3; id >= 1; --id) reversed.add_instrument(id);
+    {
+        MarketDataAggregator md;
+        RiskManager risk(reversed, params_map);
+        EXPECT_THROW(MarketMakerController(md, risk, qe, router, gw, instruments),
+                     std::invalid_argument);
+    }
+
+    // Aggregator already saw another instrument first
+    {
+        MarketDataAggregator md;
+        VenueBookSnapshot snap;
+        snap.instrument = 9;
+        snap.venue = 1;
+        snap.bids = {{99.5, 10.0}};
+        snap.asks = {{100.5, 10.0}};
+        md.on_book_update(snap);
+        RiskManager risk(params_map);
+        EXPECT_THROW(MarketMakerController(md, risk, qe, router, gw, instruments),
+                     std::invalid_argument);
+    }
+
+    MarketDataAggregator md;
+    RiskManager risk(params_map);
+    EXPECT_NO_THROW(MarketMakerController(md, risk, qe, router, gw, instruments));
+}
+
+TEST_F(EndToEndTest, UnchangedTouchSkipsRequote) {
+    MarketDataAggregator md;
+    RiskManager risk(params_map);
+    QuoteEngine qe(params_map);
+    VenueRouter router(venues);
+    NullExecutionGateway gw;
+
+    MarketMakerController controller(md, risk, qe, router, gw, instruments);
+
+    VenueBookSnapshot snap;
+    snap.instrument = 1;
+    snap.venue = 1;
+    snap.bids = {{99.5, 10.0}};
+    snap.asks = {{100.5, 10.0}};
+    controller.on_market_data(snap);
+    uint64_t sent = gw.orders_sent();
+    EXPECT_EQ(sent, 2u);
+
+    // Same book, then a depth-only change: no new orders
+    controller.on_market_data(snap);
+    snap.bids = {{99.5, 20.0}};
+    controller.on_market_data(snap);
+    EXPECT_EQ(gw.orders_sent(), sent);
+
+    // A fill of the resting bid (the first order sent) forces the next
+    // update through even with an unchanged touch
+    controller.on_fill(Fill{.order_id = 1, .instrument = 1, .venue = 1, .price = 99.5,
+                            .qty = 1.0});
+    snap.bids = {{99.5, 25.0}};
+    controller.on_market_data(snap);
+    EXPECT_GT(gw.orders_sent(), sent);
+}
+
+TEST_F(EndToEndTest, MicropriceRequotesOnDepthChange) {
+    auto params = params_map;
+    for (auto& [id, p] : params) {
+        p.fair_price = FairPrice::Microprice;
+        p.quote_refresh_ms = 0.0;
+    }
+    MarketDataAggregator md;
+    RiskManager risk(params);
+    QuoteEngine qe(params);
+    VenueRouter router(venues);
+    NullExecutionGateway gw;
+
+    MarketMakerController controller(md, risk, qe, router, gw, instruments);
+
+    VenueBookSnapshot snap;
+    snap.instrument = 1;
+    snap.venue = 1;
+    snap.bids = {{99.5, 10.0}};
+    snap.asks = {{100.5, 10.0}};
+    controller.on_market_data(snap);
+    EXPECT_EQ(controller.stats().requotes, 1u);
+
+    // Same touch, heavier bid: the microprice moves, so the quote follows
+    snap.bids = {{99.5, 40.0}};
+    controller.on_market_data(snap);
+    EXPECT_EQ(controller.stats().requotes, 2u);
+
+    // The conflated path does the same
+    snap.bids = {{99.5, 10.0}};
+    controller.enqueue_market_data(snap);
+    EXPECT_EQ(controller.drain_market_data(), 1u);
+    EXPECT_EQ(controller.stats().requotes, 3u);
+}
+
+TEST_F(EndToEndTest, ConflatedBurstRequotesOncePerInstrument) {
+    MarketDataAggregator md;
+    RiskManager risk(params_map);
+    QuoteEngine qe(params_map);
+    VenueRouter router(venues);
+    NullExecutionGateway gw;
+
+    MarketMakerController controller(md, risk, qe, router, gw, instruments);
+
+    // Burst of 10 updates per instrument
+    for (int i = 0; i < 10; ++i) {
+        for (InstrumentId id = 1; id <= 3; ++id) {
+            VenueBookSnapshot snap;
+            snap.instrument = id;
+            snap.venue = 1;
+            double base = 100.0 * id + i * 0.01;
+            snap.bids = {{base - 0.5, 10.0}};
+            snap.asks = {{base + 0.5, 10.0}};
+            controller.enqueue_market_data(snap);
+        }
+    }
+    EXPECT_EQ(gw.orders_sent(), 0u);
+
+    EXPECT_EQ(controller.drain_market_data(), 3u);
+    EXPECT_EQ(gw.orders_sent(), 6u); // one bid + one ask per instrument
+    EXPECT_EQ(controller.conflation_stats().conflated, 27u);
+
+    // Latest state was applied
+    EXPECT_NEAR(md.find_view(2)->mid_price, 200.09, 1e-9);
+    EXPECT_EQ(controller.drain_market_data(), 0u);
+}
+
+TEST_F(EndToEndTest, DrainCountsOnlyRequotedInstruments) {
+    MarketDataAggregator md;
+    RiskManager risk(params_map);
+    QuoteEngine qe(params_map);
+    VenueRouter router(venues);
+    NullExecutionGateway gw;
+    SimulatedClock clock;
+    MarketMakerController controller(md, risk, qe, router, gw, instruments, &clock);
+
+    auto enqueue_all = [&](double offset) {
+        for (InstrumentId id = 1; id <= 3; ++id) {
+            VenueBookSnapshot snap;
+            snap.instrument = id;
+            snap.venue = 1;
+            snap.bids = {{100.0 * id - 0.5 + offset, 10.0}};
+            snap.asks = {{100.0 * id + 0.5 + offset, 10.0}};
+            controller.enqueue_market_data(snap);
+        }
+    };
+    enqueue_all(0.0);
+    EXPECT_EQ(controller.drain_market_data(), 3u);
+
+    // Every touch moved again inside quote_refresh_ms: all throttled
+    clock.advance(kNanosPerMilli);
+    enqueue_all(0.01);
+    EXPECT_EQ(controller.drain_market_data(), 0u);
+    EXPECT_EQ(controller.stats().throttled, 3u);
+}
+
+TEST_F(EndToEndTest, QuoteDiffAndRefreshThrottle) {
+    auto params = params_map;
+    params[1].quote_refresh_ms = 100.0;
+    params[1].tick_size = 0.01;
+    // Quotes round outward onto the grid, so a side can move a tick more
+    // than the mid
+    params[1].requote_min_ticks = 3.0;
+
+    MarketDataAggregator md;
+    RiskManager risk(params);
+    SimulatedClock clock;
+    QuoteEngine qe(params, &clock);
+    VenueRouter router(venues);
+    NullExecutionGateway gw;
+    MarketMakerController controller(md, risk, qe, router, gw, instruments, &clock);
+
+    VenueBookSnapshot snap;
+    snap.instrument = 1;
+    snap.venue = 1;
+    snap.bids = {{99.5, 10.0}};
+    snap.asks = {{100.5, 10.0}};
+    clock.set(ms_to_ns(1000));
+    controller.on_market_data(snap);
+    EXPECT_EQ(gw.orders_sent(), 2u);
+
+    // Touch moves within the refresh interval: throttled
+    snap.bids = {{99.51, 10.0}};
+    clock.set(ms_to_ns(1050));
+    controller.on_market_data(snap);
+    EXPECT_EQ(controller.stats().throttled, 1u);
+    EXPECT_EQ(gw.orders_sent(), 2u);
+
+    // After the interval, a sub-threshold move (one tick of mid) keeps both orders
+    snap.bids = {{99.52, 10.0}};
+    clock.set(ms_to_ns(1200));
+    controller.on_market_data(snap);
+    EXPECT_EQ(controller.stats().sides_unchanged, 2u);
+    EXPECT_EQ(gw.orders_sent(), 2u);
+    EXPECT_EQ(gw.cancels_sent(), 0u);
+
+    // A move of several ticks amends both sides in place
+    snap.bids = {{99.6, 10.0}};
+    snap.asks = {{100.6, 10.0}};
+    clock.set(ms_to_ns(1400));
+    controller.on_market_data(snap);
+    EXPECT_EQ(gw.amends_sent(), 2u);
+    EXPECT_EQ(gw.orders_sent(), 2u);
+    EXPECT_EQ(gw.cancels_sent(), 0u);
+}
+
+TEST_F(EndToEndTest, ThrottledTouchMoveRequotesAfterInterval) {
+    auto params = params_map;
+    params[1].quote_refresh_ms = 100.0;
+
+    MarketDataAggregator md;
+    RiskManager risk(params);
+    SimulatedClock clock;
+    QuoteEngine qe(params, &clock);
+    VenueRouter router(venues);
+    NullExecutionGateway gw;
+    MarketMakerController controller(md, risk, qe, router, gw, instruments, &clock);
+
+    VenueBookSnapshot snap;
+    snap.instrument = 1;
+    snap.venue = 1;
+    snap.bids = {{99.5, 10.0}};
+    snap.asks = {{100.5, 10.0}};
+    clock.set(ms_to_ns(1000));
+    controller.on_market_data(snap);
+    EXPECT_EQ(gw.orders_sent(), 2u);
+
+    // The touch moves inside the refresh interval: nothing is sent yet
+    snap.bids = {{100.5, 10.0}};
+    snap.asks = {{101.5, 10.0}};
+    clock.set(ms_to_ns(1050));
+    controller.on_market_data(snap);
+    EXPECT_EQ(controller.stats().throttled, 1u);
+    EXPECT_EQ(gw.amends_sent(), 0u);
+
+    // Same touch after the interval: the pending move is quoted
+    clock.set(ms_to_ns(1200));
+    controller.on_market_data(snap);
+    EXPECT_EQ(gw.amends_sent(), 2u);
+
+    // ...once
+    clock.set(ms_to_ns(1400));
+    controller.on_market_data(snap);
+    EXPECT_EQ(gw.amends_sent(), 2u);
+}
+
+TEST_F(EndToEndTest, DrainSendsOneBatchAndKillSwitchCancels) {
+    MarketDataAggregator md;
+    RiskManager risk(params_map);
+    QuoteEngine qe(params_map);
+    VenueRouter router(venues);
+    SimExecutionGateway gw([](const Fill&) {});
+    gw.set_tick_sizes(params_map);
+    MarketMakerController controller(md, risk, qe, router, gw, instruments);
+    controller.set_conflation(ConflationConfig{.policy = ConflationPolicy::LatestWins});
+
+    for (InstrumentId id = 1; id <= 3; ++id) {
+        VenueBookSnapshot snap;
+        snap.instrument = id;
+        snap.venue = 1;
+        snap.bids = {{99.5 * id, 10.0}};
+        snap.asks = {{100.5 * id, 10.0}};
+        controller.enqueue_market_data(snap);
+    }
+    EXPECT_EQ(controller.drain_market_data(), 3u);
+    EXPECT_EQ(controller.stats().batches_sent, 1u);
+    EXPECT_EQ(controller.stats().orders_sent, 6u);
+    EXPECT_EQ(gw.active_order_count(), 6u);
+
+    EXPECT_EQ(controller.cancel_instrument_quotes(2), 2u);
+    EXPECT_EQ(gw.active_order_count(), 4u);
+    EXPECT_EQ(controller.cancel_all_quotes(), 4u);
+    EXPECT_EQ(gw.active_order_count(), 0u);
+}
+
+TEST_F(EndToEndTest, ControllerTracksOpenOrdersInRisk) {
+    MarketDataAggregator md;
+    RiskManager risk(params_map);
+    QuoteEngine qe(params_map);
+    VenueRouter router(venues);
+    SimExecutionGateway gw([](const Fill&) {});
+    gw.set_tick_sizes(params_map);
+    MarketMakerController controller(md, risk, qe, router, gw, instruments);
+
+    VenueBookSnapshot snap;
+    snap.instrument = 1;
+    snap.venue = 1;
+    snap.bids = {{99.5, 10.0}};
+    snap.asks = {{100.5, 10.0}};
+    controller.on_market_data(snap);
+
+    const InstrumentIndex i = risk.registry().index(1);
+    const Quote q = qe.compute_quote(*md.find_view(1), risk.position(1), 1);
+    EXPECT_EQ(gw.active_order_count(), 2u);
+    EXPECT_EQ(risk.open_orders_at(i).buy_lots, q.bid_lots);
+    EXPECT_EQ(risk.open_orders_at(i).sell_lots, q.ask_lots);
+    EXPECT_GT(risk.open_buy_notional(), 0.0);
+
+    controller.cancel_all_quotes();
+    EXPECT_EQ(risk.open_orders_at(i).buy_lots, 0);
+    EXPECT_EQ(risk.open_orders_at(i).sell_lots, 0);
+    EXPECT_DOUBLE_EQ(risk.open_buy_notional(), 0.0);
+    EXPECT_DOUBLE_EQ(risk.open_sell_notional(), 0.0);
+}
+
+TEST_F(EndToEndTest, SharedLedgerEnforcesFirmLimitsAcrossControllers) {
+    // Each controller alone fits within the limits; together they do not
+    SharedRiskLedger ledger(InstrumentRegistry::from_keys(params_map), params_map,
+                            PortfolioLimits{.max_gross_notional = 1500.0});
+
+    std::unordered_map<InstrumentId, MarketMakingParams> first{{1, params_map.at(1)}};
+    std::unordered_map<InstrumentId, MarketMakingParams> second{{2, params_map.at(2)}};
+    MarketDataAggregator md1, md2;
+    RiskManager risk1(first), risk2(second);
+    QuoteEngine qe1(first), qe2(second);
+    VenueRouter router(venues);
+    NullExecutionGateway gw1, gw2;
+    MarketMakerController c1(md1, risk1, qe1, router, gw1, {1});
+    MarketMakerController c2(md2, risk2, qe2, router, gw2, {2});
+    c1.set_shared_ledger(&ledger);
+    c2.set_shared_ledger(&ledger);
+
+    VenueBookSnapshot snap;
+    snap.venue = 1;
+    snap.instrument = 1;
+    snap.bids = {{99.5, 10.0}};
+    snap.asks = {{100.5, 10.0}};
+    c1.on_market_data(snap);
+    EXPECT_EQ(gw1.orders_sent(), 2u);
+    const double after_first = ledger.gross_notional();
+    EXPECT_GT(after_first, 0.0);
+
+    snap.instrument = 2;
+    snap.bids = {{199.5, 10.0}};
+    snap.asks = {{200.5, 10.0}};
+    c2.on_market_data(snap);
+    EXPECT_LT(gw2.orders_sent(), 2u);
+    EXPECT_GT(c2.stats().risk_rejects, 0u);
+    EXPECT_LE(ledger.gross_notional(), 1500.0);
+
+    // Pulling the first controller's quotes frees the capacity
+    c1.cancel_all_quotes();
+    EXPECT_LT(ledger.gross_notional(), after_first);
+}
+
+TEST_F(EndToEndTest, OrderRateLimitPullsStaleQuotes) {
+    for (auto& [_, p] : params_map) {
+        p.max_order_rate = 2.0;
+        p.quote_refresh_ms = 0.0;
+    }
+    MarketDataAggregator md;
+    RiskManager risk(params_map);
+    QuoteEngine qe(params_map);
+    VenueRouter router(venues);
+    SimExecutionGateway gw([](const Fill&) {});
+    gw.set_tick_sizes(params_map);
+    SimulatedClock clock(1'000'000'000);
+    MarketMakerController controller(md, risk, qe, router, gw, instruments, &clock);
+
+    // Two orders use the whole burst; each later touch move would amend both
+    VenueBookSnapshot snap;
+    snap.instrument = 1;
+    snap.venue = 1;
+    for (int k = 0; k < 5; ++k) {
+        snap.bids = {{99.0 + k, 10.0}};
+        snap.asks = {{100.0 + k, 10.0}};
+        controller.on_market_data(snap);
+        clock.advance(kNanosPerMilli);
+    }
+    EXPECT_EQ(controller.stats().orders_sent, 2u);
+    EXPECT_EQ(controller.stats().amends_sent, 0u);
+    EXPECT_GT(controller.stats().rate_limited, 0u);
+    // The bid is left crossed by the first move: both stale sides are
+    // pulled, since cancels spend no rate budget
+    EXPECT_EQ(controller.stats().cancels_sent, 2u);
+    EXPECT_EQ(gw.active_order_count(), 0u);
+
+    // Once the budget is back the held sides are quoted again, even though
+    // the touch did not move
+    clock.advance(1000 * kNanosPerMilli);
+    controller.on_market_data(snap);
+    EXPECT_EQ(controller.stats().orders_sent, 4u);
+    EXPECT_EQ(gw.active_order_count(), 2u);
+}
+
 TEST_F(EndToEndTest, FillUpdatesInventory) {
     MarketDataAggregator md;
     RiskManager risk(params_map);
     QuoteEngine qe(params_map);
     VenueRouter router(venues);
 
-    SimExecutionGateway gw([&](InstrumentId id, VenueId, double price, double qty) {
-        risk.on_fill(id, price, qty);
+    SimExecutionGateway gw([&](const Fill& fill) {
+        risk.on_fill(fill.instrument, fill.price, fill.qty);
     });
+    gw.set_tick_sizes(params_map);
 
     MarketMakerController controller(md, risk, qe, router, gw, instruments);
 
@@ -112,6 +509,79 @@ TEST_F(EndToEndTest, FillUpdatesInventory) {
     EXPECT_DOUBLE_EQ(risk.position(1).quantity, 0.0);
 }
 
+TEST_F(EndToEndTest, PartialFillKeepsResidualOpen) {
+    MarketDataAggregator md;
+    RiskManager risk(params_map);
+    QuoteEngine qe(params_map);
+    VenueRouter router(venues);
+    MarketMakerController* ctl = nullptr;
+    SimExecutionGateway gw([&](const Fill& fill) { ctl->on_fill(fill); });
+    gw.set_tick_sizes(params_map);
+    gw.set_partial_fills(true);
+    MarketMakerController controller(md, risk, qe, router, gw, instruments);
+    ctl = &controller;
+
+    VenueBookSnapshot snap;
+    snap.instrument = 1;
+    snap.venue = 1;
+    snap.bids = {{99.5, 10.0}};
+    snap.asks = {{100.5, 10.0}};
+    controller.on_market_data(snap);
+    const InstrumentIndex index = risk.registry().index(1);
+    ASSERT_EQ(risk.open_orders_at(index).buy_lots, 500);   // 5.0 in 0.01 lots
+    const double bid_px = risk.open_buy_notional() / 5.0;
+
+    // An ask shows 2.0 through our bid: 2.0 fills, 3.0 keeps resting
+    VenueBookSnapshot cross = snap;
+    cross.bids = {{98.0, 10.0}};
+    cross.asks = {{99.0, 2.0}};
+    gw.check_fills(cross);
+
+    EXPECT_DOUBLE_EQ(risk.position(1).quantity, 2.0);
+    EXPECT_EQ(risk.open_orders_at(index).buy_lots, 300);
+    EXPECT_NEAR(risk.open_buy_notional(), 3.0 * bid_px, 1e-9);
+    EXPECT_EQ(gw.active_order_count(), 2u);
+
+    // The rest fills on the next cross and the side is done
+    cross.asks = {{99.0, 10.0}};
+    gw.check_fills(cross);
+    EXPECT_DOUBLE_EQ(risk.position(1).quantity, 5.0);
+    EXPECT_EQ(risk.open_orders_at(index).buy_lots, 0);
+    EXPECT_NEAR(risk.open_buy_notional(), 0.0, 1e-9);
+    EXPECT_EQ(gw.active_order_count(), 1u);
+}
+
+TEST_F(EndToEndTest, FillIsMatchedByOrderId) {
+    MarketDataAggregator md;
+    RiskManager risk(params_map);
+    QuoteEngine qe(params_map);
+    VenueRouter router(venues);
+    NullExecutionGateway gw;
+    MarketMakerController controller(md, risk, qe, router, gw, instruments);
+
+    VenueBookSnapshot snap;
+    snap.instrument = 1;
+    snap.venue = 1;
+    snap.bids = {{99.5, 10.0}};
+    snap.asks = {{100.5, 10.0}};
+    controller.on_market_data(snap);
+    const InstrumentIndex index = risk.registry().index(1);
+
+    // A buy for an order we no longer track (e.g. cancelled in flight)
+    // moves the position but leaves the resting bid open
+    controller.on_fill(Fill{.order_id = 99, .instrument = 1, .venue = 1, .price = 99.5,
+                            .qty = 1.0});
+    EXPECT_DOUBLE_EQ(risk.position(1).quantity, 1.0);
+    EXPECT_EQ(risk.open_orders_at(index).buy_lots, 500);
+    EXPECT_EQ(risk.open_orders_at(index).sell_lots, 500);
+
+    // The ask (second order sent) filling closes the ask, not the bid
+    controller.on_fill(Fill{.order_id = 2, .instrument = 1, .venue = 1, .price = 100.5,
+                            .qty = -5.0});
+    EXPECT_EQ(risk.open_orders_at(index).buy_lots, 500);
+    EXPECT_EQ(risk.open_orders_at(index).sell_lots, 0);
+}
+
 TEST_F(EndToEndTest, InventoryLimitsPreventQuoting) {
     MarketMakingParams tight_params;
     tight_params.max_position = 5.0;
@@ -154,6 +624,27 @@ TEST_F(EndToEndTest, BacktestRunnerSynthetic) {
     }
 }
 
+TEST_F(EndToEndTest, BacktestRunnerWithFactorSkew) {
+    BacktestConfig config;
+    config.venues = venues;
+    for (auto& [id, p] : params_map) {
+        config.params[id] = p;
+        config.params[id].factor_skew_weight = 1.0;
+        config.instruments.push_back(InstrumentConfig{
+            .id = id, .symbol = "SYM" + std::to_string(id),
+            .tick_size = 0.01, .lot_size = 1.0,
+            .base_spread_bp = 10.0, .inventory_limit = 100.0,
+            .factor_loadings = {1.0, id == 1 ? 0.0 : 0.5}});
+    }
+
+    for (bool pipelined : {false, true}) {
+        config.pipelined = pipelined;
+        BacktestRunner runner(config);
+        runner.run_synthetic(300, 3, 2);
+        EXPECT_GT(runner.metrics().compute_global_metrics().total_quotes, 0u);
+    }
+}
+
 TEST_F(EndToEndTest, BacktestGeneratesReport) {
     BacktestConfig config;
     config.venues = venues;
@@ -174,3 +665,257 @@ TEST_F(EndToEndTest, BacktestGeneratesReport) {
     EXPECT_NE(report.find("Global Metrics"), std::string::npos);
     EXPECT_NE(report.find("Per-Instrument Metrics"), std::string::npos);
 }
+
+TEST_F(EndToEndTest, PipelinedBacktestProcessesEveryTick) {
+    for (WaitStrategy wait : {WaitStrategy::Yield, WaitStrategy::Blocking}) {
+        for (bool conflate : {false, true}) {
+            BacktestConfig config;
+            config.venues = venues;
+            config.params = params_map;
+            config.pipelined = true;
+            config.pipeline.wait = wait;
+            config.pipeline.conflate = conflate;
+            config.pipeline.queue_capacity = 64;   // small enough to exercise backpressure
+
+            BacktestRunner runner(config);
+            runner.run_synthetic(500, 3, 2);
+
+            const auto& stats = runner.pipeline_stats();
+            EXPECT_EQ(stats.ticks_in, 3000u);
+            EXPECT_EQ(stats.ticks_handled, 3000u);
+            EXPECT_GT(stats.commands, 0u);
+            EXPECT_EQ(stats.tick_to_order.count, stats.commands);
+            EXPECT_LE(stats.tick_to_order.min_ns, stats.tick_to_order.p50_ns);
+            EXPECT_LE(stats.tick_to_order.p99_ns, stats.tick_to_order.max_ns);
+            EXPECT_EQ(runner.metrics().compute_global_metrics().total_quotes, 3000u);
+        }
+    }
+}
+
+TEST_F(EndToEndTest, PipelineForgetsFilledAndMassCancelledOrders) {
+    // Resting quotes are only refreshed once filled, so the walk sweeps them
+    auto params = params_map;
+    for (auto& [id, p] : params) p.quote_refresh_ms = 60'000.0;
+
+    MarketDataAggregator md;
+    RiskManager risk(params);
+    QuoteEngine qe(params);
+    VenueRouter router({venues[0]});
+
+    Pipeline* pipeline_ptr = nullptr;
+    SimExecutionGateway gw([&](const Fill& fill) { pipeline_ptr->post_fill(fill); });
+    gw.set_tick_sizes(params);
+    Pipeline pipeline(PipelineConfig{}, gw);
+    pipeline_ptr = &pipeline;
+
+    MarketMakerController controller(md, risk, qe, router, pipeline.gateway(), {1, 2});
+
+    std::vector<VenueBookSnapshot> snaps;
+    std::mt19937 rng(11);
+    std::normal_distribution<double> move(0.0, 0.003);
+    double px[2] = {100.0, 150.0};
+    for (int t = 0; t < 400; ++t) {
+        for (InstrumentId id = 1; id <= 2; ++id) {
+            px[id - 1] *= 1.0 + move(rng);
+            VenueBookSnapshot snap;
+            snap.instrument = id;
+            snap.venue = 1;
+            snap.bids = {{px[id - 1] - 0.05, 10.0}};
+            snap.asks = {{px[id - 1] + 0.05, 10.0}};
+            snaps.push_back(snap);
+        }
+    }
+
+    // Every order the map still tracks is resting in the simulator
+    size_t mismatches = 0;
+    pipeline.set_gateway_market_data_hook([&](const VenueBookSnapshot& snap) {
+        gw.check_fills(snap);
+        if (pipeline.tracked_orders() != gw.active_order_count()) ++mismatches;
+    });
+    auto replay = [&](size_t first, size_t last) {
+        pipeline.run(controller, [&](VenueBookSnapshot& out) {
+            if (first == last) return false;
+            out = snaps[first++];
+            return true;
+        });
+    };
+
+    replay(0, snaps.size());
+    EXPECT_GT(pipeline.stats().fills, 0u);
+    EXPECT_EQ(pipeline.tracked_orders(), gw.active_order_count());
+
+    // Last tick again per instrument: sides filled at the end are replaced
+    replay(snaps.size() - 2, snaps.size());
+    EXPECT_EQ(mismatches, 0u);
+    EXPECT_GT(gw.active_order_count(), 0u);
+    EXPECT_EQ(pipeline.tracked_orders(), gw.active_order_count());
+
+    // Mass cancels drop whatever is left, by instrument and then by venue
+    pipeline.set_after_market_data([&](const VenueBookSnapshot&) {
+        controller.cancel_instrument_quotes(1);
+        pipeline.gateway().cancel_venue(1);
+    });
+    replay(snaps.size() - 1, snaps.size());
+    EXPECT_EQ(gw.active_order_count(), 0u);
+    EXPECT_EQ(pipeline.tracked_orders(), 0u);
+}
+
+TEST_F(EndToEndTest, PipelineForwardsDoubleOnlyAmends) {
+    MarketDataAggregator md;
+    RiskManager risk(params_map);
+    QuoteEngine qe(params_map);
+    VenueRouter router(venues);
+
+    Pipeline* pipeline_ptr = nullptr;
+    SimExecutionGateway gw([&](const Fill& fill) { pipeline_ptr->post_fill(fill); });
+    gw.set_tick_sizes(params_map);
+    Pipeline pipeline(PipelineConfig{}, gw);
+    pipeline_ptr = &pipeline;
+
+    // Instrument 3 is not quoted by the controller; orders go straight
+    // through the strategy-side gateway
+    MarketMakerController controller(md, risk, qe, router, pipeline.gateway(), {1});
+
+    std::vector<VenueBookSnapshot> snaps(2);
+    for (auto& snap : snaps) {
+        snap.instrument = 3;
+        snap.venue = 1;
+        snap.bids = {{98.0, 10.0}};
+    }
+    snaps[0].asks = {{100.5, 10.0}};
+    snaps[1].asks = {{99.5, 10.0}};
+
+    bool sent = false;
+    bool amended = false;
+    bool unknown_amended = true;
+    pipeline.set_after_market_data([&](const VenueBookSnapshot&) {
+        if (sent) return;
+        sent = true;
+        IExecutionGateway& proxy = pipeline.gateway();
+        uint64_t id = proxy.send_limit_order(LiveOrder{.id = 0, .instrument = 3, .venue = 1,
+                                                       .side = OrderSide::Buy,
+                                                       .price = 90.0, .size = 2.0});
+        amended = proxy.amend_order(id, 100.0, 3.0);
+        unknown_amended = proxy.amend_order(id + 100, 100.0, 3.0);
+    });
+    pipeline.set_gateway_market_data_hook([&](const VenueBookSnapshot& snap) {
+        gw.check_fills(snap);
+    });
+    std::vector<Fill> fills;
+    pipeline.set_after_fill([&](const Fill& fill) { fills.push_back(fill); });
+
+    size_t next = 0;
+    pipeline.run(controller, [&](VenueBookSnapshot& out) {
+        if (next == snaps.size()) return false;
+        out = snaps[next++];
+        return true;
+    });
+
+    EXPECT_TRUE(amended);
+    EXPECT_FALSE(unknown_amended);
+    // Rests at the amended price and size, not at tick 0 with no lots
+    ASSERT_EQ(fills.size(), 1u);
+    EXPECT_DOUBLE_EQ(fills[0].price, 100.0);
+    EXPECT_DOUBLE_EQ(fills[0].qty, 3.0);
+    EXPECT_EQ(fills[0].order_id, 1u);
+    EXPECT_EQ(pipeline.tracked_orders(), 0u);
+}
+
+TEST_F(EndToEndTest, ShardedEngineMatchesSingleShard) {
+    // Per-instrument state is independent, so the partitioning must not
+    // change any instrument's outcome
+    std::unordered_map<InstrumentId, MarketMakingParams> params;
+    for (InstrumentId id = 1; id <= 12; ++id) params[id] = params_map[1];
+
+    std::vector<VenueBookSnapshot> snaps;
+    std::mt19937 rng(3);
+    std::normal_distribution<double> move(0.0, 0.002);
+    std::vector<double> px(12, 100.0);
+    for (int t = 0; t < 300; ++t) {
+        for (InstrumentId id = 1; id <= 12; ++id) {
+            px[id - 1] *= 1.0 + move(rng);
+            VenueBookSnapshot snap;
+            snap.instrument = id;
+            snap.venue = 1;
+            snap.bids = {{px[id - 1] - 0.05, 10.0}};
+            snap.asks = {{px[id - 1] + 0.05, 10.0}};
+            snaps.push_back(snap);
+        }
+    }
+
+    auto run = [&](size_t shards, WaitStrategy wait, bool shared_ledger = false) {
+        ShardedEngineConfig config;
+        config.num_shards = shards;
+        config.wait = wait;
+        config.queue_capacity = 32;
+        config.resync_every = 100;
+        config.shared_ledger = shared_ledger;
+        auto engine = std::make_unique<ShardedEngine>(
+            config, params, venues,
+            [&](size_t, FillCallback on_fill) {
+                auto gw = std::make_unique<SimExecutionGateway>(std::move(on_fill));
+                gw->set_tick_sizes(params);
+                return gw;
+            });
+        engine->set_after_market_data([](size_t, IExecutionGateway& gw,
+                                         const VenueBookSnapshot& snap) {
+            static_cast<SimExecutionGateway&>(gw).check_fills(snap);
+        });
+        engine->start();
+        Timestamp ts = 0;
+        for (const auto& snap : snaps) engine->dispatch(snap, ts += kNanosPerMilli);
+        engine->stop();
+        return engine;
+    };
+
+    auto single = run(1, WaitStrategy::Yield);
+    auto totals1 = single->totals();
+    EXPECT_EQ(totals1.ticks, snaps.size());
+    EXPECT_GT(totals1.fills, 0u);
+
+    for (WaitStrategy wait : {WaitStrategy::Yield, WaitStrategy::Blocking}) {
+        auto sharded = run(3, wait);
+        auto totals3 = sharded->totals();
+        EXPECT_EQ(totals3.ticks, snaps.size());
+        EXPECT_EQ(totals3.fills, totals1.fills);
+        EXPECT_NEAR(totals3.realized_pnl, totals1.realized_pnl, 1e-9);
+        EXPECT_NEAR(totals3.unrealized_pnl, totals1.unrealized_pnl, 1e-9);
+        EXPECT_NEAR(totals3.net_exposure, totals1.net_exposure, 1e-6);
+
+        for (InstrumentId id = 1; id <= 12; ++id) {
+            size_t s = sharded->shard_of(id);
+            EXPECT_DOUBLE_EQ(sharded->risk(s).position(id).quantity,
+                             single->risk(0).position(id).quantity);
+            for (size_t other = 0; other < sharded->num_shards(); ++other) {
+                if (other != s) {
+                    EXPECT_FALSE(sharded->market_data(other).has_view(id));
+                }
+            }
+        }
+
+        // Stopping resyncs each shard: its totals are the plain sum of positions
+        for (size_t s = 0; s < sharded->num_shards(); ++s) {
+            const auto& pf = sharded->risk(s).portfolio();
+            double net = 0.0, gross = 0.0;
+            for (const auto& pos : pf.positions) {
+                net   += pos.net_exposure;
+                gross += pos.gross_notional;
+            }
+            EXPECT_EQ(pf.total_net_exposure, net);
+            EXPECT_EQ(pf.total_gross_notional, gross);
+        }
+    }
+
+    // A shared ledger without limits changes nothing, and ends up holding
+    // every shard's positions
+    auto ledgered = run(3, WaitStrategy::Yield, true);
+    ASSERT_NE(ledgered->ledger(), nullptr);
+    EXPECT_EQ(ledgered->totals().fills, totals1.fills);
+    const SharedRiskLedger& ledger = *ledgered->ledger();
+    for (InstrumentId id = 1; id <= 12; ++id) {
+        const InstrumentIndex i = ledger.registry().index(id);
+        const PriceScale scale = params[id].scale();
+        EXPECT_EQ(ledger.position_lots(i),
+                  scale.to_lots(single->risk(0).position(id).quantity));
+    }
+}
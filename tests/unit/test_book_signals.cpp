@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include "market/book_signals.hpp"
+#include "market/market_data_aggregator.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace mme;
+
+TEST(BookSignalsTest, DispatchedKernelMatchesScalar) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> qty(0.0, 50.0);
+    const size_t n = 37; // not a multiple of the vector width
+    std::vector<double> bp(n), bq(n), ap(n), aq(n);
+    for (size_t i = 0; i < n; ++i) {
+        bp[i] = 100.0 - (i % 10) * 0.01;
+        ap[i] = 100.01 + (i % 10) * 0.01;
+        bq[i] = qty(rng);
+        aq[i] = qty(rng);
+    }
+
+    auto ref = compute_book_sums_scalar(bp.data(), bq.data(), ap.data(), aq.data(), n, 100.0, 100.01);
+    auto got = compute_book_sums(bp.data(), bq.data(), ap.data(), aq.data(), n, 100.0, 100.01);
+
+    EXPECT_NEAR(got.bid_qty, ref.bid_qty, 1e-9);
+    EXPECT_NEAR(got.ask_notional, ref.ask_notional, 1e-7);
+    EXPECT_NEAR(got.bid_touch_qty, ref.bid_touch_qty, 1e-9);
+    EXPECT_NEAR(got.ask_touch_qty, ref.ask_touch_qty, 1e-9);
+    EXPECT_GT(ref.bid_touch_qty, 0.0);
+}
+
+TEST(BookSignalsTest, AggregatorPublishesMicropriceAndImbalance) {
+    MarketDataAggregator agg;
+
+    VenueBookSnapshot v1;
+    v1.instrument = 1;
+    v1.venue = 1;
+    v1.bids = {{99.0, 30.0}, {98.0, 10.0}};
+    v1.asks = {{101.0, 10.0}};
+
+    VenueBookSnapshot v2;
+    v2.instrument = 1;
+    v2.venue = 2;
+    v2.bids = {{99.0, 10.0}};
+    v2.asks = {{101.0, 10.0}, {102.0, 20.0}};
+
+    agg.on_book_update(v1);
+    agg.on_book_update(v2);
+    const auto* view = agg.find_view(1);
+    ASSERT_NE(view, nullptr);
+
+    // Touch: 40 bid @ 99, 20 ask @ 101 -> microprice leans towards the ask
+    EXPECT_DOUBLE_EQ(view->microprice, (99.0 * 20.0 + 101.0 * 40.0) / 60.0);
+
+    // Depth: bid 50, ask 40
+    EXPECT_DOUBLE_EQ(view->imbalance, (50.0 - 40.0) / 90.0);
+
+    double vwap_bid = (99.0 * 40.0 + 98.0 * 10.0) / 50.0;
+    double vwap_ask = (101.0 * 20.0 + 102.0 * 20.0) / 40.0;
+    EXPECT_DOUBLE_EQ(view->weighted_mid, (vwap_bid + vwap_ask) / 2.0);
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include "strategy/quote_engine.hpp"
+#include "util/clock.hpp"
+
+#include <thread>
+
+using namespace mme;
+
+TEST(ClockTest, SimulatedClockSetAndAdvance) {
+    SimulatedClock clock(5);
+    EXPECT_EQ(clock.now(), 5u);
+    clock.advance(kNanosPerMilli);
+    EXPECT_EQ(clock.now(), 5u + kNanosPerMilli);
+    clock.set(42);
+    EXPECT_EQ(clock.now(), 42u);
+    EXPECT_EQ(ms_to_ns(1.5), 1'500'000u);
+    EXPECT_EQ(ms_to_ns(-1.0), 0u);
+}
+
+TEST(ClockTest, TscClockIsMonotonicAndTracksSteady) {
+    TscClock tsc(5);
+    SteadyClock steady;
+
+    Timestamp prev = tsc.now();
+    for (int i = 0; i < 10000; ++i) {
+        Timestamp t = tsc.now();
+        ASSERT_GE(t, prev);
+        prev = t;
+    }
+
+    // Same epoch as steady_clock; allow generous slack for a loaded box
+    Timestamp s0 = steady.now();
+    Timestamp t0 = tsc.now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    Timestamp s1 = steady.now();
+    Timestamp t1 = tsc.now();
+
+    auto diff = [](Timestamp a, Timestamp b) { return a > b ? a - b : b - a; };
+    EXPECT_LT(diff(t0, s0), ms_to_ns(5));
+    double elapsed_ratio = static_cast<double>(t1 - t0) / static_cast<double>(s1 - s0);
+    EXPECT_NEAR(elapsed_ratio, 1.0, 0.05);
+}
+
+TEST(ClockTest, QuoteStampedFromInjectedClock) {
+    std::unordered_map<InstrumentId, MarketMakingParams> pm;
+    pm[1] = MarketMakingParams{};
+    SimulatedClock clock(ms_to_ns(250));
+    QuoteEngine qe(pm, &clock);
+
+    InstrumentMarketView view;
+    view.id = 1;
+    view.mid_price = 100.0;
+    InstrumentPosition pos;
+    pos.id = 1;
+
+    EXPECT_EQ(qe.compute_quote(view, pos, 1).ts, ms_to_ns(250));
+    clock.advance(7);
+    EXPECT_EQ(qe.compute_quote(view, pos, 1).ts, ms_to_ns(250) + 7);
+}
@@ -3,11 +3,26 @@
 
 using namespace mme;
 
+namespace {
+
+constexpr double kTick = 0.01;
+
+LiveOrder limit(InstrumentId instrument, VenueId venue, OrderSide side,
+                double price, double size, double tick = kTick) {
+    const PriceScale s{.tick_size = tick};
+    return LiveOrder{.id = 0, .instrument = instrument, .venue = venue, .side = side,
+                     .price = price, .size = size, .price_ticks = s.to_ticks(price),
+                     .size_lots = s.to_lots(size)};
+}
+
+} // anonymous namespace
+
 TEST(SimExecutionGatewayTest, SendAndCancel) {
     bool filled = false;
-    SimExecutionGateway gw([&](InstrumentId, VenueId, double, double) {
+    SimExecutionGateway gw([&](const Fill&) {
         filled = true;
     });
+    gw.set_tick_size(1, kTick);
 
     LiveOrder order{.id = 0, .instrument = 1, .venue = 1,
                     .side = OrderSide::Buy, .price = 99.0, .size = 10.0};
@@ -26,11 +41,12 @@ TEST(SimExecutionGatewayTest, BuyFillWhenAskCrosses) {
     double fill_price = 0.0;
     double fill_qty = 0.0;
 
-    SimExecutionGateway gw([&](InstrumentId id, VenueId, double price, double qty) {
-        fill_inst = id;
-        fill_price = price;
-        fill_qty = qty;
+    SimExecutionGateway gw([&](const Fill& fill) {
+        fill_inst = fill.instrument;
+        fill_price = fill.price;
+        fill_qty = fill.qty;
     });
+    gw.set_tick_size(1, kTick);
 
     LiveOrder buy{.id = 0, .instrument = 1, .venue = 1,
                   .side = OrderSide::Buy, .price = 100.0, .size = 5.0};
@@ -53,9 +69,10 @@ TEST(SimExecutionGatewayTest, BuyFillWhenAskCrosses) {
 TEST(SimExecutionGatewayTest, SellFillWhenBidCrosses) {
     double fill_qty = 0.0;
 
-    SimExecutionGateway gw([&](InstrumentId, VenueId, double, double qty) {
-        fill_qty = qty;
+    SimExecutionGateway gw([&](const Fill& fill) {
+        fill_qty = fill.qty;
     });
+    gw.set_tick_size(1, kTick);
 
     LiveOrder sell{.id = 0, .instrument = 1, .venue = 1,
                    .side = OrderSide::Sell, .price = 100.0, .size = 5.0};
@@ -75,9 +92,10 @@ TEST(SimExecutionGatewayTest, SellFillWhenBidCrosses) {
 TEST(SimExecutionGatewayTest, NoFillWhenNoCross) {
     bool filled = false;
 
-    SimExecutionGateway gw([&](InstrumentId, VenueId, double, double) {
+    SimExecutionGateway gw([&](const Fill&) {
         filled = true;
     });
+    gw.set_tick_size(1, kTick);
 
     LiveOrder buy{.id = 0, .instrument = 1, .venue = 1,
                   .side = OrderSide::Buy, .price = 99.0, .size = 5.0};
@@ -95,6 +113,149 @@ TEST(SimExecutionGatewayTest, NoFillWhenNoCross) {
     EXPECT_EQ(gw.active_order_count(), 1);
 }
 
+TEST(SimExecutionGatewayTest, ComparesPricesInTicks) {
+    int fills = 0;
+    SimExecutionGateway gw([&](const Fill&) { ++fills; });
+    gw.set_tick_size(1, 0.1);
+
+    // 0.1 + 0.2 != 0.3 in floating point, but both are tick 3
+    LiveOrder buy{.id = 0, .instrument = 1, .venue = 1,
+                  .side = OrderSide::Buy, .price = 0.3, .size = 1.0};
+    gw.send_limit_order(buy);
+
+    VenueBookSnapshot snap;
+    snap.instrument = 1;
+    snap.venue = 1;
+    snap.bids = {{0.1, 10.0}};
+    snap.asks = {{0.1 + 0.2, 10.0}};
+    gw.check_fills(snap);
+
+    EXPECT_EQ(fills, 1);
+}
+
+TEST(SimExecutionGatewayTest, RestsAtOrderTicksAndRequiresTickSize) {
+    int fills = 0;
+    SimExecutionGateway gw([&](const Fill&) { ++fills; });
+    gw.set_tick_size(1, kTick);
+
+    // The grid price the order was quoted at wins over its wire double
+    LiveOrder buy = limit(1, 1, OrderSide::Buy, 100.0, 1.0);
+    buy.price_ticks -= 1;
+    gw.send_limit_order(buy);
+
+    VenueBookSnapshot snap;
+    snap.instrument = 1;
+    snap.venue = 1;
+    snap.bids = {{99.0, 10.0}};
+    snap.asks = {{100.0, 10.0}};
+    gw.check_fills(snap);
+    EXPECT_EQ(fills, 0);
+
+    // No silent default grid for an instrument nobody configured
+    gw.send_limit_order(limit(2, 1, OrderSide::Buy, 100.0, 1.0));
+    snap.instrument = 2;
+    EXPECT_THROW(gw.check_fills(snap), std::invalid_argument);
+}
+
+TEST(SimExecutionGatewayTest, DerivesGridFromPriceAndSize) {
+    std::vector<Fill> fills;
+    SimExecutionGateway gw([&](const Fill& fill) { fills.push_back(fill); });
+    gw.set_tick_size(1, kTick);
+
+    // Doubles only, as the IExecutionGateway contract allows
+    gw.send_limit_order(LiveOrder{.id = 0, .instrument = 1, .venue = 1,
+                                  .side = OrderSide::Sell, .price = 200.0, .size = 5.0});
+
+    VenueBookSnapshot snap;
+    snap.instrument = 1;
+    snap.venue = 1;
+    snap.bids = {{99.0, 10.0}};
+    snap.asks = {{101.0, 10.0}};
+    gw.check_fills(snap);
+    EXPECT_TRUE(fills.empty());
+
+    snap.bids = {{200.0, 10.0}};
+    snap.asks = {{201.0, 10.0}};
+    gw.check_fills(snap);
+    ASSERT_EQ(fills.size(), 1u);
+    EXPECT_DOUBLE_EQ(fills[0].qty, -5.0);
+}
+
+TEST(SimExecutionGatewayTest, AmendOrderResizesLots) {
+    std::vector<Fill> fills;
+    SimExecutionGateway gw([&](const Fill& fill) { fills.push_back(fill); });
+    gw.set_tick_size(1, kTick);
+    gw.set_partial_fills(true);
+
+    uint64_t id = gw.send_limit_order(limit(1, 1, OrderSide::Buy, 99.0, 5.0));
+    EXPECT_TRUE(gw.amend_order(id, 100.0, 3.0));
+
+    VenueBookSnapshot snap;
+    snap.instrument = 1;
+    snap.venue = 1;
+    snap.bids = {{98.0, 10.0}};
+    snap.asks = {{100.0, 2.0}};
+    gw.check_fills(snap);
+    ASSERT_EQ(fills.size(), 1u);
+    EXPECT_DOUBLE_EQ(fills[0].qty, 2.0);
+    EXPECT_DOUBLE_EQ(fills[0].leaves, 1.0);
+}
+
+TEST(SimExecutionGatewayTest, PartialFillsCapAtTouchSize) {
+    std::vector<Fill> fills;
+    SimExecutionGateway gw([&](const Fill& fill) { fills.push_back(fill); });
+    gw.set_tick_size(1, kTick);
+    gw.set_partial_fills(true);
+
+    LiveOrder sell = limit(1, 1, OrderSide::Sell, 100.0, 5.0);
+    uint64_t id = gw.send_limit_order(sell);
+
+    VenueBookSnapshot snap;
+    snap.instrument = 1;
+    snap.venue = 1;
+    snap.bids = {{100.5, 2.0}};
+    snap.asks = {{101.0, 10.0}};
+    gw.check_fills(snap);
+    ASSERT_EQ(fills.size(), 1u);
+    EXPECT_EQ(fills[0].order_id, id);
+    EXPECT_DOUBLE_EQ(fills[0].qty, -2.0);
+    EXPECT_DOUBLE_EQ(fills[0].leaves, 3.0);
+    EXPECT_EQ(gw.active_order_count(), 1u);
+
+    snap.bids = {{100.5, 10.0}};
+    gw.check_fills(snap);
+    ASSERT_EQ(fills.size(), 2u);
+    EXPECT_DOUBLE_EQ(fills[1].qty, -3.0);
+    EXPECT_DOUBLE_EQ(fills[1].leaves, 0.0);
+    EXPECT_EQ(gw.active_order_count(), 0u);
+}
+
+TEST(SimExecutionGatewayTest, AmendKeepsIdAndRepricesOrder) {
+    double fill_price = 0.0;
+    SimExecutionGateway gw([&](const Fill& fill) {
+        fill_price = fill.price;
+    });
+    gw.set_tick_size(1, kTick);
+
+    LiveOrder buy{.id = 0, .instrument = 1, .venue = 1,
+                  .side = OrderSide::Buy, .price = 99.0, .size = 5.0};
+    uint64_t id = gw.send_limit_order(buy);
+
+    EXPECT_TRUE(gw.amend_order(id, 100.0, 3.0));
+    EXPECT_EQ(gw.active_order_count(), 1u);
+    EXPECT_FALSE(gw.amend_order(id + 100, 100.0, 3.0));
+
+    // Ask at 99.5 now crosses the amended price
+    VenueBookSnapshot snap;
+    snap.instrument = 1;
+    snap.venue = 1;
+    snap.bids = {{98.0, 10.0}};
+    snap.asks = {{99.5, 10.0}};
+    gw.check_fills(snap);
+    EXPECT_DOUBLE_EQ(fill_price, 100.0);
+    EXPECT_FALSE(gw.amend_order(id, 101.0, 3.0)); // filled, no longer live
+}
+
 TEST(NullExecutionGatewayTest, CountsOrders) {
     NullExecutionGateway gw;
 
@@ -104,8 +265,75 @@ TEST(NullExecutionGatewayTest, CountsOrders) {
     uint64_t id1 = gw.send_limit_order(order);
     uint64_t id2 = gw.send_limit_order(order);
     gw.cancel_order(id1);
+    EXPECT_TRUE(gw.amend_order(id2, 101.0, 5.0));
 
     EXPECT_EQ(gw.orders_sent(), 2u);
     EXPECT_EQ(gw.cancels_sent(), 1u);
+    EXPECT_EQ(gw.amends_sent(), 1u);
     EXPECT_NE(id1, id2);
 }
+
+TEST(SimExecutionGatewayTest, SendBatchAssignsIds) {
+    SimExecutionGateway gw([](const Fill&) {});
+    gw.set_tick_size(1, kTick);
+
+    LiveOrder resting{.id = 0, .instrument = 1, .venue = 1,
+                      .side = OrderSide::Buy, .price = 99.0, .size = 5.0};
+    uint64_t old_id = gw.send_limit_order(resting);
+
+    std::vector<OrderAction> batch = {
+        {.type = OrderActionType::New, .order = resting},
+        {.type = OrderActionType::Amend,
+         .order = {.id = old_id, .instrument = 1, .venue = 1,
+                   .side = OrderSide::Buy, .price = 98.0, .size = 5.0}},
+        {.type = OrderActionType::Amend, .order = {.id = old_id + 100}},
+    };
+    gw.send_batch(batch);
+
+    EXPECT_TRUE(batch[0].ok);
+    EXPECT_NE(batch[0].order.id, 0u);
+    EXPECT_NE(batch[0].order.id, old_id);
+    EXPECT_TRUE(batch[1].ok);
+    EXPECT_FALSE(batch[2].ok);
+    EXPECT_EQ(gw.active_order_count(), 2u);
+
+    std::vector<uint64_t> ids = {old_id, batch[0].order.id};
+    gw.cancel_batch(ids);
+    EXPECT_EQ(gw.active_order_count(), 0u);
+}
+
+TEST(SimExecutionGatewayTest, MassCancelByInstrumentAndVenue) {
+    int fills = 0;
+    SimExecutionGateway gw([&](const Fill&) { ++fills; });
+    for (InstrumentId inst = 1; inst <= 3; ++inst) gw.set_tick_size(inst, kTick);
+
+    for (InstrumentId inst = 1; inst <= 3; ++inst) {
+        for (VenueId venue = 1; venue <= 2; ++venue) {
+            gw.send_limit_order(LiveOrder{.id = 0, .instrument = inst, .venue = venue,
+                                          .side = OrderSide::Buy, .price = 99.0, .size = 1.0});
+        }
+    }
+    EXPECT_EQ(gw.active_order_count(), 6u);
+
+    EXPECT_EQ(gw.cancel_instrument(2), 2u);
+    EXPECT_EQ(gw.active_order_count(), 4u);
+    EXPECT_EQ(gw.cancel_instrument(2), 0u);
+
+    EXPECT_EQ(gw.cancel_venue(1), 2u);
+    EXPECT_EQ(gw.active_order_count(), 2u);
+
+    // Cancelled orders no longer fill
+    VenueBookSnapshot snap;
+    snap.instrument = 1;
+    snap.venue = 1;
+    snap.bids = {{98.0, 10.0}};
+    snap.asks = {{98.5, 10.0}};
+    gw.check_fills(snap);
+    EXPECT_EQ(fills, 0);
+    snap.venue = 2;
+    gw.check_fills(snap);
+    EXPECT_EQ(fills, 1);
+
+    EXPECT_EQ(gw.cancel_all(), 1u);
+    EXPECT_EQ(gw.active_order_count(), 0u);
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include "risk/factor_exposure.hpp"
+#include "risk/risk_manager.hpp"
+#include "strategy/quote_engine.hpp"
+
+#include <random>
+
+using namespace mme;
+
+namespace {
+
+constexpr InstrumentId kAapl = 1;
+constexpr InstrumentId kMsft = 2;
+constexpr InstrumentId kXom  = 3;
+
+InstrumentRegistry make_registry(size_t n) {
+    InstrumentRegistry reg;
+    for (size_t i = 0; i < n; ++i) reg.add_instrument(static_cast<InstrumentId>(i + 1));
+    return reg;
+}
+
+InstrumentMarketView view_at(InstrumentId id, double mid) {
+    InstrumentMarketView view;
+    view.id = id;
+    view.mid_price = mid;
+    return view;
+}
+
+} // anonymous namespace
+
+TEST(FactorExposureTest, IncrementalMatchesResync) {
+    constexpr size_t n = 40, k = 3;
+    FactorExposure fx(make_registry(n), k);
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+
+    for (InstrumentIndex i = 0; i < n; ++i) {
+        if (i % 7 == 0) continue;   // some instruments have no loadings
+        fx.set_loadings_at(i, {u(rng), u(rng), u(rng)});
+    }
+    for (int step = 0; step < 500; ++step) {
+        InstrumentIndex i = static_cast<InstrumentIndex>(step % n);
+        fx.set_exposure_at(i, u(rng) * 1e5);
+        // Betas re-estimated mid-run
+        if (step % 53 == 0 && i % 7 != 0) fx.set_loadings_at(i, {u(rng), u(rng)});
+    }
+
+    std::vector<double> incremental(k);
+    for (size_t f = 0; f < k; ++f) incremental[f] = fx.factor(f);
+    fx.resync();
+    for (size_t f = 0; f < k; ++f) EXPECT_NEAR(incremental[f], fx.factor(f), 1e-6);
+
+    for (InstrumentIndex i = 0; i < n; ++i) {
+        if (!fx.has_loadings_at(i)) {
+            EXPECT_EQ(fx.hedged_exposure_at(i), fx.exposure_at(i));
+            continue;
+        }
+        double dot = 0.0, norm = 0.0;
+        for (size_t f = 0; f < k; ++f) {
+            dot  += fx.loading(i, f) * fx.factor(f);
+            norm += fx.loading(i, f) * fx.loading(i, f);
+        }
+        EXPECT_NEAR(fx.hedged_exposure_at(i), dot / norm, 1e-6);
+    }
+}
+
+TEST(FactorExposureTest, RiskManagerNetsOffsettingPositions) {
+    MarketMakingParams p;
+    p.max_position = 1000.0;
+    std::unordered_map<InstrumentId, MarketMakingParams> params{{kAapl, p}, {kMsft, p}, {kXom, p}};
+    RiskManager risk(make_registry(3), params);
+
+    // One market factor plus a tech factor XOM has no loading on
+    FactorExposure& fx = risk.enable_factor_exposure(2);
+    fx.set_loadings(kAapl, {1.0, 1.0});
+    fx.set_loadings(kMsft, {1.0, 1.0});
+    fx.set_loadings(kXom, {1.0, 0.0});
+
+    risk.on_fill(kAapl, 100.0, 50.0);    // +5000
+    risk.on_fill(kMsft, 200.0, -25.0);   // -5000
+    const InstrumentIndex aapl = risk.registry().index(kAapl);
+    const InstrumentIndex xom  = risk.registry().index(kXom);
+    EXPECT_NEAR(fx.factor(0), 0.0, 1e-9);
+    EXPECT_NEAR(fx.hedged_exposure_at(aapl), 0.0, 1e-9);
+
+    // Marks move the exposure too
+    risk.on_mark(kAapl, 110.0);
+    EXPECT_NEAR(fx.factor(0), 500.0, 1e-9);
+    EXPECT_NEAR(fx.hedged_exposure_at(aapl), 500.0, 1e-9);
+    // XOM sees only the market leg of the book
+    EXPECT_NEAR(fx.hedged_exposure_at(xom), 500.0, 1e-9);
+}
+
+TEST(FactorExposureTest, QuoteEngineSkewsOnFactorExposure) {
+    MarketMakingParams p;
+    p.base_spread_bp  = 20.0;
+    p.inventory_coeff = 1.0;
+    p.max_position    = 100.0;
+    p.size_base       = 5.0;
+    p.factor_skew_weight = 1.0;
+    std::unordered_map<InstrumentId, MarketMakingParams> params{{kAapl, p}, {kMsft, p}};
+    auto store = std::make_shared<ParamStore>(make_registry(2), params);
+    RiskManager risk(store);
+    QuoteEngine qe(store);
+
+    const auto aapl = view_at(kAapl, 100.0);
+    risk.on_fill(kAapl, 100.0, 50.0);
+    risk.on_fill(kMsft, 100.0, -50.0);
+    const Quote own = qe.compute_quote(aapl, risk.position(kAapl), 1);
+
+    FactorExposure& fx = risk.enable_factor_exposure(1);
+    fx.set_loadings(kAapl, {1.0});
+    fx.set_loadings(kMsft, {1.0});
+    qe.set_factor_exposure(risk.factor_exposure());
+
+    // The MSFT short hedges the AAPL long: no skew, size still shrinks
+    const Quote hedged = qe.compute_quote(aapl, risk.position(kAapl), 1);
+    EXPECT_LT(own.ask_ticks, hedged.ask_ticks);
+    EXPECT_EQ(hedged.bid_ticks + hedged.ask_ticks, 2 * 10000);
+    EXPECT_EQ(hedged.bid_lots, own.bid_lots);
+    EXPECT_EQ(hedged.ask_lots, own.ask_lots);
+
+    // Long both: the skew is as large as the combined position
+    risk.on_fill(kMsft, 100.0, 100.0);
+    const Quote doubled = qe.compute_quote(aapl, risk.position(kAapl), 1);
+    EXPECT_EQ(doubled.bid_ticks + doubled.ask_ticks,
+              2 * (own.bid_ticks + own.ask_ticks) - 2 * 10000);
+
+    // Weight 0 ignores the factor model
+    p.factor_skew_weight = 0.0;
+    ASSERT_TRUE(store->publish({{kAapl, p}}));
+    const Quote off = qe.compute_quote(aapl, risk.position(kAapl), 1);
+    EXPECT_EQ(off.bid_ticks, own.bid_ticks);
+    EXPECT_EQ(off.ask_ticks, own.ask_ticks);
+}
+
+TEST(FactorExposureTest, QuoteCacheHitsUnderFactorSkew) {
+    MarketMakingParams p;
+    p.base_spread_bp  = 20.0;
+    p.inventory_coeff = 1.0;
+    p.max_position    = 100.0;
+    p.size_base       = 5.0;
+    p.factor_skew_weight     = 0.5;
+    p.quote_cache_vol_bucket = 0.001;
+    std::unordered_map<InstrumentId, MarketMakingParams> params{{kAapl, p}, {kMsft, p}};
+    auto store = std::make_shared<ParamStore>(make_registry(2), params);
+    RiskManager risk(store);
+    QuoteEngine qe(store);
+
+    FactorExposure& fx = risk.enable_factor_exposure(1);
+    fx.set_loadings(kAapl, {1.0});
+    fx.set_loadings(kMsft, {1.0});
+    qe.set_factor_exposure(risk.factor_exposure());
+    risk.on_fill(kAapl, 100.0, 20.0);
+    risk.on_fill(kMsft, 100.3, 10.0);   // skew inventory 25.015, mid-lot
+
+    // MSFT marks jitter the hedged exposure by far less than a lot
+    const auto aapl = view_at(kAapl, 100.0);
+    const Quote first = qe.compute_quote(aapl, risk.position(kAapl), 1);
+    for (int i = 1; i <= 10; ++i) {
+        risk.on_mark(kMsft, 100.3 + (i % 2 ? 1e-4 : -1e-4));
+        const Quote q = qe.compute_quote(aapl, risk.position(kAapl), 1);
+        EXPECT_EQ(q.bid_ticks, first.bid_ticks);
+        EXPECT_EQ(q.ask_ticks, first.ask_ticks);
+    }
+    EXPECT_EQ(qe.cache_stats().hits, 10u);
+    EXPECT_EQ(qe.cache_stats().misses, 1u);
+
+    // A move worth many lots of skew is requoted
+    risk.on_mark(kMsft, 200.0);
+    const Quote moved = qe.compute_quote(aapl, risk.position(kAapl), 1);
+    EXPECT_EQ(qe.cache_stats().misses, 2u);
+    EXPECT_LT(moved.ask_ticks, first.ask_ticks);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "config/instrument_registry.hpp"
+#include "market/market_data_aggregator.hpp"
+#include "risk/risk_manager.hpp"
+#include "strategy/quote_engine.hpp"
+
+using namespace mme;
+
+TEST(InstrumentRegistryTest, AssignsDenseIndicesInOrder) {
+    std::vector<InstrumentConfig> instruments = {
+        {.id = 42, .symbol = "BTC-USD", .tick_size = 0.5, .lot_size = 0.001,
+         .base_spread_bp = 5.0, .inventory_limit = 10.0},
+        {.id = 7, .symbol = "ETH-USD", .tick_size = 0.05, .lot_size = 0.01,
+         .base_spread_bp = 8.0, .inventory_limit = 100.0},
+    };
+    std::vector<VenueConfig> venues = {
+        {.id = 9, .name = "A", .maker_fee_bp = 1.0, .taker_fee_bp = 2.0, .latency_ms = 0.5,
+         .cancel_penalty_bp = 0.1},
+        {.id = 3, .name = "B", .maker_fee_bp = 1.5, .taker_fee_bp = 2.5, .latency_ms = 1.0,
+         .cancel_penalty_bp = 0.2},
+    };
+    InstrumentRegistry reg(instruments, venues);
+
+    EXPECT_EQ(reg.size(), 2u);
+    EXPECT_EQ(reg.index(42), 0u);
+    EXPECT_EQ(reg.index(7), 1u);
+    EXPECT_EQ(reg.index(1), kNoInstrument);
+    EXPECT_EQ(reg.index("ETH-USD"), 1u);
+    EXPECT_EQ(reg.index("XRP-USD"), kNoInstrument);
+    EXPECT_EQ(reg.id(0), 42u);
+    EXPECT_EQ(reg.symbol(1), "ETH-USD");
+
+    EXPECT_EQ(reg.num_venues(), 2u);
+    EXPECT_EQ(reg.venue_index(9), 0u);
+    EXPECT_EQ(reg.venue_index(3), 1u);
+    EXPECT_EQ(reg.venue_index(4), kNoVenue);
+    EXPECT_EQ(reg.venue_id(1), 3);
+
+    // Re-adding is a no-op
+    EXPECT_EQ(reg.add_instrument(7), 1u);
+    EXPECT_EQ(reg.add_instrument(8), 2u);
+    EXPECT_EQ(reg.size(), 3u);
+}
+
+TEST(InstrumentRegistryTest, ComponentsBuiltFromSameParamsAgree) {
+    std::unordered_map<InstrumentId, MarketMakingParams> params;
+    for (InstrumentId id : {30u, 10u, 20u}) params[id] = MarketMakingParams{};
+    params[20].max_position = 5.0;
+
+    QuoteEngine qe(params);
+    RiskManager risk(params);
+    MarketDataAggregator md;
+    EXPECT_TRUE(md.add_instruments(qe.registry()));
+
+    // from_keys orders by id
+    InstrumentIndex i20 = qe.registry().index(20);
+    EXPECT_EQ(i20, 1u);
+    EXPECT_EQ(risk.registry().index(20), i20);
+    EXPECT_EQ(md.index(20), i20);
+    EXPECT_DOUBLE_EQ(qe.params_at(i20)->max_position, 5.0);
+
+    risk.on_fill_at(i20, 100.0, 3.0);
+    EXPECT_DOUBLE_EQ(risk.position(20).quantity, 3.0);
+    EXPECT_TRUE(risk.within_limits_at(i20, 2.0));
+    EXPECT_FALSE(risk.within_limits_at(i20, 3.0));
+
+    // Registered but without data yet
+    EXPECT_EQ(md.find_view_at(i20), nullptr);
+    VenueBookSnapshot snap;
+    snap.instrument = 20;
+    snap.venue = 1;
+    snap.bids = {{99.0, 1.0}};
+    snap.asks = {{101.0, 1.0}};
+    md.on_book_update_at(i20, snap);
+    ASSERT_NE(md.find_view(20), nullptr);
+    EXPECT_DOUBLE_EQ(md.find_view_at(i20)->mid_price, 100.0);
+
+    // Fills outside the registry are still tracked
+    risk.on_fill(99, 10.0, -1.0);
+    EXPECT_DOUBLE_EQ(risk.position(99).quantity, -1.0);
+    EXPECT_FALSE(risk.within_limits(99, 0.0));
+}
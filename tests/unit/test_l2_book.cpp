@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include "market/l2_book.hpp"
+#include "market/market_data_aggregator.hpp"
+
+using namespace mme;
+
+namespace {
+
+LevelUpdate level(LevelSide side, LevelAction action, double price, double qty = 0.0) {
+    return LevelUpdate{.instrument = 1, .venue = 1, .side = side,
+                       .action = action, .price = price, .quantity = qty};
+}
+
+} // anonymous namespace
+
+TEST(L2BookTest, EmptyBook) {
+    L2Book book(0.01);
+    EXPECT_DOUBLE_EQ(book.best_bid(), 0.0);
+    EXPECT_EQ(book.best_ask(), std::numeric_limits<double>::max());
+    EXPECT_EQ(book.bid_levels(), 0u);
+}
+
+TEST(L2BookTest, AddModifyDelete) {
+    L2Book book(0.01);
+    book.apply(level(LevelSide::Bid, LevelAction::Add, 99.98, 10.0));
+    book.apply(level(LevelSide::Bid, LevelAction::Add, 99.99, 5.0));
+    book.apply(level(LevelSide::Ask, LevelAction::Add, 100.01, 7.0));
+
+    EXPECT_NEAR(book.best_bid(), 99.99, 1e-9);
+    EXPECT_NEAR(book.best_ask(), 100.01, 1e-9);
+    EXPECT_EQ(book.bid_levels(), 2u);
+
+    book.apply(level(LevelSide::Bid, LevelAction::Modify, 99.99, 8.0));
+    EXPECT_DOUBLE_EQ(book.depth(LevelSide::Bid, 1), 8.0);
+    EXPECT_DOUBLE_EQ(book.depth(LevelSide::Bid, 5), 18.0);
+
+    // Deleting the touch falls back to the next level
+    book.apply(level(LevelSide::Bid, LevelAction::Delete, 99.99));
+    EXPECT_NEAR(book.best_bid(), 99.98, 1e-9);
+    EXPECT_EQ(book.bid_levels(), 1u);
+}
+
+TEST(L2BookTest, SnapshotOrdersBestFirst) {
+    L2Book book(0.5);
+    book.apply(level(LevelSide::Ask, LevelAction::Add, 102.0, 3.0));
+    book.apply(level(LevelSide::Ask, LevelAction::Add, 101.0, 1.0));
+    book.apply(level(LevelSide::Ask, LevelAction::Add, 101.5, 2.0));
+    book.apply(level(LevelSide::Bid, LevelAction::Add, 99.0, 4.0));
+    book.apply(level(LevelSide::Bid, LevelAction::Add, 100.0, 5.0));
+
+    VenueBookSnapshot snap;
+    book.to_snapshot(snap);
+    ASSERT_EQ(snap.asks.size(), 3u);
+    EXPECT_DOUBLE_EQ(snap.asks[0].price, 101.0);
+    EXPECT_DOUBLE_EQ(snap.asks[1].price, 101.5);
+    EXPECT_DOUBLE_EQ(snap.asks[2].price, 102.0);
+    ASSERT_EQ(snap.bids.size(), 2u);
+    EXPECT_DOUBLE_EQ(snap.bids[0].price, 100.0);
+    EXPECT_DOUBLE_EQ(snap.bids[1].quantity, 4.0);
+}
+
+TEST(L2BookTest, TouchOutsideWindowRecenters) {
+    L2Book book(1.0, 16);
+    book.apply(level(LevelSide::Bid, LevelAction::Add, 100.0, 1.0));
+    book.apply(level(LevelSide::Bid, LevelAction::Add, 95.0, 1.0));
+
+    // Far deeper than the window: parked, touch unaffected
+    book.apply(level(LevelSide::Bid, LevelAction::Add, 50.0, 3.0));
+    EXPECT_DOUBLE_EQ(book.best_bid(), 100.0);
+    EXPECT_EQ(book.bid_levels(), 3u);
+    EXPECT_DOUBLE_EQ(book.depth(LevelSide::Bid, 5), 5.0);
+
+    // New touch far above: the window follows, the old levels are parked
+    book.apply(level(LevelSide::Bid, LevelAction::Add, 200.0, 2.0));
+    EXPECT_DOUBLE_EQ(book.best_bid(), 200.0);
+    EXPECT_EQ(book.bid_levels(), 4u);
+
+    VenueBookSnapshot snap;
+    book.to_snapshot(snap);
+    ASSERT_EQ(snap.bids.size(), 4u);
+    EXPECT_DOUBLE_EQ(snap.bids[1].price, 100.0);
+    EXPECT_DOUBLE_EQ(snap.bids[3].price, 50.0);
+}
+
+TEST(L2BookTest, TouchMovesAwayAndBack) {
+    L2Book book(1.0, 16);
+    for (double px : {100.0, 99.0, 97.0}) {
+        book.apply(level(LevelSide::Ask, LevelAction::Add, px + 2.0, 1.0));
+        book.apply(level(LevelSide::Bid, LevelAction::Add, px, px - 90.0));
+    }
+    // Parked deep level updated and deleted while out of the window
+    book.apply(level(LevelSide::Bid, LevelAction::Add, 60.0, 4.0));
+
+    // The touch runs away, parked levels change while it is gone
+    book.apply(level(LevelSide::Bid, LevelAction::Add, 150.0, 1.0));
+    book.apply(level(LevelSide::Bid, LevelAction::Modify, 99.0, 5.0));
+    book.apply(level(LevelSide::Bid, LevelAction::Delete, 60.0));
+    EXPECT_DOUBLE_EQ(book.best_bid(), 150.0);
+
+    // ...and comes back: the book matches the venue's again
+    book.apply(level(LevelSide::Bid, LevelAction::Delete, 150.0));
+    EXPECT_DOUBLE_EQ(book.best_bid(), 100.0);
+    EXPECT_EQ(book.bid_levels(), 3u);
+    EXPECT_DOUBLE_EQ(book.depth(LevelSide::Bid, 1), 10.0);
+    EXPECT_DOUBLE_EQ(book.depth(LevelSide::Bid, 3), 22.0);
+
+    book.apply(level(LevelSide::Bid, LevelAction::Delete, 100.0));
+    book.apply(level(LevelSide::Bid, LevelAction::Delete, 99.0));
+    EXPECT_DOUBLE_EQ(book.best_bid(), 97.0);
+    EXPECT_DOUBLE_EQ(book.best_ask(), 99.0);
+}
+
+TEST(L2BookTest, AggregatorAppliesLevelUpdates) {
+    MarketDataAggregator agg;
+    agg.set_tick_size(1, 0.5);
+    agg.on_level_update(level(LevelSide::Bid, LevelAction::Add, 99.5, 10.0));
+    agg.on_level_update(level(LevelSide::Ask, LevelAction::Add, 100.5, 10.0));
+
+    const auto* view = agg.find_view(1);
+    ASSERT_NE(view, nullptr);
+    EXPECT_DOUBLE_EQ(view->mid_price, 100.0);
+    EXPECT_DOUBLE_EQ(view->spread, 1.0);
+
+    agg.on_level_update(level(LevelSide::Ask, LevelAction::Add, 100.0, 4.0));
+    EXPECT_DOUBLE_EQ(view->mid_price, 99.75);
+    EXPECT_DOUBLE_EQ(view->weighted_depth, 24.0);
+
+    const auto* book = agg.find_l2_book(1, 1);
+    ASSERT_NE(book, nullptr);
+    EXPECT_DOUBLE_EQ(book->tick_size(), 0.5);
+    EXPECT_EQ(book->ask_levels(), 2u);
+}
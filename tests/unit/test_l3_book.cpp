@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "market/l3_book.hpp"
+#include "market/market_data_aggregator.hpp"
+#include "util/flat_index_map.hpp"
+
+using namespace mme;
+
+TEST(FlatIndexMapTest, InsertFindEraseWithGrowth) {
+    FlatIndexMap map(4);
+    for (uint64_t k = 1; k <= 1000; ++k) map.insert(k * 7919, static_cast<uint32_t>(k));
+    EXPECT_EQ(map.size(), 1000u);
+    for (uint64_t k = 1; k <= 1000; k += 2) EXPECT_TRUE(map.erase(k * 7919));
+    EXPECT_EQ(map.size(), 500u);
+    for (uint64_t k = 1; k <= 1000; ++k) {
+        uint32_t expected = (k % 2 == 1) ? FlatIndexMap::kNotFound : static_cast<uint32_t>(k);
+        EXPECT_EQ(map.find(k * 7919), expected);
+    }
+    EXPECT_FALSE(map.erase(12345));
+}
+
+TEST(L3BookTest, AddBuildsAggregatedLevels) {
+    L3Book book(1, 1, 0.01);
+    EXPECT_TRUE(book.add(1, LevelSide::Bid, 99.99, 10.0));
+    EXPECT_TRUE(book.add(2, LevelSide::Bid, 99.99, 5.0));
+    EXPECT_TRUE(book.add(3, LevelSide::Ask, 100.01, 7.0));
+    EXPECT_FALSE(book.add(1, LevelSide::Bid, 99.98, 1.0)); // duplicate id
+
+    EXPECT_NEAR(book.best_bid(), 99.99, 1e-9);
+    EXPECT_NEAR(book.best_ask(), 100.01, 1e-9);
+    EXPECT_DOUBLE_EQ(book.level_quantity(LevelSide::Bid, 99.99), 15.0);
+    EXPECT_EQ(book.level_order_count(LevelSide::Bid, 99.99), 2u);
+    EXPECT_EQ(book.order_count(), 3u);
+}
+
+TEST(L3BookTest, FifoQueuePosition) {
+    L3Book book(1, 1, 0.01);
+    book.add(1, LevelSide::Bid, 99.99, 10.0);
+    book.add(2, LevelSide::Bid, 99.99, 5.0);
+    book.add(3, LevelSide::Bid, 99.99, 2.0);
+
+    EXPECT_DOUBLE_EQ(book.queue_ahead(1), 0.0);
+    EXPECT_DOUBLE_EQ(book.queue_ahead(3), 15.0);
+
+    // Partial execution at the head shrinks the queue ahead of later orders
+    book.execute(1, 4.0);
+    EXPECT_DOUBLE_EQ(book.queue_ahead(3), 11.0);
+
+    // Full cancel of the middle order
+    book.cancel(2);
+    EXPECT_DOUBLE_EQ(book.queue_ahead(3), 6.0);
+    EXPECT_DOUBLE_EQ(book.level_quantity(LevelSide::Bid, 99.99), 8.0);
+    EXPECT_LT(book.queue_ahead(2), 0.0);
+}
+
+TEST(L3BookTest, ExecuteAndCancelRemoveLevels) {
+    L3Book book(1, 1, 0.01);
+    book.add(1, LevelSide::Ask, 100.01, 5.0);
+    book.add(2, LevelSide::Ask, 100.02, 5.0);
+
+    EXPECT_TRUE(book.execute(1, 5.0));
+    EXPECT_NEAR(book.best_ask(), 100.02, 1e-9);
+    EXPECT_DOUBLE_EQ(book.level_quantity(LevelSide::Ask, 100.01), 0.0);
+
+    EXPECT_TRUE(book.cancel(2, 2.0));
+    EXPECT_DOUBLE_EQ(book.level_quantity(LevelSide::Ask, 100.02), 3.0);
+    EXPECT_FALSE(book.cancel(99));
+}
+
+TEST(L3BookTest, ReplaceLosesPriority) {
+    L3Book book(1, 1, 0.01);
+    book.add(1, LevelSide::Bid, 99.99, 10.0);
+    book.add(2, LevelSide::Bid, 99.99, 5.0);
+
+    OrderMessage msg{.type = OrderMessageType::Replace, .order_id = 1,
+                     .new_order_id = 10, .price = 99.99, .quantity = 8.0};
+    EXPECT_TRUE(book.apply(msg));
+    EXPECT_DOUBLE_EQ(book.queue_ahead(2), 0.0);
+    EXPECT_DOUBLE_EQ(book.queue_ahead(10), 5.0);
+    EXPECT_DOUBLE_EQ(book.level_quantity(LevelSide::Bid, 99.99), 13.0);
+}
+
+TEST(L3BookTest, RejectedReplaceKeepsOriginal) {
+    L3Book book(1, 1, 0.01);
+    book.add(1, LevelSide::Bid, 99.99, 10.0);
+    book.add(2, LevelSide::Bid, 99.98, 5.0);
+
+    // The new id is taken by another live order
+    EXPECT_FALSE(book.replace(1, 2, 100.00, 8.0));
+    EXPECT_FALSE(book.replace(1, 3, 100.00, 0.0));
+    EXPECT_DOUBLE_EQ(book.level_quantity(LevelSide::Bid, 99.99), 10.0);
+    EXPECT_DOUBLE_EQ(book.level_quantity(LevelSide::Bid, 99.98), 5.0);
+    EXPECT_NEAR(book.best_bid(), 99.99, 1e-9);
+    EXPECT_TRUE(book.cancel(1));
+
+    // Reusing its own id is fine
+    EXPECT_TRUE(book.replace(2, 2, 99.97, 6.0));
+    EXPECT_DOUBLE_EQ(book.level_quantity(LevelSide::Bid, 99.97), 6.0);
+}
+
+TEST(L3BookTest, PublishesTopOfBookToAggregator) {
+    L3Book book(7, 2, 0.5);
+    book.add(1, LevelSide::Bid, 99.5, 10.0);
+    book.add(2, LevelSide::Bid, 99.0, 10.0);
+    book.add(3, LevelSide::Ask, 100.5, 10.0);
+
+    MarketDataAggregator md;
+    book.publish(md);
+
+    const auto* view = md.find_view(7);
+    ASSERT_NE(view, nullptr);
+    EXPECT_DOUBLE_EQ(view->mid_price, 100.0);
+    ASSERT_EQ(view->venues.size(), 1u);
+    EXPECT_EQ(view->venues[0].venue, 2);
+    EXPECT_EQ(view->venues[0].bids.size(), 2u);
+}
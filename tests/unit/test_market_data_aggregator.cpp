@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include "market/market_data_aggregator.hpp"
 
+#include <cmath>
+#include <cstring>
+
 using namespace mme;
 
 class MarketDataAggregatorTest : public ::testing::Test {
@@ -108,3 +111,121 @@ TEST_F(MarketDataAggregatorTest, VenueSnapshotReplacement) {
     EXPECT_DOUBLE_EQ(view.mid_price, 100.0);
     EXPECT_DOUBLE_EQ(view.spread, 1.0);
 }
+
+TEST_F(MarketDataAggregatorTest, FindViewIsBorrowedAndVersioned) {
+    EXPECT_EQ(agg.find_view(1), nullptr);
+
+    VenueBookSnapshot snap;
+    snap.instrument = 1;
+    snap.venue = 1;
+    snap.bids = {{99.0, 10.0}};
+    snap.asks = {{101.0, 10.0}};
+    agg.on_book_update(snap);
+
+    const InstrumentMarketView* view = agg.find_view(1);
+    ASSERT_NE(view, nullptr);
+    uint64_t seen = view->version;
+    EXPECT_DOUBLE_EQ(view->mid_price, 100.0);
+
+    // Another instrument must not invalidate the borrowed pointer
+    snap.instrument = 2;
+    agg.on_book_update(snap);
+
+    snap.instrument = 1;
+    snap.bids = {{99.5, 10.0}};
+    agg.on_book_update(snap);
+
+    EXPECT_EQ(agg.find_view(1), view);
+    EXPECT_GT(view->version, seen);
+    EXPECT_DOUBLE_EQ(view->mid_price, 100.25);
+}
+
+TEST(BookLevelsTest, FixedCapacityTruncatesAndCopiesTrivially) {
+    static_assert(std::is_trivially_copyable_v<VenueBookSnapshot>);
+
+    BookLevels<2> side = {{99.0, 1.0}, {98.0, 2.0}, {97.0, 3.0}};
+    EXPECT_EQ(side.size(), 2u);
+    EXPECT_FALSE(side.push_back({96.0, 4.0}));
+    EXPECT_DOUBLE_EQ(side[1].price, 98.0);
+
+    VenueBookSnapshot a;
+    a.instrument = 7;
+    a.bids = {{99.0, 10.0}};
+    VenueBookSnapshot b;
+    std::memcpy(&b, &a, sizeof(a));
+    EXPECT_EQ(b.instrument, 7u);
+    EXPECT_EQ(b.bids.size(), 1u);
+    EXPECT_DOUBLE_EQ(b.best_bid(), 99.0);
+    EXPECT_TRUE(b.asks.empty());
+}
+
+TEST_F(MarketDataAggregatorTest, ReportsBookChangeKind) {
+    VenueBookSnapshot v1;
+    v1.instrument = 1;
+    v1.venue = 1;
+    v1.bids = {{99.0, 10.0}};
+    v1.asks = {{101.0, 10.0}};
+    EXPECT_EQ(agg.on_book_update(v1), BookChange::TouchChanged);
+    EXPECT_EQ(agg.on_book_update(v1), BookChange::Unchanged);
+
+    // Quantity-only change at the touch
+    v1.bids = {{99.0, 12.0}};
+    EXPECT_EQ(agg.on_book_update(v1), BookChange::BookChanged);
+    EXPECT_DOUBLE_EQ(agg.find_view(1)->weighted_depth, 22.0);
+
+    // A second venue behind the touch does not move it
+    VenueBookSnapshot v2;
+    v2.instrument = 1;
+    v2.venue = 2;
+    v2.bids = {{98.5, 5.0}};
+    v2.asks = {{101.5, 5.0}};
+    EXPECT_EQ(agg.on_book_update(v2), BookChange::BookChanged);
+    EXPECT_DOUBLE_EQ(agg.find_view(1)->weighted_depth, 32.0);
+
+    // Venue 1 backs off: touch falls back to venue 2's cached best
+    v1.bids = {{98.0, 12.0}};
+    EXPECT_EQ(agg.on_book_update(v1), BookChange::TouchChanged);
+    const auto* view = agg.find_view(1);
+    EXPECT_DOUBLE_EQ(view->spread, 101.0 - 98.5);
+    EXPECT_DOUBLE_EQ(view->mid_price, (98.5 + 101.0) / 2.0);
+}
+
+TEST_F(MarketDataAggregatorTest, PublishesAllVolatilityEstimators) {
+    for (int i = 0; i < 64; ++i) {
+        VenueBookSnapshot snap;
+        snap.instrument = 1;
+        snap.venue = 1;
+        double base = 100.0 + ((i % 2 == 0) ? 0.2 : -0.2);
+        snap.bids = {{base - 0.5, 10.0}};
+        snap.asks = {{base + 0.5, 10.0}};
+        agg.on_book_update(snap);
+    }
+
+    const auto* view = agg.find_view(1);
+    ASSERT_NE(view, nullptr);
+    const auto& est = view->vol_estimates;
+    EXPECT_DOUBLE_EQ(view->volatility, est.ewma[0]);
+    for (double sigma : est.ewma) EXPECT_GT(sigma, 0.0);
+    EXPECT_GT(est.range, 0.0);
+
+    // Constant-magnitude alternating returns: realized sigma = |r|
+    double r = std::log(100.2 / 99.8);
+    EXPECT_NEAR(est.realized, r, 1e-12);
+}
+
+TEST(VolatilityTrackerTest, RealizedWindowEvictsOldReturns) {
+    VolatilityTracker vt({0.1, 0.1, 0.1, 0.1});
+    double mid = 100.0;
+    vt.on_mid(mid);
+    for (size_t i = 0; i < VolatilityTracker::kWindow; ++i) {
+        mid *= 1.01;
+        vt.on_mid(mid);
+    }
+    // Fill the window with flat mids: big returns are evicted
+    for (size_t i = 0; i < VolatilityTracker::kWindow; ++i) {
+        vt.on_mid(mid);
+    }
+    EXPECT_EQ(vt.samples(), VolatilityTracker::kWindow);
+    EXPECT_NEAR(vt.estimates().realized, 0.0, 1e-9);
+    EXPECT_GT(vt.estimates().ewma[0], 0.0);  // EWMA decays but never fully
+}
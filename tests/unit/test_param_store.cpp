@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include "config/config_watcher.hpp"
+#include "risk/risk_manager.hpp"
+#include "strategy/param_store.hpp"
+#include "strategy/quote_engine.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <thread>
+
+using namespace mme;
+
+namespace {
+
+std::unordered_map<InstrumentId, MarketMakingParams> two_instruments() {
+    MarketMakingParams p;
+    p.base_spread_bp = 10.0;
+    p.max_position = 100.0;
+    return {{1, p}, {2, p}};
+}
+
+InstrumentMarketView view_at(InstrumentId id, double mid) {
+    InstrumentMarketView v;
+    v.id = id;
+    v.mid_price = mid;
+    return v;
+}
+
+} // namespace
+
+TEST(ParamStoreTest, PublishBumpsVersionAndKeepsOldSetReadable) {
+    ParamStore store(two_instruments());
+    EXPECT_EQ(store.version(), 1u);
+    const ParamSet& v1 = store.current();
+
+    auto update = two_instruments();
+    update[1].base_spread_bp = 30.0;
+    update.erase(2);
+    ASSERT_TRUE(store.publish(update));
+    EXPECT_EQ(store.version(), 2u);
+
+    InstrumentIndex i1 = store.registry().index(1);
+    InstrumentIndex i2 = store.registry().index(2);
+    EXPECT_DOUBLE_EQ(store.current().at(i1)->base_spread_bp, 30.0);
+    EXPECT_DOUBLE_EQ(store.current().at(i2)->base_spread_bp, 10.0);   // untouched
+    EXPECT_DOUBLE_EQ(v1.at(i1)->base_spread_bp, 10.0);                // still valid
+
+    // Identical values are accepted without a new version
+    ASSERT_TRUE(store.publish(update));
+    EXPECT_EQ(store.version(), 2u);
+}
+
+TEST(ParamStoreTest, RejectsInvalidUpdates) {
+    ParamStore store(two_instruments());
+    std::string error;
+
+    auto bad = two_instruments();
+    bad[1].min_spread_bp = 60.0;   // above max_spread_bp
+    EXPECT_FALSE(store.publish(bad, &error));
+    EXPECT_FALSE(error.empty());
+
+    auto regrid = two_instruments();
+    regrid[2].tick_size = 0.05;
+    EXPECT_FALSE(store.publish(regrid, &error));
+
+    auto unknown = two_instruments();
+    unknown[9] = unknown[1];
+    EXPECT_FALSE(store.publish(unknown, &error));
+
+    // A rejected update publishes nothing, not even its valid entries
+    auto mixed = two_instruments();
+    mixed[1].base_spread_bp = 25.0;
+    mixed[2].size_base = 0.0;
+    EXPECT_FALSE(store.publish(mixed, &error));
+    EXPECT_EQ(store.version(), 1u);
+    EXPECT_DOUBLE_EQ(store.current().at(store.registry().index(1))->base_spread_bp, 10.0);
+}
+
+TEST(ParamStoreTest, QuoteEngineAndRiskManagerSeeReload) {
+    auto store = std::make_shared<ParamStore>(two_instruments());
+    QuoteEngine qe(store);
+    RiskManager risk(store);
+
+    InstrumentPosition flat{.id = 1};
+    Quote before = qe.compute_quote(view_at(1, 100.0), flat, 1);
+    EXPECT_EQ(before.params_version, 1u);
+    EXPECT_TRUE(risk.within_limits(1, 80.0));
+
+    auto update = two_instruments();
+    update[1].base_spread_bp = 40.0;
+    update[1].max_position = 50.0;
+    ASSERT_TRUE(store->publish(update));
+
+    Quote after = qe.compute_quote(view_at(1, 100.0), flat, 1);
+    EXPECT_EQ(after.params_version, 2u);
+    EXPECT_GT(after.ask_ticks - after.bid_ticks, before.ask_ticks - before.bid_ticks);
+    EXPECT_FALSE(risk.within_limits(1, 80.0));
+
+    // Batched quotes carry the version they were staged with
+    QuoteBatch batch;
+    InstrumentIndex i1 = qe.registry().index(1);
+    size_t lane = qe.add_to_batch(batch, i1, view_at(1, 100.0), flat);
+    qe.compute_batch(batch);
+    EXPECT_EQ(qe.batch_quote(batch, lane, i1, 1).params_version, 2u);
+}
+
+TEST(ParamStoreTest, ConcurrentReadersNeverSeeTornSets) {
+    auto store = std::make_shared<ParamStore>(two_instruments());
+    std::atomic<bool> done{false};
+
+    // Every published set has base_spread_bp == 10 * max_position / 100
+    std::thread writer([&] {
+        for (int v = 1; v <= 500; ++v) {
+            auto update = two_instruments();
+            for (auto& [_, p] : update) {
+                p.max_position = 100.0 + v;
+                p.base_spread_bp = 10.0 * p.max_position / 100.0;
+            }
+            store->publish(update);
+        }
+        done = true;
+    });
+
+    InstrumentIndex i1 = store->registry().index(1);
+    uint64_t last = 0;
+    while (!done) {
+        const ParamSet& set = store->current();
+        const auto* p = set.at(i1);
+        ASSERT_NE(p, nullptr);
+        EXPECT_DOUBLE_EQ(p->base_spread_bp, 10.0 * p->max_position / 100.0);
+        EXPECT_GE(set.version, last);
+        last = set.version;
+    }
+    writer.join();
+    EXPECT_EQ(store->version(), 501u);
+}
+
+TEST(ConfigWatcherTest, FiresOnRewrite) {
+    auto dir = std::filesystem::temp_directory_path() / "mme_config_watcher_test";
+    std::filesystem::create_directories(dir);
+    auto path = dir / "config.json";
+    std::ofstream(path) << "{}";
+
+    std::atomic<int> changes{0};
+    ConfigWatcher watcher(path.string(), [&] { ++changes; }, 20);
+    ASSERT_TRUE(watcher.start());
+
+    // Replace via rename, the way most editors save
+    auto tmp = dir / "config.json.tmp";
+    std::ofstream(tmp) << "{\"x\": 1}";
+    std::filesystem::rename(tmp, path);
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (changes == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    watcher.stop();
+    EXPECT_GE(changes.load(), 1);
+    std::filesystem::remove_all(dir);
+}
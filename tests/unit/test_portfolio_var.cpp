@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include "risk/portfolio_var.hpp"
+#include "risk/risk_manager.hpp"
+
+#include <cmath>
+#include <random>
+
+using namespace mme;
+
+namespace {
+
+InstrumentRegistry make_registry(size_t n) {
+    InstrumentRegistry reg;
+    for (size_t i = 0; i < n; ++i) reg.add_instrument(static_cast<InstrumentId>(i + 1));
+    return reg;
+}
+
+} // anonymous namespace
+
+TEST(MatrixKernelsTest, VectorKernelsMatchScalar) {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    constexpr size_t n = 37, stride = 40;
+    std::vector<double> a(n * stride), x(n), y0(n);
+    for (auto& v : a) v = u(rng);
+    for (auto& v : x) v = u(rng);
+    for (auto& v : y0) v = u(rng);
+
+    std::vector<double> ref_y = y0, ref_gemv(n);
+    axpy(0.7, x.data(), ref_y.data(), n, MatrixKernel::Scalar);
+    gemv(a.data(), stride, n, x.data(), ref_gemv.data(), MatrixKernel::Scalar);
+    const double ref_dot = dot(x.data(), y0.data(), n, MatrixKernel::Scalar);
+
+    for (MatrixKernel k : {MatrixKernel::Avx2, MatrixKernel::Avx512}) {
+        std::vector<double> y = y0, g(n);
+        axpy(0.7, x.data(), y.data(), n, k);
+        gemv(a.data(), stride, n, x.data(), g.data(), k);
+        EXPECT_NEAR(dot(x.data(), y0.data(), n, k), ref_dot, 1e-12);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_NEAR(y[i], ref_y[i], 1e-12);
+            EXPECT_NEAR(g[i], ref_gemv[i], 1e-12);
+        }
+    }
+}
+
+TEST(PortfolioVarTest, MatchesFullEwmaRecompute) {
+    constexpr size_t n = 6;
+    // Sampled by hand below, never by the clock
+    const VarConfig config{.lambda = 0.9, .sample_interval = 1'000'000'000'000'000};
+    SimulatedClock clock(1);
+    PortfolioVarEngine engine(make_registry(n), config, &clock);
+
+    std::mt19937 rng(11);
+    std::normal_distribution<double> ret(0.0, 0.01);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    std::vector<double> mid(n, 100.0), sampled(n, 100.0), w(n);
+    std::vector<double> ref(n * n, 0.0);
+
+    for (size_t i = 0; i < n; ++i) engine.on_mid_at(static_cast<InstrumentIndex>(i), mid[i]);
+    for (int step = 0; step < 200; ++step) {
+        // A random subset moves within the interval
+        for (size_t i = 0; i < n; ++i) {
+            if (u(rng) < 0.5) {
+                mid[i] *= std::exp(ret(rng));
+                engine.on_mid_at(static_cast<InstrumentIndex>(i), mid[i]);
+            }
+        }
+        if (step % 17 == 0) {
+            for (size_t i = 0; i < n; ++i) {
+                w[i] = (u(rng) - 0.5) * 1e5;
+                engine.set_exposure_at(static_cast<InstrumentIndex>(i), w[i]);
+            }
+        }
+        engine.sample();
+
+        std::vector<double> r(n);
+        for (size_t i = 0; i < n; ++i) {
+            r[i] = std::log(mid[i] / sampled[i]);
+            sampled[i] = mid[i];
+        }
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                ref[i * n + j] = 0.9 * ref[i * n + j] + 0.1 * r[i] * r[j];
+            }
+        }
+    }
+
+    double quad = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            EXPECT_NEAR(engine.covariance(static_cast<InstrumentIndex>(i),
+                                          static_cast<InstrumentIndex>(j)),
+                        ref[i * n + j], 1e-12);
+            quad += w[i] * ref[i * n + j] * w[j];
+        }
+    }
+    EXPECT_NEAR(engine.variance(), quad, 1e-6 * quad);
+    EXPECT_NEAR(engine.var(), 2.326 * std::sqrt(quad), 1e-6 * engine.var());
+
+    // Components add up to the total
+    double sum = 0.0;
+    for (InstrumentIndex i = 0; i < n; ++i) sum += engine.component_var_at(i);
+    EXPECT_NEAR(sum, engine.var(), 1e-6 * engine.var());
+
+    const double before = engine.var();
+    engine.resync();
+    EXPECT_NEAR(engine.var(), before, 1e-9 * before);
+}
+
+TEST(PortfolioVarTest, HedgedBookHasLowerVar) {
+    const VarConfig config{.sample_interval = 1000};
+    SimulatedClock clock(1);
+    PortfolioVarEngine engine(make_registry(2), config, &clock);
+
+    // Two instruments that always move together
+    std::mt19937 rng(2);
+    std::normal_distribution<double> ret(0.0, 0.01);
+    double px = 100.0;
+    for (int t = 0; t < 100; ++t) {
+        px *= std::exp(ret(rng));
+        engine.on_mid_at(0, px);
+        engine.on_mid_at(1, px * 2.0);
+        clock.advance(1000);
+    }
+    engine.set_exposure_at(0, 1e6);
+    const double outright = engine.var();
+    EXPECT_GT(outright, 0.0);
+    EXPECT_GT(engine.marginal_var_at(1), 0.0);
+    // Shorting the other leg reduces risk, as the marginal predicts
+    EXPECT_LT(engine.var_with(1, -1e6), outright);
+
+    engine.set_exposure_at(1, -1e6);
+    EXPECT_LT(engine.var(), 1e-6 * outright);
+}
+
+TEST(PortfolioVarTest, RiskManagerBlocksOrdersThatRaiseVar) {
+    MarketMakingParams p;
+    p.tick_size = 0.01;
+    p.lot_size = 1.0;
+    p.max_position = 1e6;
+    std::unordered_map<InstrumentId, MarketMakingParams> params{{1, p}};
+    RiskManager risk(params);
+    SimulatedClock clock(1);
+    risk.enable_portfolio_var(VarConfig{.sample_interval = 1000}, &clock);
+
+    std::mt19937 rng(4);
+    std::normal_distribution<double> ret(0.0, 0.01);
+    double px = 100.0;
+    for (int t = 0; t < 100; ++t) {
+        px *= std::exp(ret(rng));
+        risk.on_mark(1, px);
+        clock.advance(1000);
+    }
+    risk.on_fill(1, px, 1000.0);
+    const double var = risk.portfolio_var()->var();
+    ASSERT_GT(var, 0.0);
+
+    risk.set_portfolio_limits(PortfolioLimits{.max_var = var * 1.05});
+    const PriceTicks ticks = std::llround(px / p.tick_size);
+    EXPECT_EQ(risk.check_order_at(0, ticks, 10, clock.now()), RiskCheck::Ok);
+    EXPECT_EQ(risk.check_order_at(0, ticks, 100, clock.now()), RiskCheck::PortfolioVar);
+    // Selling reduces VaR and always passes
+    EXPECT_EQ(risk.check_order_at(0, ticks, -500, clock.now()), RiskCheck::Ok);
+}
@@ -97,8 +97,11 @@ TEST_F(QuoteEngineTest, InventorySkewLong) {
     // When long, both bid and ask move down (skew > 0)
     double spread_abs = 10.0 * 100.0 / 10000.0; // 0.10
     double skew = 0.5 * 0.5 * spread_abs; // 0.025
-    EXPECT_NEAR(quote.bid_price, 100.0 - spread_abs / 2.0 - skew, 0.001);
-    EXPECT_NEAR(quote.ask_price, 100.0 + spread_abs / 2.0 - skew, 0.001);
+    // 99.925 / 100.025 rounded passively onto the 0.01 grid
+    EXPECT_EQ(quote.bid_ticks, 9992);
+    EXPECT_EQ(quote.ask_ticks, 10003);
+    EXPECT_NEAR(quote.bid_price, 100.0 - spread_abs / 2.0 - skew, 0.01);
+    EXPECT_NEAR(quote.ask_price, 100.0 + spread_abs / 2.0 - skew, 0.01);
 
     // Ask is lower (more aggressive selling), bid is lower (less aggressive buying)
     EXPECT_LT(quote.ask_price, 100.0 + spread_abs / 2.0);
@@ -165,3 +168,151 @@ TEST_F(QuoteEngineTest, UnknownInstrument) {
     auto quote = qe->compute_quote(view, pos, 1);
     EXPECT_DOUBLE_EQ(quote.bid_price, 0.0);
 }
+
+TEST_F(QuoteEngineTest, SpreadUsesSelectedVolatilityEstimator) {
+    MarketMakingParams params;
+    params.base_spread_bp = 10.0;
+    params.volatility_coeff = 1.0;
+    params.volatility_estimator = VolatilityEstimator::Realized;
+    QuoteEngine engine({{1, params}});
+
+    InstrumentMarketView view;
+    view.id = 1;
+    view.mid_price = 100.0;
+    view.volatility = 0.0;
+    view.vol_estimates.realized = 0.001; // 10bp
+
+    InstrumentPosition pos{.id = 1};
+    auto quote = engine.compute_quote(view, pos, 1);
+
+    // spread = 10bp + 10bp from the realized estimator
+    EXPECT_NEAR(quote.ask_price - quote.bid_price, 0.20, 0.001);
+}
+
+TEST_F(QuoteEngineTest, CentersOnSelectedFairPrice) {
+    MarketMakingParams params;
+    params.base_spread_bp = 10.0;
+    params.fair_price = FairPrice::Microprice;
+    QuoteEngine engine({{1, params}});
+
+    InstrumentMarketView view;
+    view.id = 1;
+    view.mid_price = 100.0;
+    view.microprice = 100.2;
+
+    InstrumentPosition pos{.id = 1};
+    auto quote = engine.compute_quote(view, pos, 1);
+    EXPECT_NEAR((quote.bid_price + quote.ask_price) / 2.0, 100.2, 1e-9);
+
+    // Falls back to mid when the signal is not available
+    view.microprice = 0.0;
+    quote = engine.compute_quote(view, pos, 1);
+    EXPECT_NEAR((quote.bid_price + quote.ask_price) / 2.0, 100.0, 1e-9);
+}
+
+TEST_F(QuoteEngineTest, RoundsOntoTickAndLotGrid) {
+    MarketMakingParams p;
+    p.base_spread_bp = 3.0;
+    p.min_spread_bp = 0.0;
+    p.tick_size = 0.05;
+    p.lot_size = 1.0;
+    p.size_base = 5.0;
+    p.size_inventory_scale = 0.5;
+    p.max_position = 100.0;
+    QuoteEngine engine({{1, p}});
+
+    InstrumentMarketView view;
+    view.id = 1;
+    view.mid_price = 100.0;
+    InstrumentPosition pos{.id = 1, .quantity = 50.0};
+
+    // Raw 99.985 / 100.015 with skew 0.0075: bid rounds down, ask up
+    auto quote = engine.compute_quote(view, pos, 1);
+    EXPECT_EQ(quote.bid_ticks, 1999);
+    EXPECT_EQ(quote.ask_ticks, 2001);
+    EXPECT_DOUBLE_EQ(quote.bid_price, 1999 * 0.05);
+    EXPECT_DOUBLE_EQ(quote.ask_price, 2001 * 0.05);
+
+    // 3.75 rounds down to whole lots
+    EXPECT_EQ(quote.bid_lots, 3);
+    EXPECT_DOUBLE_EQ(quote.bid_size, 3.0);
+
+    // A spread narrower than one tick still leaves the two sides a tick apart
+    PriceScale scale = p.scale();
+    EXPECT_EQ(scale.bid_ticks(100.0), 2000);   // on-grid price is not moved
+    EXPECT_EQ(scale.ask_ticks(100.0), 2000);
+    EXPECT_EQ(scale.to_lots(-2.5), -2);
+}
+
+TEST(QuoteEngineCacheTest, ReusesQuoteWhileKeyUnchanged) {
+    MarketMakingParams params;
+    params.max_position = 100.0;
+    params.volatility_coeff = 10.0;
+    params.quote_cache_vol_bucket = 0.001;
+    auto store = std::make_shared<ParamStore>(
+        std::unordered_map<InstrumentId, MarketMakingParams>{{1, params}});
+    QuoteEngine qe(store);
+
+    InstrumentMarketView view;
+    view.id = 1;
+    view.mid_price = 100.0;
+    view.volatility = 0.0012;
+    InstrumentPosition pos{.id = 1};
+
+    Quote first = qe.compute_quote(view, pos, 1);
+    EXPECT_EQ(qe.cache_stats().misses, 1u);
+
+    // Same tick and same vol bucket: the first quote comes back
+    view.mid_price = 100.001;
+    view.volatility = 0.0018;
+    Quote second = qe.compute_quote(view, pos, 2);
+    EXPECT_EQ(qe.cache_stats().hits, 1u);
+    EXPECT_EQ(second.bid_ticks, first.bid_ticks);
+    EXPECT_EQ(second.ask_ticks, first.ask_ticks);
+    EXPECT_EQ(second.venue, 2);
+
+    // Each key component invalidates
+    view.volatility = 0.0021;
+    qe.compute_quote(view, pos, 1);
+    pos.quantity = 5.0;
+    qe.compute_quote(view, pos, 1);
+    view.mid_price = 100.5;
+    qe.compute_quote(view, pos, 1);
+    auto update = std::unordered_map<InstrumentId, MarketMakingParams>{{1, params}};
+    update[1].base_spread_bp = 20.0;
+    ASSERT_TRUE(store->publish(update));
+    Quote reloaded = qe.compute_quote(view, pos, 1);
+    EXPECT_EQ(qe.cache_stats().hits, 1u);
+    EXPECT_EQ(qe.cache_stats().misses, 5u);
+    EXPECT_EQ(reloaded.params_version, 2u);
+    EXPECT_DOUBLE_EQ(qe.cache_stats().hit_rate(), 1.0 / 6.0);
+}
+
+TEST(QuoteEngineCacheTest, BatchPathSharesCache) {
+    MarketMakingParams params;
+    params.quote_cache_vol_bucket = 0.001;
+    QuoteEngine qe(std::unordered_map<InstrumentId, MarketMakingParams>{{1, params}});
+
+    InstrumentMarketView view;
+    view.id = 1;
+    view.mid_price = 100.0;
+    InstrumentPosition pos{.id = 1};
+
+    QuoteBatch batch;
+    size_t lane = qe.add_to_batch(batch, 0, view, pos);
+    ASSERT_NE(lane, QuoteEngine::kCachedLane);
+    qe.compute_batch(batch);
+    Quote staged = qe.batch_quote(batch, lane, 0, 1);
+
+    batch.clear();
+    EXPECT_EQ(qe.add_to_batch(batch, 0, view, pos), QuoteEngine::kCachedLane);
+    EXPECT_EQ(batch.size(), 0u);
+    Quote cached = qe.batch_quote(batch, QuoteEngine::kCachedLane, 0, 1);
+    EXPECT_EQ(cached.bid_ticks, staged.bid_ticks);
+    EXPECT_EQ(cached.ask_lots, staged.ask_lots);
+
+    // The scalar path sees the entry the batch filled
+    qe.compute_quote(view, pos, 1);
+    EXPECT_EQ(qe.cache_stats().hits, 2u);
+    EXPECT_EQ(qe.cache_stats().misses, 1u);
+}
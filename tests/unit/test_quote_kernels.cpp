@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "strategy/quote_engine.hpp"
+#include "strategy/quote_kernels.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace mme;
+
+namespace {
+
+// Random lanes, including the branches: zero / negative fair, no position
+// limit, inventory past +-80% of the limit, clamped spreads, and a skew
+// inventory that differs from the position on every other lane.
+QuoteBatch random_batch(size_t n, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    QuoteBatch batch;
+    for (size_t i = 0; i < n; ++i) {
+        MarketMakingParams p;
+        p.base_spread_bp       = 1.0 + 20.0 * u(rng);
+        p.min_spread_bp        = 2.0 * u(rng);
+        p.max_spread_bp        = p.min_spread_bp + 40.0 * u(rng);
+        p.volatility_coeff     = 5.0 * u(rng);
+        p.inventory_coeff      = u(rng);
+        p.size_base            = 0.5 + 20.0 * u(rng);
+        p.size_inventory_scale = u(rng);
+        p.max_position         = (i % 11 == 0) ? 0.0 : 10.0 + 200.0 * u(rng);
+        p.tick_size            = (i % 3 == 0) ? 0.5 : 0.01;
+        p.lot_size             = (i % 5 == 0) ? 1.0 : 0.01;
+        double fair = (i % 13 == 0) ? -1.0 : (i % 17 == 0 ? 0.0 : 1.0 + 5000.0 * u(rng));
+        double vol  = 0.01 * u(rng);
+        double inv  = (2.4 * u(rng) - 1.2) * (p.max_position > 0 ? p.max_position : 50.0);
+        if (i % 2) {
+            batch.add(fair, vol, inv, p);
+        } else {
+            double skew_inv = (2.0 * u(rng) - 1.0) * (p.max_position > 0 ? p.max_position : 50.0);
+            batch.add(fair, vol, inv, skew_inv, p);
+        }
+    }
+    return batch;
+}
+
+std::vector<QuoteLane> run(QuoteBatch& batch, QuoteKernel kernel) {
+    compute_quotes(batch.input(), batch.output(), kernel);
+    std::vector<QuoteLane> out;
+    for (size_t i = 0; i < batch.size(); ++i) out.push_back(batch.result(i));
+    return out;
+}
+
+} // namespace
+
+TEST(QuoteKernelsTest, KernelsMatchScalarExactly) {
+    const size_t n = 1003;   // not a multiple of either vector width
+    QuoteBatch batch = random_batch(n, 7);
+    auto ref = run(batch, QuoteKernel::Scalar);
+
+    for (QuoteKernel k : {QuoteKernel::Avx2, QuoteKernel::Avx512}) {
+        auto got = run(batch, k);
+        for (size_t i = 0; i < n; ++i) {
+            SCOPED_TRACE(i);
+            EXPECT_EQ(got[i].bid_ticks, ref[i].bid_ticks);
+            EXPECT_EQ(got[i].ask_ticks, ref[i].ask_ticks);
+            EXPECT_EQ(got[i].bid_lots, ref[i].bid_lots);
+            EXPECT_EQ(got[i].ask_lots, ref[i].ask_lots);
+        }
+    }
+
+    const auto in = batch.input();
+    for (size_t i = 0; i < n; ++i) {
+        if (in.fair[i] <= 0.0) {
+            EXPECT_EQ(ref[i].bid_ticks, 0);
+            EXPECT_EQ(ref[i].ask_lots, 0);
+        } else {
+            EXPECT_GT(ref[i].ask_ticks, ref[i].bid_ticks);
+        }
+    }
+}
+
+TEST(QuoteKernelsTest, BatchMatchesComputeQuote) {
+    std::unordered_map<InstrumentId, MarketMakingParams> pm;
+    for (InstrumentId id = 1; id <= 20; ++id) {
+        MarketMakingParams p;
+        p.base_spread_bp  = 5.0 + id;
+        p.inventory_coeff = 0.3;
+        p.max_position    = 100.0;
+        p.tick_size       = (id % 2) ? 0.01 : 0.05;
+        pm[id] = p;
+    }
+    QuoteEngine qe(pm);
+
+    QuoteBatch batch;
+    std::vector<InstrumentMarketView> views;
+    std::vector<InstrumentPosition> positions;
+    for (InstrumentIndex i = 0; i < qe.registry().size(); ++i) {
+        InstrumentMarketView view;
+        view.id = qe.registry().id(i);
+        view.mid_price = 100.0 + 3.7 * i;
+        view.volatility = 0.0002 * i;
+        views.push_back(view);
+        positions.push_back(InstrumentPosition{.id = view.id, .quantity = 9.0 * i - 90.0});
+        EXPECT_EQ(qe.add_to_batch(batch, i, views[i], positions[i]), i);
+    }
+    qe.compute_batch(batch);
+
+    for (InstrumentIndex i = 0; i < qe.registry().size(); ++i) {
+        Quote single = qe.compute_quote_at(i, views[i], positions[i], 1);
+        Quote batched = qe.batch_quote(batch, i, i, 1);
+        EXPECT_EQ(batched.id, single.id);
+        EXPECT_EQ(batched.bid_ticks, single.bid_ticks);
+        EXPECT_EQ(batched.ask_ticks, single.ask_ticks);
+        EXPECT_EQ(batched.bid_lots, single.bid_lots);
+        EXPECT_EQ(batched.ask_lots, single.ask_lots);
+        EXPECT_EQ(batched.bid_price, single.bid_price);
+    }
+}
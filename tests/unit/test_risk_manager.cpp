@@ -95,3 +95,119 @@ TEST_F(RiskManagerTest, TotalPortfolioPnL) {
 TEST_F(RiskManagerTest, UnknownInstrumentWithinLimits) {
     EXPECT_FALSE(risk->within_limits(999, 1.0)); // unknown instrument
 }
+
+TEST_F(RiskManagerTest, MarkUpdatesOnlyThatInstrument) {
+    risk->on_fill(1, 100.0, 10.0);
+    risk->on_fill(2, 200.0, -5.0);
+    // Unmarked positions are carried at their average price
+    EXPECT_DOUBLE_EQ(risk->portfolio().total_net_exposure, 10.0 * 100.0 - 5.0 * 200.0);
+    EXPECT_DOUBLE_EQ(risk->portfolio().total_gross_notional, 10.0 * 100.0 + 5.0 * 200.0);
+
+    risk->on_mark(1, 104.0);
+    EXPECT_DOUBLE_EQ(risk->position(1).unrealized_pnl, 40.0);
+    EXPECT_DOUBLE_EQ(risk->position(2).unrealized_pnl, 0.0);
+    EXPECT_DOUBLE_EQ(risk->portfolio().total_unrealized_pnl, 40.0);
+    EXPECT_DOUBLE_EQ(risk->portfolio().total_net_exposure, 1040.0 - 1000.0);
+
+    risk->on_mark(2, 190.0);   // short gains as the price falls
+    EXPECT_DOUBLE_EQ(risk->position(2).unrealized_pnl, 50.0);
+    EXPECT_DOUBLE_EQ(risk->portfolio().total_unrealized_pnl, 90.0);
+    EXPECT_DOUBLE_EQ(risk->portfolio().total_gross_notional, 1040.0 + 950.0);
+
+    // A fill re-marks at the last mid
+    risk->on_fill(1, 104.0, -10.0);
+    EXPECT_DOUBLE_EQ(risk->position(1).unrealized_pnl, 0.0);
+    EXPECT_DOUBLE_EQ(risk->portfolio().total_unrealized_pnl, 50.0);
+    EXPECT_DOUBLE_EQ(risk->portfolio().total_net_exposure, -950.0);
+}
+
+TEST_F(RiskManagerTest, IncrementalTotalsMatchResync) {
+    for (int i = 0; i < 1000; ++i) {
+        InstrumentId id = 1 + i % 2;
+        risk->on_fill(id, 100.0 + i % 7, (i % 3 == 0) ? -1.5 : 1.0);
+        risk->on_mark(id, 100.0 + 0.37 * (i % 11));
+    }
+    PortfolioState incremental = risk->portfolio();
+    risk->resync_totals();
+    const auto& exact = risk->portfolio();
+    EXPECT_NEAR(incremental.total_unrealized_pnl, exact.total_unrealized_pnl, 1e-6);
+    EXPECT_NEAR(incremental.total_net_exposure, exact.total_net_exposure, 1e-6);
+    EXPECT_NEAR(incremental.total_gross_notional, exact.total_gross_notional, 1e-6);
+}
+
+TEST_F(RiskManagerTest, OpenOrdersCountTowardPositionLimit) {
+    // Default grid: tick 0.01, lot 0.01 -> 1 unit = 100 lots
+    const InstrumentIndex i = risk->registry().index(1);
+    EXPECT_EQ(risk->check_order_at(i, 10000, 6000, 0), RiskCheck::Ok);
+    risk->on_order_open_at(i, 10000, 6000, 0);   // 60 resting on the bid
+
+    // Another 50 could take the position to 110 if both fill
+    EXPECT_EQ(risk->check_order_at(i, 10000, 5000, 0), RiskCheck::PositionLimit);
+    EXPECT_FALSE(risk->within_limits(1, 50.0));
+    // Replacing the resting bid is judged on the new size alone
+    EXPECT_EQ(risk->check_order_at(i, 10010, 9000, 0, 10000, 6000), RiskCheck::Ok);
+    // The other side is unaffected
+    EXPECT_EQ(risk->check_order_at(i, 10100, -9000, 0), RiskCheck::Ok);
+
+    risk->on_order_closed_at(i, 10000, 6000);
+    EXPECT_EQ(risk->open_orders_at(i).buy_lots, 0);
+    EXPECT_EQ(risk->check_order_at(i, 10000, 5000, 0), RiskCheck::Ok);
+}
+
+TEST_F(RiskManagerTest, PortfolioNotionalLimits) {
+    risk->set_portfolio_limits(PortfolioLimits{.max_gross_notional = 10000.0,
+                                               .max_net_exposure = 6000.0});
+    const InstrumentIndex i2 = risk->registry().index(2);
+
+    risk->on_fill(1, 100.0, 40.0);   // 4000 net and gross
+    EXPECT_EQ(risk->check_order_at(i2, 10000, 2000, 0), RiskCheck::Ok);          // +2000
+    EXPECT_EQ(risk->check_order_at(i2, 10000, 2100, 0), RiskCheck::NetExposure);  // +2100
+    risk->on_order_open_at(i2, 10000, 2000, 0);
+    EXPECT_DOUBLE_EQ(risk->open_buy_notional(), 2000.0);
+
+    // Sells on a flat instrument reduce net but still add gross:
+    // 4000 + 2000 + 4500 > 10000
+    EXPECT_EQ(risk->check_order_at(i2, 10000, -4500, 0), RiskCheck::GrossNotional);
+    EXPECT_EQ(risk->check_order_at(i2, 10000, -3000, 0), RiskCheck::Ok);
+
+    risk->on_order_closed_at(i2, 10000, 2000);
+    EXPECT_DOUBLE_EQ(risk->open_buy_notional(), 0.0);
+}
+
+TEST_F(RiskManagerTest, UnwindsWhileOverGrossLimit) {
+    risk->set_portfolio_limits(PortfolioLimits{.max_gross_notional = 10000.0});
+    const InstrumentIndex i = risk->registry().index(1);
+
+    risk->on_fill(1, 100.0, 80.0);   // 8000 gross
+    risk->on_mark(1, 150.0);         // 12000: over the limit on marks alone
+    EXPECT_EQ(risk->check_order_at(i, 15000, 100, 0), RiskCheck::GrossNotional);
+
+    // Selling back toward flat adds no gross
+    EXPECT_EQ(risk->check_order_at(i, 15000, -5000, 0), RiskCheck::Ok);
+    EXPECT_EQ(risk->check_order_at(i, 15000, -8000, 0), RiskCheck::Ok);
+    // Only the part that would go short counts
+    EXPECT_EQ(risk->check_order_at(i, 15000, -8100, 0), RiskCheck::GrossNotional);
+
+    // Resting sells already claim the unwind
+    risk->on_order_open_at(i, 15000, -6000, 0);
+    EXPECT_EQ(risk->check_order_at(i, 15000, -2000, 0), RiskCheck::Ok);
+    EXPECT_EQ(risk->check_order_at(i, 15000, -3000, 0), RiskCheck::GrossNotional);
+    // Replacing the resting sell frees its share
+    EXPECT_EQ(risk->check_order_at(i, 15100, -8000, 0, 15000, -6000), RiskCheck::Ok);
+}
+
+TEST(RiskManagerRateTest, OrderRateLimitRefills) {
+    MarketMakingParams params;
+    params.max_order_rate = 2.0;   // 2 per second, bursts of 2
+    RiskManager risk(std::unordered_map<InstrumentId, MarketMakingParams>{{1, params}});
+    const Timestamp second = 1'000'000'000;
+
+    EXPECT_EQ(risk.check_order_at(0, 100, 1, 0), RiskCheck::Ok);
+    risk.on_order_open_at(0, 100, 1, 0);
+    EXPECT_EQ(risk.check_order_at(0, 100, 1, 0), RiskCheck::Ok);
+    risk.on_order_open_at(0, 100, 1, 0);
+    EXPECT_EQ(risk.check_order_at(0, 100, 1, 0), RiskCheck::OrderRate);
+    EXPECT_EQ(risk.check_order_at(0, 100, 1, second / 2), RiskCheck::Ok);
+    risk.on_order_open_at(0, 100, 1, second / 2);
+    EXPECT_EQ(risk.check_order_at(0, 100, 1, second / 2), RiskCheck::OrderRate);
+}
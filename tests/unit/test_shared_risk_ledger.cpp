@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "risk/shared_risk_ledger.hpp"
+
+#include <thread>
+#include <vector>
+
+using namespace mme;
+
+class SharedRiskLedgerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        MarketMakingParams p;
+        p.tick_size = 0.01;
+        p.lot_size = 1.0;
+        p.max_position = 100.0;
+        params[1] = p;
+        params[2] = p;
+        registry = InstrumentRegistry::from_keys(params);
+    }
+
+    std::unique_ptr<SharedRiskLedger> make(PortfolioLimits limits = {}) {
+        return std::make_unique<SharedRiskLedger>(registry, params, limits);
+    }
+
+    std::unordered_map<InstrumentId, MarketMakingParams> params;
+    InstrumentRegistry registry;
+};
+
+TEST_F(SharedRiskLedgerTest, ReserveCountsOpenOrdersTowardPositionLimit) {
+    auto ledger = make();
+    LedgerReservation a, b, c;
+    EXPECT_EQ(ledger->reserve(0, 10000, 60, &a), RiskCheck::Ok);
+    EXPECT_EQ(ledger->reserve(0, 10000, 50, &b), RiskCheck::PositionLimit);
+    EXPECT_EQ(ledger->reserve(0, 10000, 40, &b), RiskCheck::Ok);
+    EXPECT_EQ(ledger->open_buy_lots(0), 100);
+
+    // Sells are bounded separately
+    EXPECT_EQ(ledger->reserve(0, 10010, -100, &c), RiskCheck::Ok);
+
+    ledger->release(a);
+    EXPECT_FALSE(a);
+    EXPECT_EQ(ledger->open_buy_lots(0), 40);
+    EXPECT_EQ(ledger->stats().position_limit, 1u);
+}
+
+TEST_F(SharedRiskLedgerTest, CommitMovesFillIntoPosition) {
+    auto ledger = make();
+    LedgerReservation r;
+    ASSERT_EQ(ledger->reserve(0, 10000, 10, &r), RiskCheck::Ok);   // 10 @ 100.00
+    EXPECT_DOUBLE_EQ(ledger->gross_notional(), 1000.0);
+
+    ledger->commit(r, 4, 10000);
+    EXPECT_EQ(ledger->position_lots(0), 4);
+    EXPECT_EQ(ledger->open_buy_lots(0), 6);
+    EXPECT_EQ(r.lots, 6);
+    EXPECT_DOUBLE_EQ(ledger->gross_notional(), 1000.0);
+
+    ledger->commit(r, 6, 10000);
+    EXPECT_FALSE(r);
+    EXPECT_EQ(ledger->position_lots(0), 10);
+    EXPECT_EQ(ledger->open_buy_lots(0), 0);
+    EXPECT_DOUBLE_EQ(ledger->long_exposure(), 1000.0);
+
+    // Marks revalue the position
+    ledger->on_mark_at(0, 11000);
+    EXPECT_DOUBLE_EQ(ledger->gross_notional(), 1100.0);
+    EXPECT_DOUBLE_EQ(ledger->short_exposure(), 1100.0);
+
+    // The position now counts toward the limit
+    LedgerReservation more;
+    EXPECT_EQ(ledger->reserve(0, 10000, 91, &more), RiskCheck::PositionLimit);
+}
+
+TEST_F(SharedRiskLedgerTest, PortfolioLimitsRollBackPartialClaims) {
+    auto ledger = make(PortfolioLimits{.max_gross_notional = 3000.0, .max_net_exposure = 1500.0});
+    LedgerReservation a, b, c;
+    EXPECT_EQ(ledger->reserve(0, 10000, 10, &a), RiskCheck::Ok);    // +1000 long
+    EXPECT_EQ(ledger->reserve(1, 10000, 6, &b), RiskCheck::NetExposure);
+    // The failed claim left nothing behind
+    EXPECT_EQ(ledger->open_buy_lots(1), 0);
+    EXPECT_DOUBLE_EQ(ledger->gross_notional(), 1000.0);
+
+    EXPECT_EQ(ledger->reserve(1, 10000, -15, &b), RiskCheck::Ok);   // 1500 short
+    EXPECT_EQ(ledger->reserve(1, 10000, 6, &c), RiskCheck::GrossNotional);
+    EXPECT_EQ(ledger->stats().rollbacks, 2u);
+
+    ledger->release(b);
+    ledger->release(a);
+    EXPECT_DOUBLE_EQ(ledger->gross_notional(), 0.0);
+    EXPECT_DOUBLE_EQ(ledger->long_exposure(), 0.0);
+    EXPECT_DOUBLE_EQ(ledger->short_exposure(), 0.0);
+}
+
+TEST_F(SharedRiskLedgerTest, ConcurrentReservationsNeverExceedLimits) {
+    auto ledger = make(PortfolioLimits{.max_gross_notional = 5000.0});
+    constexpr int kThreads = 4;
+    constexpr int kRounds  = 20000;
+
+    std::atomic<bool> breached{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            std::vector<LedgerReservation> held;
+            for (int i = 0; i < kRounds; ++i) {
+                LedgerReservation r;
+                const InstrumentIndex index = static_cast<InstrumentIndex>((i + t) % 2);
+                if (ledger->reserve(index, 10000, (t % 2) ? -7 : 7, &r) == RiskCheck::Ok) {
+                    held.push_back(r);
+                }
+                if (ledger->gross_notional() > 5000.0 || ledger->open_buy_lots(index) > 100 ||
+                    ledger->open_sell_lots(index) > 100) {
+                    breached = true;
+                }
+                if (held.size() > 3 || (i % 7 == 0 && !held.empty())) {
+                    ledger->release(held.front());
+                    held.erase(held.begin());
+                }
+            }
+            for (auto& r : held) ledger->release(r);
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    EXPECT_FALSE(breached.load());
+    EXPECT_DOUBLE_EQ(ledger->gross_notional(), 0.0);
+    for (InstrumentIndex i = 0; i < 2; ++i) {
+        EXPECT_EQ(ledger->open_buy_lots(i), 0);
+        EXPECT_EQ(ledger->open_sell_lots(i), 0);
+    }
+}
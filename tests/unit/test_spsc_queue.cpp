@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "runtime/latency_recorder.hpp"
+#include "runtime/spsc_queue.hpp"
+
+#include <thread>
+
+using namespace mme;
+
+TEST(SpscQueueTest, RoundsCapacityAndReportsFull) {
+    SpscQueue<int> q(5);
+    EXPECT_EQ(q.capacity(), 8u);
+
+    for (int i = 0; i < 8; ++i) EXPECT_TRUE(q.try_push(i));
+    EXPECT_FALSE(q.try_push(99));
+    EXPECT_EQ(q.size(), 8u);
+
+    int v = -1;
+    EXPECT_TRUE(q.try_pop(v));
+    EXPECT_EQ(v, 0);
+    EXPECT_TRUE(q.try_push(8));
+
+    for (int i = 1; i <= 8; ++i) {
+        ASSERT_TRUE(q.try_pop(v));
+        EXPECT_EQ(v, i);
+    }
+    EXPECT_FALSE(q.try_pop(v));
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(SpscQueueTest, PreservesOrderAcrossThreads) {
+    constexpr uint64_t kCount = 200000;
+    SpscQueue<uint64_t> q(64);
+
+    std::thread producer([&] {
+        for (uint64_t i = 0; i < kCount; ++i) {
+            while (!q.try_push(i)) std::this_thread::yield();
+        }
+    });
+
+    uint64_t expected = 0;
+    uint64_t v = 0;
+    while (expected < kCount) {
+        if (q.try_pop(v)) {
+            ASSERT_EQ(v, expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(LatencyRecorderTest, Percentiles) {
+    LatencyRecorder rec(1000);
+    for (uint64_t i = 1; i <= 100; ++i) rec.record(i);
+
+    auto s = rec.summary();
+    EXPECT_EQ(s.count, 100u);
+    EXPECT_EQ(s.min_ns, 1u);
+    EXPECT_EQ(s.max_ns, 100u);
+    EXPECT_EQ(s.p50_ns, 50u);
+    EXPECT_EQ(s.p99_ns, 99u);
+    EXPECT_DOUBLE_EQ(s.mean_ns, 50.5);
+}
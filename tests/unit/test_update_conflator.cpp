@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include "strategy/update_conflator.hpp"
+
+#include <vector>
+
+using namespace mme;
+
+namespace {
+
+VenueBookSnapshot make_snap(InstrumentId id, VenueId venue, double bid) {
+    VenueBookSnapshot snap;
+    snap.instrument = id;
+    snap.venue = venue;
+    snap.bids = {{bid, 10.0}};
+    snap.asks = {{bid + 1.0, 10.0}};
+    return snap;
+}
+
+} // anonymous namespace
+
+TEST(UpdateConflatorTest, LatestWinsPerInstrumentVenue) {
+    UpdateConflator c;
+    c.push(make_snap(1, 1, 99.0), 0);
+    c.push(make_snap(2, 1, 49.0), 0);
+    c.push(make_snap(1, 1, 99.5), 0);
+    c.push(make_snap(1, 2, 98.0), 0);
+    EXPECT_EQ(c.pending(), 3u);
+    EXPECT_TRUE(c.ready(0));
+
+    std::vector<VenueBookSnapshot> out;
+    c.drain([&](const VenueBookSnapshot& s) { out.push_back(s); });
+
+    ASSERT_EQ(out.size(), 3u);
+    EXPECT_EQ(out[0].instrument, 1u);          // first-arrival order
+    EXPECT_DOUBLE_EQ(out[0].best_bid(), 99.5); // latest value
+    EXPECT_EQ(out[1].instrument, 2u);
+    EXPECT_EQ(out[2].venue, 2);
+
+    EXPECT_EQ(c.stats().received, 4u);
+    EXPECT_EQ(c.stats().conflated, 1u);
+    EXPECT_EQ(c.stats().applied, 3u);
+    EXPECT_EQ(c.stats().flushes, 1u);
+    EXPECT_EQ(c.pending(), 0u);
+    EXPECT_FALSE(c.ready(0));
+}
+
+TEST(UpdateConflatorTest, TimeWindowPolicy) {
+    UpdateConflator c({.policy = ConflationPolicy::TimeWindow, .time_window_ms = 10});
+    c.push(make_snap(1, 1, 99.0), ms_to_ns(100));
+    c.push(make_snap(1, 1, 99.1), ms_to_ns(105));
+    EXPECT_FALSE(c.ready(ms_to_ns(105)));
+    EXPECT_TRUE(c.ready(ms_to_ns(110)));
+}
+
+TEST(UpdateConflatorTest, CountWindowPolicy) {
+    UpdateConflator c({.policy = ConflationPolicy::CountWindow, .count_window = 3});
+    c.push(make_snap(1, 1, 99.0), 0);
+    c.push(make_snap(1, 1, 99.1), 0);
+    EXPECT_FALSE(c.ready(0));
+    c.push(make_snap(1, 1, 99.2), 0);
+    EXPECT_TRUE(c.ready(0));
+    EXPECT_EQ(c.drain([](const VenueBookSnapshot&) {}), 1u);
+}